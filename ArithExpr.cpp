@@ -1,15 +1,19 @@
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "ArithExpr.hpp"
 #include "DescriptorFunctions.hpp"
+#include "statements/Statement.hpp"
+#include "builtins/Builtins.hpp"
+#include "Script.hpp"
 
 void checkTypeCompatibility(std::string scope, TypeDescriptor *t1, TypeDescriptor *t2) {
     if ( !Descriptor::validTypeOp(t1, t2) ) {
-            std::cout << scope << "-Fatal Error - Operands / Operators not compatible" << std::endl;
-            std::cout << "Operator Enum { INTEGER = 0, DOUBLE = 1, BOOL = 2, STRING = 3 }" << std::endl;
-            std::cout << "LHS Operator: " << t1->type() << "\t RHS Operator: " << t2->type() << std::endl;
-            exit(1);
+            Script::out() << scope << "-Fatal Error - Operands / Operators not compatible" << std::endl;
+            Script::out() << "Operator Enum { INTEGER = 0, DOUBLE = 1, BOOL = 2, STRING = 3, LIST = 4, DICT = 5 }" << std::endl;
+            Script::out() << "LHS Operator: " << t1->type() << "\t RHS Operator: " << t2->type() << std::endl;
+            Script::exit(1);
         }
 }
 
@@ -18,10 +22,34 @@ ExprNode::ExprNode(std::shared_ptr<Token> token): _token{token} {}
 
 ExprNode::~ExprNode(){
     if (destructor)
-        std::cout << "~ExprNode()" << std::endl;
+        Script::out() << "~ExprNode()" << std::endl;
 }
 
 const std::shared_ptr<Token>& ExprNode::token() { return _token; }
+
+bool ExprNode::condition(SymTab &symTab) {
+    return Descriptor::Bool::getBoolValue(evaluate(symTab).get());
+}
+
+// A name's value is read in place; anything else is evaluated into `held`.
+static TypeDescriptor *operandValue(ExprNode *expr, SymTab &symTab, std::unique_ptr<TypeDescriptor> &held) {
+
+    if ( auto variable = dynamic_cast<Variable *>(expr) )
+        return variable->peek(symTab);
+
+    held = expr->evaluate(symTab);
+    return held.get();
+}
+
+// Comparisons and boolean operators always give a bool.
+static bool givesBool(ExprNode *expr) {
+    return dynamic_cast<ComparisonExprNode *>(expr) != nullptr || dynamic_cast<BooleanExprNode *>(expr) != nullptr;
+}
+
+static bool isNumber(TypeDescriptor *value) {
+    auto type = value->type();
+    return type == TypeDescriptor::BOOL || type == TypeDescriptor::INTEGER || type == TypeDescriptor::DOUBLE;
+}
 //ExprNode END
 
 
@@ -34,14 +62,14 @@ InfixExprNode::InfixExprNode(std::shared_ptr<Token> tk) :
 
 InfixExprNode::~InfixExprNode() {
     if (destructor)
-        std::cout << "InfixExprNode Destructor Called" << std::endl;
+        Script::out() << "InfixExprNode Destructor Called" << std::endl;
 }
 
 void InfixExprNode::dumpAST(std::string space) {
 
-    std::cout << space << std::setw(15) << std::left << "InfixExprNode " << this << "\tToken";
+    Script::out() << space << std::setw(15) << std::left << "InfixExprNode " << this << "\tToken";
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
     _left->dumpAST(space + '\t');
     if ( _right != nullptr )
         _right->dumpAST(space + '\t');
@@ -66,8 +94,8 @@ std::unique_ptr<TypeDescriptor> InfixExprNode::evaluate(SymTab &symTab) {
             return std::move(lValue);
 
         } else {
-            std::cout << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << lValue->type() << std::endl;
-            exit(1);
+            Script::out() << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << lValue->type() << std::endl;
+            Script::exit(1);
         }
     }
     
@@ -75,7 +103,7 @@ std::unique_ptr<TypeDescriptor> InfixExprNode::evaluate(SymTab &symTab) {
     auto rValue = _right->evaluate(symTab);
 
     if (debug)
-        std::cout << "InfixExprNode::evaluate: " << lValue->type() << " " << token()->symbol() << " " << rValue->type() << std::endl;
+        Script::out() << "InfixExprNode::evaluate: " << lValue->type() << " " << token()->symbol() << " " << rValue->type() << std::endl;
      
     checkTypeCompatibility("InfixExprNode::evaluate()", lValue.get(), rValue.get());
 
@@ -98,7 +126,7 @@ void InfixExprNode::print() {
 
 ComparisonExprNode::~ComparisonExprNode() {
     if (destructor)
-        std::cout << "~ComparisonExprNode()" << std::endl;
+        Script::out() << "~ComparisonExprNode()" << std::endl;
 }
 
 void ComparisonExprNode::print() {
@@ -106,29 +134,61 @@ void ComparisonExprNode::print() {
 }
 
 std::unique_ptr<TypeDescriptor> ComparisonExprNode::evaluate(SymTab &symTab) {
+    return Descriptor::Bool::createBooleanDescriptor(condition(symTab));
+}
 
-    auto lValue = _left->evaluate(symTab);
-    auto rValue = _right->evaluate(symTab);
+bool ComparisonExprNode::condition(SymTab &symTab) {
 
-    if (debug)
-        std::cout << "ComparisonExprNode::evaluate:" << std::endl;
+    std::unique_ptr<TypeDescriptor> lHeld, rHeld;
+    auto lValue = operandValue(_left.get(), symTab, lHeld);
+    auto rValue = operandValue(_right.get(), symTab, rHeld);
 
-    checkTypeCompatibility("ComparisonExprNode::evaluate()", lValue.get(), rValue.get());
+    if (debug)
+        Script::out() << "ComparisonExprNode::evaluate:" << std::endl;
 
-    return Descriptor::comparisonDescriptor(lValue.get(), rValue.get(), token());
+    checkTypeCompatibility("ComparisonExprNode::evaluate()", lValue, rValue);
 
+    return Descriptor::comparisonTruth(lValue, rValue, token());
 }
 
 void ComparisonExprNode::dumpAST(std::string space) {
     
-    std::cout << space << std::setw(15) << std::left << "ComparisonExprNode " << this << "\tToken";
+    Script::out() << space << std::setw(15) << std::left << "ComparisonExprNode " << this << "\tToken";
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
     _left->dumpAST(space + '\t');
     _right->dumpAST(space + '\t');
 }
 // ComparisonExprNode END
 
+// MembershipExprNode START
+MembershipExprNode::MembershipExprNode(std::shared_ptr<Token> tk):
+    ExprNode{tk},
+    _left{nullptr},
+    _right{nullptr}
+{}
+
+void MembershipExprNode::print() {}
+
+std::unique_ptr<TypeDescriptor> MembershipExprNode::evaluate(SymTab &symTab) {
+
+    auto item = _left->evaluate(symTab);
+    auto container = _right->evaluate(symTab);
+
+    if (debug)
+        Script::out() << "MembershipExprNode::evaluate:" << std::endl;
+
+    return Descriptor::Bool::createBooleanDescriptor(Descriptor::contains(container.get(), item.get()));
+}
+
+void MembershipExprNode::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "MembershipExprNode " << this << std::endl;
+    _left->dumpAST(space + '\t');
+    _right->dumpAST(space + '\t');
+}
+// MembershipExprNode END
+
 // BooleanExprNode START
 BooleanExprNode::BooleanExprNode(std::shared_ptr<Token> tk): 
     ExprNode{tk}, 
@@ -138,64 +198,86 @@ BooleanExprNode::BooleanExprNode(std::shared_ptr<Token> tk):
 
 BooleanExprNode::~BooleanExprNode() {
     if (destructor)
-        std::cout << "~BooleanExprNode()" << std::endl;
+        Script::out() << "~BooleanExprNode()" << std::endl;
 }
 
 void BooleanExprNode::print() {
-    std::cout << "BooleanExprNode::print" << std::endl;
+    Script::out() << "BooleanExprNode::print" << std::endl;
 }
 
 std::unique_ptr<TypeDescriptor> BooleanExprNode::evaluate(SymTab &symTab) {
+    return Descriptor::Bool::createBooleanDescriptor(condition(symTab));
+}
+
+// and / or stop at the first operand that decides, as Python does. An
+// operand is true when andDescriptor / orDescriptor would take it as true.
+bool BooleanExprNode::condition(SymTab &symTab) {
     // std::cout << "BooleanExprNode::evaluate" << std::endl;
 
     // NOT always take left route -> _right == nullptr
 
     if ( token()->isNot() ) {
 
-        auto result = _left->evaluate(symTab);
-        return Descriptor::negateDescriptor(result.get());
-    
-    } else if ( token()->isAnd() ) {
+        if ( givesBool(_left.get()) )
+            return !_left->condition(symTab);
 
-        if (!_left || !_right) {
-            std::cout << "BooleanExprNode::evaluate() nullptr AND" << std::endl;
-            exit(1);
-        }
-
-        auto lValue = _left->evaluate(symTab);
-        auto rValue = _right->evaluate(symTab);
-
-        checkTypeCompatibility("BooleanExprNode::evaluate()", lValue.get(), rValue.get());
+        std::unique_ptr<TypeDescriptor> held;
+        return Descriptor::negatedTruth(operandValue(_left.get(), symTab, held));
+    }
 
-        return Descriptor::andDescriptor(lValue.get(), rValue.get());
+    if ( !token()->isAnd() && !token()->isOr() ) {
+        Script::out() << "BooleanExprNode::evaluate BAD TOKEN" << std::endl;
+        Script::exit(1);
+    }
 
-    } else if ( token()->isOr() ) {
+    if (!_left || !_right) {
+        Script::out() << "BooleanExprNode::evaluate() nullptr " << (token()->isAnd() ? "AND" : "OR") << std::endl;
+        Script::exit(1);
+    }
 
-        if (!_left || !_right) {
-            std::cout << "BooleanExprNode::evaluate() nullptr OR" << std::endl;
-            exit(1);
+    bool isAnd = token()->isAnd();
+    std::unique_ptr<TypeDescriptor> lHeld, rHeld;
+    TypeDescriptor *lValue = nullptr;
+    bool lTruth;
+
+    if ( givesBool(_left.get()) ) {
+        lTruth = _left->condition(symTab);
+    } else {
+        lValue = operandValue(_left.get(), symTab, lHeld);
+
+        // Not an operand at all - both sides are evaluated to report it.
+        if ( !isNumber(lValue) ) {
+            auto rValue = operandValue(_right.get(), symTab, rHeld);
+            checkTypeCompatibility("BooleanExprNode::evaluate()", lValue, rValue);
+            return Descriptor::Bool::getBoolValue( (isAnd ? Descriptor::andDescriptor(lValue, rValue) : Descriptor::orDescriptor(lValue, rValue)).get() );
         }
+        lTruth = Descriptor::truthBits(dynamic_cast<NumberDescriptor *>(lValue)) > 0;
+    }
 
-        auto lValue = _left->evaluate(symTab);
-        auto rValue = _right->evaluate(symTab);
+    // A false left side decides an and, a true one an or.
+    if ( lTruth != isAnd )
+        return lTruth;
 
-        checkTypeCompatibility("BooleanExprNode::evaluate()", lValue.get(), rValue.get());
+    if ( givesBool(_right.get()) )
+        return _right->condition(symTab);
 
-        return Descriptor::orDescriptor(lValue.get(), rValue.get());
+    auto rValue = operandValue(_right.get(), symTab, rHeld);
+    if ( !isNumber(rValue) ) {
+        if ( lValue == nullptr ) {
+            lHeld = Descriptor::Bool::createBooleanDescriptor(lTruth);
+            lValue = lHeld.get();
+        }
+        checkTypeCompatibility("BooleanExprNode::evaluate()", lValue, rValue);
     }
 
-    std::cout << "BooleanExprNode::evaluate BAD TOKEN" << std::endl;
-    exit(1);
-
-    return nullptr;
-
+    return Descriptor::truthBits(dynamic_cast<NumberDescriptor *>(rValue)) > 0;
 }
 
 void BooleanExprNode::dumpAST(std::string space) {
     
-    std::cout << space << std::setw(15) << std::left << "BooleanExprNode " << this << "\tToken: ";
+    Script::out() << space << std::setw(15) << std::left << "BooleanExprNode " << this << "\tToken: ";
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
 }
 //BooleanExprNode END
 
@@ -206,7 +288,7 @@ WholeNumber::WholeNumber(std::shared_ptr<Token> token):
 
 WholeNumber::~WholeNumber() {
     if (destructor)
-        std::cout << "~WholeNumber" << std::endl;
+        Script::out() << "~WholeNumber" << std::endl;
 }
 
 void WholeNumber::print() {
@@ -216,18 +298,18 @@ void WholeNumber::print() {
 std::unique_ptr<TypeDescriptor> WholeNumber::evaluate(SymTab &symTab) {
 
     if (debug) 
-        std::cout << "WholeNumber::evaluate: returning " << token()->getWholeNumber() << std::endl;
+        Script::out() << "WholeNumber::evaluate: returning " << token()->getWholeNumber() << std::endl;
      
     return Descriptor::Int::createIntDescriptor( token()->getWholeNumber() );
 }
 
 void WholeNumber::dumpAST(std::string space) {
 
-    std::cout << space;
-    std::cout << std::setw(15) << std::left << "WholeNumber " << this;
-    std::cout << "\tToken: ";
+    Script::out() << space;
+    Script::out() << std::setw(15) << std::left << "WholeNumber " << this;
+    Script::out() << "\tToken: ";
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
 }
 // WholeNumber END
 
@@ -238,7 +320,7 @@ Double::Double(std::shared_ptr<Token> token):
 
 Double::~Double() {
     if (destructor)
-        std::cout << "~Double" << std::endl;
+        Script::out() << "~Double" << std::endl;
 }
 
 void Double::print() {
@@ -248,15 +330,15 @@ void Double::print() {
 std::unique_ptr<TypeDescriptor> Double::evaluate(SymTab &symTab [[maybe_unused]]) {
     
     if (debug)
-        std::cout << "Double::evaluate: returning " << token()->getFloat() << std::endl;
+        Script::out() << "Double::evaluate: returning " << token()->getFloat() << std::endl;
 
-    return Descriptor::Double::createDoubleDescriptor( (double) token()->getFloat() );
+    return Descriptor::Double::createDoubleDescriptor( token()->getFloat() );
 }
 
 void Double::dumpAST(std::string space) {
-    std::cout << space << std::setw(15) << std::left << "Double " << this << "\tToken: ";
+    Script::out() << space << std::setw(15) << std::left << "Double " << this << "\tToken: ";
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
 }
 // Double END
 
@@ -267,7 +349,7 @@ Variable::Variable(std::shared_ptr<Token> token):
 
 Variable::~Variable() {
     if (destructor) {
-        std::cout << "~Variable()" << std::endl;
+        Script::out() << "~Variable()" << std::endl;
     }
 }
 
@@ -276,47 +358,55 @@ void Variable::print() {
 }
 
 std::unique_ptr<TypeDescriptor> Variable::evaluate(SymTab &symTab) {
+    return Descriptor::copyReferencePtr(peek(symTab));
+}
+
+TypeDescriptor *Variable::peek(SymTab &symTab) {
     if ( !symTab.isDefined(token()->getName()) ) {
-        std::cout << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
-        std::cout << "Use of undefined variable, " << token()->getName() << std::endl;
-        exit(1);
+        Script::out() << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
+        Script::out() << "Use of undefined variable, " << token()->getName() << std::endl;
+        Script::exit(1);
     }
 
-    return Descriptor::copyReferencePtr(symTab.getValueFor( token()->getName() ));
+    return symTab.getValueFor( token()->getName() );
 }
 
 void Variable::dumpAST(std::string space) {
     
-    std::cout << space << std::setw(15) << std::left << "Variable " << this << "\tToken: " ;
+    Script::out() << space << std::setw(15) << std::left << "Variable " << this << "\tToken: " ;
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
 }
 
 // Variable END
 
 // StringExp START
 StringExp::StringExp(std::shared_ptr<Token> token): 
-    ExprNode{token} 
+    ExprNode{token},
+    _hash{Descriptor::String::hashString(token->getString())}
 {}
 
 StringExp::~StringExp() {
     if (destructor)
-        std::cout << "~StringExp()" << std::endl;
+        Script::out() << "~StringExp()" << std::endl;
 }
 
 void StringExp::print() {
-    std::cout << "PRINT" << std::endl;
+    Script::out() << "PRINT" << std::endl;
 }
 
 std::unique_ptr<TypeDescriptor> StringExp::evaluate(SymTab &symTab) {
-    return Descriptor::String::createStringDescriptor(token()->getString());
+    auto desc = std::make_unique<StringDescriptor>(TypeDescriptor::STRING);
+    desc->_stringValue = token()->getString();
+    desc->_hash = _hash;
+    return desc;
 }
 
 void StringExp::dumpAST(std::string space) {
     
-    std::cout << space << std::setw(15) << std::left << "StringExp " << this << "\tToken: " ;
+    Script::out() << space << std::setw(15) << std::left << "StringExp " << this << "\tToken: " ;
     token()->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
 }
 // StringExp END
 
@@ -325,46 +415,59 @@ void StringExp::dumpAST(std::string space) {
 
 FunctionCall::FunctionCall(std::shared_ptr<Token> functionName, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testList):
     ExprNode{functionName},
+   _functionName{functionName->getName()},
    _testList{std::move(testList)}
     {}
 
 std::unique_ptr<TypeDescriptor> FunctionCall::evaluate(SymTab &symTab) {
 
-    //Use _functionNAme to get shared pointer reference to class FunctionDefinition
-    // size check
-    //Set parameters in symtab /w scope
-    //evaluate function statemets from sp
-    // remove functionArgument names from scope
-
-
-    // INCOMPLETE
-        // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-    // INCOMPLETE
-
     auto functionPointer = symTab.getFunction(_functionName);
 
-    if ( functionPointer->_SUITE_NOT_FUNC_SUITE_FIX->length() != _testList->size()  ) {
-        std::cout << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
+    if ( functionPointer == nullptr ) {
+        // A def shadows the builtin of the same name.
+        if ( auto builtin = Builtins::lookup(_functionName) ) {
+            Builtins::Arguments args;
+            for (auto &&arg : *_testList)
+                args.push_back(arg->evaluate(symTab));
+            return builtin(args);
+        }
+
+        Script::out() << "FunctionCall::evaluate - Fatal Error - Call to undefined function " << _functionName << std::endl;
+        Script::exit(1);
+    }
+
+    if ( functionPointer->_paramList.size() != _testList->size()  ) {
+        Script::out() << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
+        Script::exit(1);
     }
 
-    sumTab.openScope();
+    // Arguments are evaluated in the caller's scope before the callee's scope is opened.
+    std::vector<std::shared_ptr<TypeDescriptor>> args;
+    for (auto &&arg : *_testList)
+        args.push_back(arg->evaluate(symTab));
+
+    symTab.openScope();
+
+    for (size_t i = 0; i < args.size(); i++)
+        symTab.setValueFor(functionPointer->_paramList[i], args[i]);
 
+    symTab.setReturnValue(nullptr);
+    functionPointer->suite()->evaluate(symTab);
+    auto returnValue = symTab.getReturnValue();
+    symTab.setReturnValue(nullptr);
+    symTab.setReturning(false);
 
     symTab.closeScope();
-    return Descriptor::Int::createIntDescriptor(1);
+
+    if ( returnValue == nullptr )
+        return Descriptor::Int::createIntDescriptor(0);
+
+    return Descriptor::copyReferencePtr(returnValue.get());
 }
 
 void FunctionCall::dumpAST(std::string indent) {
 
-    std::cout << indent << "FunctionCall: " << _functionName << " " << this << "\n";
+    Script::out() << indent << "FunctionCall: " << _functionName << " " << this << "\n";
 
     for_each(_testList->begin(), _testList->end(), [&] (auto &args) {
         args->dumpAST(indent + "\t");
@@ -374,4 +477,206 @@ void FunctionCall::dumpAST(std::string indent) {
 void FunctionCall::print() {}
 
 
-// End FunctionCall
\ No newline at end of file
+// End FunctionCall
+
+// ListExp START
+ListExp::ListExp(std::shared_ptr<Token> bracket, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> elements):
+    ExprNode{bracket},
+    _elements{std::move(elements)}
+{}
+
+std::unique_ptr<TypeDescriptor> ListExp::evaluate(SymTab &symTab) {
+
+    auto list = Descriptor::List::createListDescriptor();
+    for (auto &&element : *_elements)
+        Descriptor::List::append(list.get(), element->evaluate(symTab));
+
+    return list;
+}
+
+void ListExp::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "ListExp " << this << std::endl;
+
+    for_each(_elements->begin(), _elements->end(), [&] (auto &element) {
+        element->dumpAST(space + "\t");
+    });
+}
+
+void ListExp::print() {}
+// ListExp END
+
+// DictExp START
+DictExp::DictExp(std::shared_ptr<Token> brace, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> keys, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> values):
+    ExprNode{brace},
+    _keys{std::move(keys)},
+    _values{std::move(values)}
+{}
+
+std::unique_ptr<TypeDescriptor> DictExp::evaluate(SymTab &symTab) {
+
+    auto dict = Descriptor::Dict::createDictDescriptor();
+    for (size_t i = 0; i < _keys->size(); i++) {
+        std::shared_ptr<TypeDescriptor> key = (*_keys)[i]->evaluate(symTab);
+        Descriptor::Dict::set(dict.get(), key, (*_values)[i]->evaluate(symTab));
+    }
+
+    return dict;
+}
+
+void DictExp::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "DictExp " << this << std::endl;
+
+    for (size_t i = 0; i < _keys->size(); i++) {
+        (*_keys)[i]->dumpAST(space + "\t");
+        (*_values)[i]->dumpAST(space + "\t\t");
+    }
+}
+
+void DictExp::print() {}
+// DictExp END
+
+// Subscript START
+Subscript::Subscript(std::shared_ptr<Token> bracket, std::unique_ptr<ExprNode> sequence, std::unique_ptr<ExprNode> index):
+    ExprNode{bracket},
+    _sequence{std::move(sequence)},
+    _index{std::move(index)}
+{}
+
+std::unique_ptr<TypeDescriptor> Subscript::evaluate(SymTab &symTab) {
+
+    auto sequence = _sequence->evaluate(symTab);
+    auto index = _index->evaluate(symTab);
+
+    if ( sequence->type() == TypeDescriptor::DICT )
+        return Descriptor::Dict::get(sequence.get(), index.get());
+
+    if ( sequence->type() == TypeDescriptor::STRING ) {
+        std::string str = Descriptor::String::getStringValue(sequence.get());
+        size_t i = Descriptor::List::normalizeIndex(index.get(), str.size());
+        return Descriptor::String::createStringDescriptor(str.substr(i, 1));
+    }
+
+    size_t i = Descriptor::List::normalizeIndex(index.get(), Descriptor::List::length(sequence.get()));
+    return Descriptor::List::getItem(sequence.get(), i);
+}
+
+void Subscript::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "Subscript " << this << std::endl;
+    _sequence->dumpAST(space + '\t');
+    _index->dumpAST(space + '\t');
+}
+
+void Subscript::print() {}
+// Subscript END
+
+// LenExp START
+LenExp::LenExp(std::shared_ptr<Token> len, std::unique_ptr<ExprNode> sequence):
+    ExprNode{len},
+    _sequence{std::move(sequence)}
+{}
+
+std::unique_ptr<TypeDescriptor> LenExp::evaluate(SymTab &symTab) {
+
+    auto sequence = _sequence->evaluate(symTab);
+
+    if ( sequence->type() == TypeDescriptor::STRING )
+        return Descriptor::Int::createIntDescriptor( (int64_t) Descriptor::String::getStringValue(sequence.get()).size() );
+    if ( sequence->type() == TypeDescriptor::DICT )
+        return Descriptor::Int::createIntDescriptor( (int64_t) Descriptor::Dict::length(sequence.get()) );
+
+    return Descriptor::Int::createIntDescriptor( (int64_t) Descriptor::List::length(sequence.get()) );
+}
+
+void LenExp::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "LenExp " << this << std::endl;
+    _sequence->dumpAST(space + '\t');
+}
+
+void LenExp::print() {}
+// LenExp END
+
+// HoistedExpr START
+HoistedExpr::HoistedExpr(std::string name, std::unique_ptr<ExprNode> expr, std::vector<std::string> reads):
+    ExprNode{expr->token()},
+    _name{std::move(name)},
+    _expr{std::move(expr)},
+    _reads{std::move(reads)}
+{}
+
+static bool isScalar(TypeDescriptor *value) {
+    return value->type() != TypeDescriptor::LIST && value->type() != TypeDescriptor::DICT;
+}
+
+std::unique_ptr<TypeDescriptor> HoistedExpr::evaluate(SymTab &symTab) {
+
+    if ( symTab.isDefined(_name) )
+        return Descriptor::copyReferencePtr(symTab.getValueFor(_name));
+
+    auto value = _expr->evaluate(symTab);
+
+    bool keep = isScalar(value.get());
+    for (auto &name : _reads)
+        keep = keep && symTab.isDefined(name) && isScalar(symTab.getValueFor(name));
+
+    if ( keep )
+        symTab.setValueFor(_name, Descriptor::copyReferencePtr(value.get()));
+
+    return value;
+}
+
+void HoistedExpr::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "HoistedExpr " << this << '\t' << _name << std::endl;
+    _expr->dumpAST(space + '\t');
+}
+
+void HoistedExpr::print() {
+    _expr->print();
+}
+// HoistedExpr END
+
+// CommonExpr START
+CommonExpr::CommonExpr(std::string name, std::unique_ptr<ExprNode> expr, std::vector<std::string> reads, bool defines):
+    ExprNode{expr->token()},
+    _name{std::move(name)},
+    _expr{std::move(expr)},
+    _reads{std::move(reads)},
+    _defines{defines}
+{}
+
+std::unique_ptr<TypeDescriptor> CommonExpr::evaluate(SymTab &symTab) {
+
+    if ( !_defines && symTab.isDefined(_name) )
+        return Descriptor::copyReferencePtr(symTab.getValueFor(_name));
+
+    auto value = _expr->evaluate(symTab);
+    if ( !_defines )
+        return value;
+
+    bool keep = isScalar(value.get());
+    for (auto &name : _reads)
+        keep = keep && symTab.isDefined(name) && isScalar(symTab.getValueFor(name));
+
+    // Replaced every time, so a later occurrence never sees an earlier run's value.
+    if ( keep )
+        symTab.setValueFor(_name, Descriptor::copyReferencePtr(value.get()));
+    else
+        symTab.erase(_name);
+
+    return value;
+}
+
+void CommonExpr::dumpAST(std::string space) {
+
+    Script::out() << space << std::setw(15) << std::left << "CommonExpr " << this << '\t' << _name << (_defines ? " defined" : "") << std::endl;
+    _expr->dumpAST(space + '\t');
+}
+
+void CommonExpr::print() {
+    _expr->print();
+}
+// CommonExpr END
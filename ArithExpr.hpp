@@ -24,6 +24,10 @@ public:
     // virtual TypeDescriptor evaluate(SymTab &) = 0;
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &) = 0;
 
+    // The value as a branch condition, which must be a bool. Comparisons and
+    // and / or / not answer without building a descriptor for it.
+    virtual bool condition(SymTab &);
+
 private:
     std::shared_ptr<Token> _token;
 };
@@ -56,6 +60,23 @@ public:
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual bool condition(SymTab &);
+
+public:
+    std::unique_ptr<ExprNode> _left;
+    std::unique_ptr<ExprNode> _right;
+};
+
+// item in container - token is the `in` keyword.
+class MembershipExprNode: public ExprNode {
+
+public:
+    MembershipExprNode(std::shared_ptr<Token> tk);
+    ~MembershipExprNode() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
 
 public:
     std::unique_ptr<ExprNode> _left;
@@ -72,6 +93,7 @@ public:
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual bool condition(SymTab &);
 
 public:
     std::unique_ptr<ExprNode> _left;
@@ -109,6 +131,10 @@ public:
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+
+    // The value in the symbol table, not a copy - for an operator to read
+    // before anything can bind the name again.
+    TypeDescriptor *peek(SymTab &);
 };
 
 class StringExp: public ExprNode {
@@ -120,6 +146,9 @@ public:
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    // Hashed once here rather than every time the literal is used as a key.
+    uint64_t _hash;
 };
 
 class FunctionCall: public ExprNode {
@@ -131,10 +160,144 @@ public:
     virtual void print();
     virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
 private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
     std::string _functionName;
     std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
 };
 
+// A list display, [ a, b, ... ] - token is the '['.
+class ListExp: public ExprNode {
+public:
+    ListExp(std::shared_ptr<Token>, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
+    ~ListExp() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _elements;
+};
+
+// A dict display, { k: v, ... } - token is the '{'.
+class DictExp: public ExprNode {
+public:
+    DictExp(std::shared_ptr<Token>, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
+    ~DictExp() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _keys;
+    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _values;
+};
+
+// container[index] on a list, a string or a dict - token is the '['.
+class Subscript: public ExprNode {
+public:
+    Subscript(std::shared_ptr<Token>, std::unique_ptr<ExprNode>, std::unique_ptr<ExprNode>);
+    ~Subscript() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::unique_ptr<ExprNode> _sequence;
+    std::unique_ptr<ExprNode> _index;
+};
+
+// len(sequence) on a list, a string or a dict - token is the `len` keyword.
+class LenExp: public ExprNode {
+public:
+    LenExp(std::shared_ptr<Token>, std::unique_ptr<ExprNode>);
+    ~LenExp() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::unique_ptr<ExprNode> _sequence;
+};
+
+// A loop-invariant subtree LoopHoister took out of a RangeStmt's body. It is
+// evaluated the first time a run of the loop reaches it and kept in the
+// symbol table under `name` until the loop starts again - so a loop that
+// never reaches it never evaluates it. A value that is a container, or is
+// computed from one, may change inside the loop and is evaluated every time.
+class HoistedExpr: public ExprNode {
+public:
+    HoistedExpr(std::string name, std::unique_ptr<ExprNode> expr, std::vector<std::string> reads);
+    ~HoistedExpr() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
+    std::string _name;
+    std::unique_ptr<ExprNode> _expr;
+    std::vector<std::string> _reads;
+};
+
+// A subtree ValueNumbering found more than once in a block of statements,
+// with nothing between binding what it reads. The first occurrence
+// `defines` the value, keeping it in the symbol table under `name`; the
+// later ones take it from there. A value that is a container, or is
+// computed from one, is not kept, and the later occurrences evaluate it.
+class CommonExpr: public ExprNode {
+public:
+    CommonExpr(std::string name, std::unique_ptr<ExprNode> expr, std::vector<std::string> reads, bool defines);
+    ~CommonExpr() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+private:
+    friend class ValueNumbering;
+
+    std::string _name;
+    std::unique_ptr<ExprNode> _expr;
+    std::vector<std::string> _reads;
+    bool _defines;
+};
+
 #endif //EXPRINTER_ARITHEXPR_HPP
 
 /*
@@ -4,5 +4,8 @@
 const bool debug = false;
 const bool tokenDebug = false;
 const bool destructor = false;
+// Lists what the --opt passes change. Set by --opt-debug - the passes run
+// once, before the script, so it costs nothing while the script runs.
+inline bool optDebug = false;
  
 #endif 
@@ -4,15 +4,18 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include "Token.hpp"
+#include "Integer.hpp"
 #include "Debug.hpp"
 
 
 class TypeDescriptor {
 
 public:
-    enum types { INTEGER, DOUBLE, BOOL, STRING };
+    enum types { INTEGER, DOUBLE, BOOL, STRING, LIST, DICT };
     TypeDescriptor(types type):
         _type{type}
     {}
@@ -33,16 +36,22 @@ public:
         TypeDescriptor(descType)
     {}
 
+    explicit NumberDescriptor(Integer &&value):
+        TypeDescriptor(INTEGER),
+        _intValue{std::move(value)}
+    {}
+
     ~NumberDescriptor() {
         if (destructor)
             std::cout << "~NumberDescriptor" << std::endl;
     }
 
     union {
-        int intValue;
         double doubleValue;
         int boolValue;
     } _value;
+
+    Integer _intValue;
 };
 
 class StringDescriptor: public TypeDescriptor {
@@ -58,6 +67,74 @@ public:
     }
 
     std::string _stringValue;
+    uint64_t _hash = 0;     // 0 until a dict first hashes the string
+};
+
+// A list keeps its elements in one contiguous buffer. While every element is
+// an int that fits in 64 bits, or every element is a double, they are stored
+// unboxed and iterating is a linear scan; the first element of any other kind
+// moves the whole list to boxed descriptors. The elements are shared, so an
+// assignment copies the reference to the list as Python does.
+
+class ListDescriptor: public TypeDescriptor {
+
+public:
+    enum Storage { EMPTY, INTS, DOUBLES, BOXED };
+
+    struct Elements {
+        Storage storage = EMPTY;
+        std::vector<int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<std::shared_ptr<TypeDescriptor>> boxed;
+
+        size_t size() const {
+            return storage == INTS ? ints.size() : storage == DOUBLES ? doubles.size() : boxed.size();
+        }
+    };
+
+    ListDescriptor(types descType):
+        TypeDescriptor(descType),
+        _elements{std::make_shared<Elements>()}
+    {}
+
+    ~ListDescriptor() {
+        if (destructor)
+            std::cout << "~ListDescriptor" << std::endl;
+    }
+
+    std::shared_ptr<Elements> _elements;
+};
+
+// A dict is a dense array of entries in insertion order plus an open
+// addressing index of int32 slots pointing into it, as CPython lays its dicts
+// out. Lookups probe the small index and compare cached hashes before keys;
+// iterating walks the entry array. Like lists, the table is shared.
+
+class DictDescriptor: public TypeDescriptor {
+
+public:
+    struct Entry {
+        uint64_t hash;
+        std::shared_ptr<TypeDescriptor> key;
+        std::shared_ptr<TypeDescriptor> value;
+    };
+
+    struct Table {
+        std::vector<Entry> entries;
+        std::vector<int32_t> index;     // -1 marks a free slot; the size is a power of two
+    };
+
+    DictDescriptor(types descType):
+        TypeDescriptor(descType),
+        _table{std::make_shared<Table>()}
+    {}
+
+    ~DictDescriptor() {
+        if (destructor)
+            std::cout << "~DictDescriptor" << std::endl;
+    }
+
+    std::shared_ptr<Table> _table;
 };
 
 
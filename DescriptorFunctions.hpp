@@ -1,4 +1,13 @@
+#ifndef __DESCRIPTOR_FUNCTIONS_HPP
+#define __DESCRIPTOR_FUNCTIONS_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
 #include "Descriptor.hpp"
+#include "Script.hpp"
 
 // #include <type_traits>
 
@@ -75,9 +84,9 @@ namespace Compare {
             else if ( t->isRelNotEQ() || t->isRelEQML() )
                 return lhsVar != rhsVar;
 
-            std::cout << "Condition Not Met -- Comparison::String::compString - no condition for token ";
+            Script::out() << "Condition Not Met -- Comparison::String::compString - no condition for token ";
             t->print();
-            std::cout << std::endl;
+            Script::out() << std::endl;
 
             return false; 
         }
@@ -95,43 +104,51 @@ namespace Descriptor {
         inline NumberDescriptor *dieIfNotInt(TypeDescriptor *t) {
 
             if ( t->type() != TypeDescriptor::INTEGER ) {
-                std::cout << "Fatal Error Descriptor::Int::dieIfNotInt" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error Descriptor::Int::dieIfNotInt" << std::endl;
+                Script::exit(1);
             }
 
             auto desc = dynamic_cast<NumberDescriptor *>(t);
 
             if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotInt" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotInt" << std::endl;
+                Script::exit(1);
             }
 
             return desc;
         }
 
-        inline std::unique_ptr<TypeDescriptor> createIntDescriptor(int value) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::INTEGER);
-            desc->_value.intValue = value;
-
-            return desc; 
+        inline std::unique_ptr<TypeDescriptor> createIntDescriptor(Integer value) {
+            return std::make_unique<NumberDescriptor>(std::move(value));
         }
 
-        inline void incrementByN(int n, TypeDescriptor *t) {
+        inline void incrementByN(int64_t n, TypeDescriptor *t) {
 
             auto desc = dieIfNotInt(t);
-            desc->_value.intValue += n;
+            desc->_intValue += n;
         }
 
-        inline int getIntValue(TypeDescriptor *t) {
+        inline const Integer &getIntValue(TypeDescriptor *t) {
 
             auto desc = dieIfNotInt(t);
-            return desc->_value.intValue;
+            return desc->_intValue;
+        }
+
+        // Range bounds are machine integers - anything wider is an error.
+        inline int64_t getSmallIntValue(TypeDescriptor *t) {
+
+            auto &value = getIntValue(t);
+            if ( !value.isSmall() ) {
+                Script::out() << "Fatal Error Descriptor::Int::getSmallIntValue - " << value << " is out of range" << std::endl;
+                Script::exit(1);
+            }
+            return value.small();
         }
 
         inline void flipSignBit(TypeDescriptor *t) {
 
             auto desc = dieIfNotInt(t);
-            desc->_value.intValue *= -1;
+            desc->_intValue = -desc->_intValue;
         }
     };
 
@@ -140,15 +157,15 @@ namespace Descriptor {
         inline NumberDescriptor *dieIfNotBool(TypeDescriptor *t) {
 
             if ( t->type() != TypeDescriptor::BOOL ) {
-                std::cout << "Fatal Error Descriptor::Int::dieIfNotBool" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error Descriptor::Int::dieIfNotBool" << std::endl;
+                Script::exit(1);
             }
 
             auto desc = dynamic_cast<NumberDescriptor *>(t);
 
             if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
+                Script::exit(1);
             }
 
             return desc;
@@ -174,15 +191,15 @@ namespace Descriptor {
         inline StringDescriptor *dieIfNotString(TypeDescriptor *t) {
 
             if ( t->type() != TypeDescriptor::STRING ) {
-                std::cout << "Fatal Error Descriptor::Int::dieIfNotString" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error Descriptor::Int::dieIfNotString" << std::endl;
+                Script::exit(1);
             }
 
             auto desc = dynamic_cast<StringDescriptor *>(t);
 
             if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
+                Script::exit(1);
             }
 
             return desc;
@@ -201,6 +218,16 @@ namespace Descriptor {
 
         }
 
+        // FNV-1a, never 0 so that 0 can mean "not hashed yet".
+        inline uint64_t hashString(const std::string &str) {
+            uint64_t h = 14695981039346656037ULL;
+            for (unsigned char c : str) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+            return h == 0 ? 1 : h;
+        }
+
     };
 
     namespace Double {
@@ -208,15 +235,15 @@ namespace Descriptor {
         inline NumberDescriptor *dieIfNotDouble(TypeDescriptor *t) {
 
             if ( t->type() != TypeDescriptor::DOUBLE ) {
-                std::cout << "Fatal Error Descriptor::Double::dieIfNotDouble.." << t->type() << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error Descriptor::Double::dieIfNotDouble.." << t->type() << std::endl;
+                Script::exit(1);
             }
 
             auto desc = dynamic_cast<NumberDescriptor *>(t);
 
             if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotDouble" << std::endl;
-                exit(1);
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotDouble" << std::endl;
+                Script::exit(1);
             }
 
             return desc;
@@ -241,41 +268,417 @@ namespace Descriptor {
         }
     };
 
+    inline std::unique_ptr<TypeDescriptor> copyReferencePtr(TypeDescriptor *ref);
+
+    namespace List {
+
+        inline ListDescriptor *dieIfNotList(TypeDescriptor *t) {
+
+            if ( t->type() != TypeDescriptor::LIST ) {
+                Script::out() << "Fatal Error Descriptor::List::dieIfNotList" << std::endl;
+                Script::exit(1);
+            }
+
+            auto desc = dynamic_cast<ListDescriptor *>(t);
+
+            if ( desc == nullptr ) {
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotList" << std::endl;
+                Script::exit(1);
+            }
+
+            return desc;
+        }
+
+        inline std::unique_ptr<ListDescriptor> createListDescriptor() {
+            return std::make_unique<ListDescriptor>(TypeDescriptor::LIST);
+        }
+
+        inline size_t length(TypeDescriptor *t) {
+            return dieIfNotList(t)->_elements->size();
+        }
+
+        // Python style index - negative counts from the end.
+        inline size_t normalizeIndex(TypeDescriptor *index, size_t length) {
+
+            auto &value = Int::getIntValue(index);
+            int64_t i = value.isSmall() ? value.small() : INT64_MAX;
+            if ( i < 0 && value.isSmall() )
+                i += (int64_t) length;
+
+            if ( i < 0 || i >= (int64_t) length ) {
+                Script::out() << "Fatal Error Descriptor::List::normalizeIndex - index " << value << " out of range" << std::endl;
+                Script::exit(1);
+            }
+            return (size_t) i;
+        }
+
+        // Moves unboxed elements into descriptors - once a list holds mixed kinds.
+        inline void box(ListDescriptor::Elements &elements) {
+
+            if ( elements.storage == ListDescriptor::INTS )
+                for (auto value : elements.ints)
+                    elements.boxed.push_back(Int::createIntDescriptor(value));
+            else if ( elements.storage == ListDescriptor::DOUBLES )
+                for (auto value : elements.doubles)
+                    elements.boxed.push_back(Double::createDoubleDescriptor(value));
+
+            elements.ints.clear();
+            elements.ints.shrink_to_fit();
+            elements.doubles.clear();
+            elements.doubles.shrink_to_fit();
+            elements.storage = ListDescriptor::BOXED;
+        }
+
+        inline bool isUnboxedInt(TypeDescriptor *value) {
+            return value->type() == TypeDescriptor::INTEGER && Int::getIntValue(value).isSmall();
+        }
+
+        inline void append(TypeDescriptor *t, std::shared_ptr<TypeDescriptor> value) {
+
+            auto &elements = *dieIfNotList(t)->_elements;
+            bool intsOk = elements.storage == ListDescriptor::EMPTY || elements.storage == ListDescriptor::INTS;
+            bool doublesOk = elements.storage == ListDescriptor::EMPTY || elements.storage == ListDescriptor::DOUBLES;
+
+            if ( intsOk && isUnboxedInt(value.get()) ) {
+                elements.ints.push_back(Int::getIntValue(value.get()).small());
+                elements.storage = ListDescriptor::INTS;
+            } else if ( doublesOk && value->type() == TypeDescriptor::DOUBLE ) {
+                elements.doubles.push_back(Double::getDoubleValue(value.get()));
+                elements.storage = ListDescriptor::DOUBLES;
+            } else {
+                if ( elements.storage != ListDescriptor::BOXED )
+                    box(elements);
+                elements.boxed.push_back(std::move(value));
+            }
+        }
+
+        inline std::unique_ptr<TypeDescriptor> getItem(TypeDescriptor *t, size_t i) {
+
+            auto &elements = *dieIfNotList(t)->_elements;
+
+            if ( elements.storage == ListDescriptor::INTS )
+                return Int::createIntDescriptor(elements.ints[i]);
+            if ( elements.storage == ListDescriptor::DOUBLES )
+                return Double::createDoubleDescriptor(elements.doubles[i]);
+            return copyReferencePtr(elements.boxed[i].get());
+        }
+
+        inline void setItem(TypeDescriptor *t, size_t i, std::shared_ptr<TypeDescriptor> value) {
+
+            auto &elements = *dieIfNotList(t)->_elements;
+
+            if ( elements.storage == ListDescriptor::INTS && isUnboxedInt(value.get()) ) {
+                elements.ints[i] = Int::getIntValue(value.get()).small();
+                return;
+            }
+            if ( elements.storage == ListDescriptor::DOUBLES && value->type() == TypeDescriptor::DOUBLE ) {
+                elements.doubles[i] = Double::getDoubleValue(value.get());
+                return;
+            }
+
+            if ( elements.storage != ListDescriptor::BOXED )
+                box(elements);
+            elements.boxed[i] = std::move(value);
+        }
+    };
+
+    inline bool equalValues(TypeDescriptor *a, TypeDescriptor *b);
+    inline void printValue(TypeDescriptor *desc, std::ostream &out = Script::out());
+    inline void printRepr(TypeDescriptor *desc, std::ostream &out = Script::out());
+
+    namespace Dict {
+
+        inline DictDescriptor *dieIfNotDict(TypeDescriptor *t) {
+
+            if ( t->type() != TypeDescriptor::DICT ) {
+                Script::out() << "Fatal Error Descriptor::Dict::dieIfNotDict" << std::endl;
+                Script::exit(1);
+            }
+
+            auto desc = dynamic_cast<DictDescriptor *>(t);
+
+            if ( desc == nullptr ) {
+                Script::out() << "Fatal Error .. Dynamic Cast Failed dieIfNotDict" << std::endl;
+                Script::exit(1);
+            }
+
+            return desc;
+        }
+
+        inline std::unique_ptr<DictDescriptor> createDictDescriptor() {
+            return std::make_unique<DictDescriptor>(TypeDescriptor::DICT);
+        }
+
+        inline size_t length(TypeDescriptor *t) {
+            return dieIfNotDict(t)->_table->entries.size();
+        }
+
+        inline uint64_t mix(uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        inline uint64_t hashDouble(double d) {
+            if ( d == std::trunc(d) && d >= -9.2e18 && d <= 9.2e18 )
+                return mix((uint64_t) (int64_t) d);
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof bits);
+            return mix(bits);
+        }
+
+        // Keys that compare equal hash alike - 1, 1.0 and True are one key, as
+        // in Python. A string keeps its hash once computed.
+        inline uint64_t hashOf(TypeDescriptor *key) {
+
+            if ( key->type() == TypeDescriptor::STRING ) {
+                auto desc = String::dieIfNotString(key);
+                if ( desc->_hash == 0 )
+                    desc->_hash = String::hashString(desc->_stringValue);
+                return desc->_hash;
+            }
+            if ( key->type() == TypeDescriptor::INTEGER ) {
+                auto &value = Int::getIntValue(key);
+                return value.isSmall() ? mix((uint64_t) value.small()) : hashDouble(value.toDouble());
+            }
+            if ( key->type() == TypeDescriptor::BOOL )
+                return mix((uint64_t) Bool::getBoolValue(key));
+            if ( key->type() == TypeDescriptor::DOUBLE )
+                return hashDouble(Double::getDoubleValue(key));
+
+            Script::out() << "Fatal Error Descriptor::Dict::hashOf - unhashable type " << key->type() << std::endl;
+            Script::exit(1);
+        }
+
+        // The entry holding key, or -1.
+        inline int64_t find(DictDescriptor::Table &table, TypeDescriptor *key, uint64_t hash) {
+
+            if ( table.index.empty() )
+                return -1;
+
+            size_t mask = table.index.size() - 1;
+            for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+                int32_t at = table.index[slot];
+                if ( at < 0 )
+                    return -1;
+                auto &entry = table.entries[at];
+                if ( entry.hash == hash && equalValues(entry.key.get(), key) )
+                    return at;
+            }
+        }
+
+        inline void indexEntry(DictDescriptor::Table &table, size_t at) {
+            size_t mask = table.index.size() - 1;
+            size_t slot = table.entries[at].hash & mask;
+            while ( table.index[slot] >= 0 )
+                slot = (slot + 1) & mask;
+            table.index[slot] = (int32_t) at;
+        }
+
+        inline void set(TypeDescriptor *t, std::shared_ptr<TypeDescriptor> key, std::shared_ptr<TypeDescriptor> value) {
+
+            auto &table = *dieIfNotDict(t)->_table;
+            uint64_t hash = hashOf(key.get());
+
+            int64_t at = find(table, key.get(), hash);
+            if ( at >= 0 ) {
+                table.entries[at].value = std::move(value);
+                return;
+            }
+
+            table.entries.push_back({ hash, std::move(key), std::move(value) });
+
+            // The index is kept at most two thirds full; the entries never move.
+            if ( table.entries.size() * 3 > table.index.size() * 2 ) {
+                table.index.assign(std::max<size_t>(8, table.index.size() * 2), -1);
+                for (size_t i = 0; i < table.entries.size(); i++)
+                    indexEntry(table, i);
+            } else {
+                indexEntry(table, table.entries.size() - 1);
+            }
+        }
+
+        inline bool contains(TypeDescriptor *t, TypeDescriptor *key) {
+            return find(*dieIfNotDict(t)->_table, key, hashOf(key)) >= 0;
+        }
+
+        inline std::unique_ptr<TypeDescriptor> get(TypeDescriptor *t, TypeDescriptor *key) {
+
+            auto &table = *dieIfNotDict(t)->_table;
+            int64_t at = find(table, key, hashOf(key));
+
+            if ( at < 0 ) {
+                Script::out() << "Fatal Error Descriptor::Dict::get - key ";
+                printRepr(key);
+                Script::out() << " not found" << std::endl;
+                Script::exit(1);
+            }
+            return copyReferencePtr(table.entries[at].value.get());
+        }
+
+        inline std::unique_ptr<TypeDescriptor> keyAt(TypeDescriptor *t, size_t i) {
+            return copyReferencePtr(dieIfNotDict(t)->_table->entries[i].key.get());
+        }
+    };
+
+    // Python's repr() of a float - the shortest digits that read back to the
+    // same double, positional between 1e-4 and 1e16.
+    inline std::string reprDouble(double value) {
+
+        if ( value != value )
+            return "nan";
+        if ( value == value * 2 && value != 0 )
+            return value < 0 ? "-inf" : "inf";
+
+        char buffer[32];
+        char *end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::scientific).ptr;
+        std::string text(buffer, end);
+
+        std::string sign = text[0] == '-' ? "-" : "";
+        if ( !sign.empty() )
+            text.erase(0, 1);
+
+        size_t e = text.find('e');
+        int exponent = atoi(text.c_str() + e + 1);
+        std::string digits = text.substr(0, e);
+        digits.erase(std::remove(digits.begin(), digits.end(), '.'), digits.end());
+
+        if ( exponent < -4 || exponent >= 16 ) {
+            std::string mantissa = digits.substr(0, 1) + ( digits.size() > 1 ? "." + digits.substr(1) : "" );
+            std::string power = std::to_string(exponent < 0 ? -exponent : exponent);
+            return sign + mantissa + "e" + ( exponent < 0 ? "-" : "+" ) + ( power.size() < 2 ? "0" : "" ) + power;
+        }
+        if ( exponent < 0 )
+            return sign + "0." + std::string(-exponent - 1, '0') + digits;
+
+        if ( digits.size() <= (size_t) exponent + 1 )
+            return sign + digits + std::string(exponent + 1 - digits.size(), '0') + ".0";
+        return sign + digits.substr(0, exponent + 1) + "." + digits.substr(exponent + 1);
+    }
+
+    // Python 2's str() of a float - twelve significant digits, with a .0
+    // kept on a whole number. One of twelve digits has no room for the .0,
+    // so it takes the exponent form instead.
+    inline std::string strDouble(double value) {
+
+        char buffer[32];
+        char *end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::general, 12).ptr;
+        std::string text(buffer, end);
+
+        if ( text.find_first_not_of("-0123456789") != std::string::npos )
+            return text;
+        if ( text.size() - (text[0] == '-') < 12 )
+            return text + ".0";
+
+        end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::scientific, 11).ptr;
+        text.assign(buffer, end);
+        size_t e = text.find('e');
+        size_t last = text.find_last_not_of('0', e - 1);
+        if ( text[last] == '.' )
+            last--;
+        return text.substr(0, last + 1) + text.substr(e);
+    }
 
+    // Python's repr() of a str.
+    inline std::string reprString(const std::string &value) {
+
+        char quote = value.find('\'') != std::string::npos && value.find('"') == std::string::npos ? '"' : '\'';
+        std::string text(1, quote);
+
+        for (unsigned char c : value) {
+            if ( c == quote || c == '\\' )
+                text += std::string("\\") + (char) c;
+            else if ( c == '\n' )
+                text += "\\n";
+            else if ( c == '\t' )
+                text += "\\t";
+            else if ( c == '\r' )
+                text += "\\r";
+            else if ( c < 0x20 || c >= 0x7F ) {
+                char hex[5];
+                snprintf(hex, sizeof hex, "\\x%02x", c);
+                text += hex;
+            } else
+                text += (char) c;
+        }
+        return text + quote;
+    }
 
-    inline void printValue(TypeDescriptor *desc) {
+    inline void printValue(TypeDescriptor *desc, std::ostream &out) {
         
         NumberDescriptor *nDesc = dynamic_cast<NumberDescriptor *>(desc);
 
         if ( nDesc != nullptr ) {
             if( nDesc->type() == TypeDescriptor::INTEGER ) 
-                std::cout << nDesc->_value.intValue;
-            else if( nDesc->type() == TypeDescriptor::DOUBLE )
-                std::cout << nDesc->_value.doubleValue;
+                out << nDesc->_intValue;
+            else if( nDesc->type() == TypeDescriptor::DOUBLE ) {
+                out << strDouble(nDesc->_value.doubleValue);
+            }
             else if( nDesc->type() == TypeDescriptor::BOOL ) 
-                std::cout << nDesc->_value.boolValue;
+                out << nDesc->_value.boolValue;
             else
-                std::cout << "Misconfigured union type." << std::endl;
+                out << "Misconfigured union type." << std::endl;
 
             return;
         }
 
+        else if ( desc->type() == TypeDescriptor::LIST ) {
+            auto &elements = *List::dieIfNotList(desc)->_elements;
+
+            out << "[";
+            for (size_t i = 0; i < elements.size(); i++) {
+                if ( i > 0 )
+                    out << ", ";
+                if ( elements.storage == ListDescriptor::INTS )
+                    out << elements.ints[i];
+                else if ( elements.storage == ListDescriptor::DOUBLES )
+                    out << reprDouble(elements.doubles[i]);
+                else
+                    printRepr(elements.boxed[i].get(), out);
+            }
+            out << "]";
+        }
+
+        else if ( desc->type() == TypeDescriptor::DICT ) {
+            auto &table = *Dict::dieIfNotDict(desc)->_table;
+
+            out << "{";
+            for (size_t i = 0; i < table.entries.size(); i++) {
+                if ( i > 0 )
+                    out << ", ";
+                printRepr(table.entries[i].key.get(), out);
+                out << ": ";
+                printRepr(table.entries[i].value.get(), out);
+            }
+            out << "}";
+        }
+
         else {
             StringDescriptor *sDesc = dynamic_cast<StringDescriptor *>(desc);
 
             if ( sDesc != nullptr ) {
-                std::cout << sDesc->_stringValue;
+                out << sDesc->_stringValue;
             }
         }
     }
 
+    // How an element prints inside a list.
+    inline void printRepr(TypeDescriptor *desc, std::ostream &out) {
+
+        if ( desc->type() == TypeDescriptor::DOUBLE )
+            out << reprDouble(Double::getDoubleValue(desc));
+        else if ( desc->type() == TypeDescriptor::STRING )
+            out << reprString(String::getStringValue(desc));
+        else
+            printValue(desc, out);
+    }
+
     inline std::unique_ptr<TypeDescriptor> copyReferencePtr(TypeDescriptor *ref) {
         
         if (ref->type() == TypeDescriptor::INTEGER) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::INTEGER);
-            desc->_value.intValue = dynamic_cast<NumberDescriptor *>(ref)->_value.intValue; //risky
-
-            return desc;
+            return Int::createIntDescriptor(dynamic_cast<NumberDescriptor *>(ref)->_intValue); //risky
 
         } else if (ref->type() == TypeDescriptor::DOUBLE) {
             auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::DOUBLE);
@@ -292,24 +695,135 @@ namespace Descriptor {
         } else if (ref->type() == TypeDescriptor::STRING) {
             auto desc = std::make_unique<StringDescriptor>(TypeDescriptor::STRING);
             desc->_stringValue = dynamic_cast<StringDescriptor *>(ref)->_stringValue;
+            desc->_hash = dynamic_cast<StringDescriptor *>(ref)->_hash;
  
             return desc;
 
+        } else if (ref->type() == TypeDescriptor::LIST) {
+            auto desc = List::createListDescriptor();
+            desc->_elements = List::dieIfNotList(ref)->_elements;
+
+            return desc;
+
+        } else if (ref->type() == TypeDescriptor::DICT) {
+            auto desc = Dict::createDictDescriptor();
+            desc->_table = Dict::dieIfNotDict(ref)->_table;
+
+            return desc;
+
         } else {
-            std::cout << "ERROR" << std::endl;
-            exit(1);
+            Script::out() << "ERROR" << std::endl;
+            Script::exit(1);
             // Silence Warnings
             return nullptr;
         }
     }
 
+    // Python's == for dict keys and the in operator - numbers by value
+    // whatever their type, strings by content, lists and dicts element-wise.
+    inline bool equalValues(TypeDescriptor *a, TypeDescriptor *b) {
+
+        auto aType = a->type(), bType = b->type();
+        bool aNumber = aType == TypeDescriptor::INTEGER || aType == TypeDescriptor::DOUBLE || aType == TypeDescriptor::BOOL;
+        bool bNumber = bType == TypeDescriptor::INTEGER || bType == TypeDescriptor::DOUBLE || bType == TypeDescriptor::BOOL;
+
+        if ( aNumber && bNumber ) {
+            auto asDouble = [](TypeDescriptor *t) {
+                if ( t->type() == TypeDescriptor::DOUBLE )
+                    return Double::getDoubleValue(t);
+                return t->type() == TypeDescriptor::BOOL ? (double) Bool::getBoolValue(t) : Int::getIntValue(t).toDouble();
+            };
+            if ( aType == TypeDescriptor::DOUBLE || bType == TypeDescriptor::DOUBLE )
+                return asDouble(a) == asDouble(b);
+
+            Integer x = aType == TypeDescriptor::BOOL ? Integer((int64_t) Bool::getBoolValue(a)) : Int::getIntValue(a);
+            Integer y = bType == TypeDescriptor::BOOL ? Integer((int64_t) Bool::getBoolValue(b)) : Int::getIntValue(b);
+            return compare(x, y) == 0;
+        }
+
+        if ( aType != bType )
+            return false;
+
+        if ( aType == TypeDescriptor::STRING )
+            return String::getStringValue(a) == String::getStringValue(b);
+
+        if ( aType == TypeDescriptor::LIST ) {
+            size_t n = List::length(a);
+            if ( n != List::length(b) )
+                return false;
+            for (size_t i = 0; i < n; i++)
+                if ( !equalValues(List::getItem(a, i).get(), List::getItem(b, i).get()) )
+                    return false;
+            return true;
+        }
+
+        if ( aType == TypeDescriptor::DICT ) {
+            auto &table = *Dict::dieIfNotDict(a)->_table;
+            if ( table.entries.size() != Dict::length(b) )
+                return false;
+            for (auto &entry : table.entries) {
+                if ( !Dict::contains(b, entry.key.get()) )
+                    return false;
+                if ( !equalValues(entry.value.get(), Dict::get(b, entry.key.get()).get()) )
+                    return false;
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    // item in container
+    inline bool contains(TypeDescriptor *container, TypeDescriptor *item) {
+
+        if ( container->type() == TypeDescriptor::DICT )
+            return Dict::contains(container, item);
+
+        if ( container->type() == TypeDescriptor::LIST ) {
+            for (size_t i = 0; i < List::length(container); i++)
+                if ( equalValues(List::getItem(container, i).get(), item) )
+                    return true;
+            return false;
+        }
+
+        if ( container->type() == TypeDescriptor::STRING ) {
+            if ( item->type() != TypeDescriptor::STRING ) {
+                Script::out() << "Fatal Error Descriptor::contains - 'in <string>' requires string as left operand" << std::endl;
+                Script::exit(1);
+            }
+            return String::getStringValue(container).find(String::getStringValue(item)) != std::string::npos;
+        }
+
+        Script::out() << "Fatal Error Descriptor::contains - type " << container->type() << " is not a container" << std::endl;
+        Script::exit(1);
+    }
+
     
+    // The boolean operators have always read a number's low 32 bits, whatever
+    // its type. Integers now answer with their sign instead, which is the same
+    // for every value that fits in 32 bits.
+    inline int truthBits(NumberDescriptor *ptr) {
+
+        if ( ptr->type() == TypeDescriptor::INTEGER )
+            return ptr->_intValue.sign();
+        if ( ptr->type() == TypeDescriptor::BOOL )
+            return ptr->_value.boolValue;
+
+        int bits;
+        memcpy(&bits, &ptr->_value.doubleValue, sizeof bits);
+        return bits;
+    }
+
     inline bool validTypeOp(TypeDescriptor *t1, TypeDescriptor *t2) {
 
         auto lhsType = t1->type();
         auto rhsType = t2->type();
 
-        if ( lhsType == rhsType )
+        if ( lhsType == TypeDescriptor::LIST || rhsType == TypeDescriptor::LIST )
+            return false;
+        else if ( lhsType == TypeDescriptor::DICT || rhsType == TypeDescriptor::DICT )
+            return false;
+        else if ( lhsType == rhsType )
             return true;
         else if ( lhsType == TypeDescriptor::BOOL && ( rhsType == TypeDescriptor::DOUBLE || rhsType == TypeDescriptor::INTEGER ))
             return true;
@@ -320,19 +834,23 @@ namespace Descriptor {
         else return false;
     }
 
-    inline std::unique_ptr<TypeDescriptor> negateDescriptor(TypeDescriptor *t) {
+    inline bool negatedTruth(TypeDescriptor *t) {
 
         if (t->type() != TypeDescriptor::BOOL) {
 
             if ( t->type() == TypeDescriptor::DOUBLE || t->type() == TypeDescriptor::INTEGER ) {
                 auto ptr = dynamic_cast<NumberDescriptor *>(t);
-                return Bool::createBooleanDescriptor( ptr->_value.intValue == 0 ? true : false );
+                return truthBits(ptr) == 0;
             }
-            return Bool::createBooleanDescriptor(false);
+            return false;
         }
 
         auto casted = dynamic_cast<NumberDescriptor *>(t);
-        return Bool::createBooleanDescriptor( !casted->_value.boolValue );
+        return !casted->_value.boolValue;
+    }
+
+    inline std::unique_ptr<TypeDescriptor> negateDescriptor(TypeDescriptor *t) {
+        return Bool::createBooleanDescriptor(negatedTruth(t));
     }
 
     inline std::unique_ptr<TypeDescriptor> andDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs) {
@@ -344,15 +862,15 @@ namespace Descriptor {
             auto rhsPtr = dynamic_cast<NumberDescriptor *>(rhs);
 
             // Don't care if its int double -- we just want to see bits.
-            int lhsValue = lhsPtr->_value.intValue;
-            int rhsValue = rhsPtr->_value.intValue;
+            int lhsValue = truthBits(lhsPtr);
+            int rhsValue = truthBits(rhsPtr);
 
 
             return (( lhsValue > 0 && rhsValue > 0)/* || ( lhsValue < 0 && rhsValue < 0 ) || ( lhsValue == rhsValue )*/)
                 ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
         } else {
-            std::cout << "andDescriptor bad types - quitting" << std::endl;
-            exit(1);
+            Script::out() << "andDescriptor bad types - quitting" << std::endl;
+            Script::exit(1);
             return nullptr;
         }
     }
@@ -366,13 +884,13 @@ namespace Descriptor {
             auto rhsPtr = dynamic_cast<NumberDescriptor *>(rhs);
 
             // Don't care if its int double -- we just want to see bits.
-            int lhsValue = lhsPtr->_value.intValue;
-            int rhsValue = rhsPtr->_value.intValue;
+            int lhsValue = truthBits(lhsPtr);
+            int rhsValue = truthBits(rhsPtr);
 
             return ( lhsValue > 0 || rhsValue > 0 ) ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
         } else {
-            std::cout << "andDescriptor bad types - quitting" << std::endl;
-            exit(1);
+            Script::out() << "andDescriptor bad types - quitting" << std::endl;
+            Script::exit(1);
             return nullptr;
         }
 
@@ -381,7 +899,7 @@ namespace Descriptor {
     inline void grabValueFromNumberDescriptor(double &fill, NumberDescriptor *ptr) {
 
         if (ptr->type() == TypeDescriptor::INTEGER) {
-            fill = (float) ptr->_value.intValue;
+            fill = ptr->_intValue.toDouble();
         } else if (ptr->type() == TypeDescriptor::DOUBLE) {
             fill = ptr->_value.doubleValue;
         } else if (ptr->type() == TypeDescriptor::BOOL) {
@@ -398,8 +916,8 @@ namespace Descriptor {
             auto rhsPtr = dynamic_cast<StringDescriptor *>(rhs);
 
             if ( lhsPtr == nullptr || rhsPtr == nullptr ) {
-                std::cout << "Descriptor::relOperatorDescriptor - Error casting to string descriptor" << std::endl;
-                exit(1);
+                Script::out() << "Descriptor::relOperatorDescriptor - Error casting to string descriptor" << std::endl;
+                Script::exit(1);
             }
 
             return String::createStringDescriptor(lhsPtr->_stringValue + rhsPtr->_stringValue);
@@ -412,7 +930,7 @@ namespace Descriptor {
         // Only support on integers from now on!
         if ( lhs->type() != TypeDescriptor::INTEGER || rhs->type() != TypeDescriptor::INTEGER ) {
 
-            std::cout << "Unsupported Type Returning Garbage Value 1" << std::endl;
+            Script::out() << "Unsupported Type Returning Garbage Value 1" << std::endl;
 
             return Int::createIntDescriptor(1);
         }
@@ -420,8 +938,8 @@ namespace Descriptor {
         auto lhsPtr = dynamic_cast<NumberDescriptor*>(lhs);
         auto rhsPtr = dynamic_cast<NumberDescriptor*>(rhs);
 
-        int lhsVar = lhsPtr->_value.intValue;
-        int rhsVar = rhsPtr->_value.intValue; 
+        const Integer &lhsVar = lhsPtr->_intValue;
+        const Integer &rhsVar = rhsPtr->_intValue;
 
         if( t->isAdditionOperator() )
             return Int::createIntDescriptor(lhsVar + rhsVar);
@@ -430,36 +948,38 @@ namespace Descriptor {
         else if(t->isMultiplicationOperator())
             return Int::createIntDescriptor(lhsVar * rhsVar);
         else if(t->isDivisionOperator()) {
-            if ( rhsVar == 0 ) {
-                std::cout << "Warning: Division by zero is undefined" << std::endl;
-                exit(1);
+            if ( rhsVar.sign() == 0 ) {
+                Script::out() << "Warning: Division by zero is undefined" << std::endl;
+                Script::exit(1);
             }
-            return Int::createIntDescriptor(lhsVar / rhsVar); // division by zero?
+            return Int::createIntDescriptor(lhsVar / rhsVar);
         }
         else if( t->isModuloOperator() ) {
             if ( lhsPtr->type() != TypeDescriptor::INTEGER || rhs->type() != TypeDescriptor::INTEGER ) {
-                std::cout << "Error: invalid operands to binary expression NOTINT and NOTINT" << std::endl;
-                exit(1);
+                Script::out() << "Error: invalid operands to binary expression NOTINT and NOTINT" << std::endl;
+                Script::exit(1);
+            }
+            if ( rhsVar.sign() == 0 ) {
+                Script::out() << "Warning: Division by zero is undefined" << std::endl;
+                Script::exit(1);
             }
             return Int::createIntDescriptor(lhsVar % rhsVar);
         }
         else {
-            std::cout << "ERRRRRR" << std::endl;
-            exit(1);
+            Script::out() << "ERRRRRR" << std::endl;
+            Script::exit(1);
             return nullptr;
         }
     }
 
-    inline std::unique_ptr<TypeDescriptor> comparisonDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs, const std::shared_ptr<Token> &t) {
+    inline bool comparisonTruth(TypeDescriptor *lhs, TypeDescriptor *rhs, const std::shared_ptr<Token> &t) {
 
         if ( lhs->type() == TypeDescriptor::STRING && rhs->type() == TypeDescriptor::STRING ) {
 
             std::string lhsVar = String::getStringValue(lhs);
             std::string rhsVar = String::getStringValue(rhs);
 
-            return Compare::String::compString(lhsVar, rhsVar, t) 
-                ?  Bool::createBooleanDescriptor(true)
-                :  Bool::createBooleanDescriptor(false);
+            return Compare::String::compString(lhsVar, rhsVar, t);
 
         }
 
@@ -472,6 +992,24 @@ namespace Descriptor {
         auto lhsPtr = dynamic_cast<NumberDescriptor*>(lhs);
         auto rhsPtr = dynamic_cast<NumberDescriptor*>(rhs);
 
+        // Two integers compare exactly; anything else as doubles.
+        if ( lhs->type() == TypeDescriptor::INTEGER && rhs->type() == TypeDescriptor::INTEGER ) {
+            int order = compare(lhsPtr->_intValue, rhsPtr->_intValue);
+
+            if ( t->isRelGT() )
+                return order > 0;
+            else if ( t->isRelLT() )
+                return order < 0;
+            else if ( t->isRelGTE() )
+                return order >= 0;
+            else if ( t->isRelLTE() )
+                return order <= 0;
+            else if ( t->isRelEQ() )
+                return order == 0;
+            else if ( t->isRelNotEQ() || t->isRelEQML() )
+                return order != 0;
+        }
+
         double lhsVar;
         grabValueFromNumberDescriptor(lhsVar, lhsPtr);
 
@@ -479,21 +1017,25 @@ namespace Descriptor {
         grabValueFromNumberDescriptor(rhsVar, rhsPtr);
    
         if ( t->isRelGT() )
-            return lhsVar > rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false); 
+            return lhsVar > rhsVar;
         else if ( t->isRelLT() )
-            return lhsVar < rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
+            return lhsVar < rhsVar;
         else if ( t->isRelGTE() )
-            return lhsVar >= rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
+            return lhsVar >= rhsVar;
         else if ( t->isRelLTE() )
-            return lhsVar <= rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
+            return lhsVar <= rhsVar;
         else if ( t->isRelEQ() )
-            return lhsVar == rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
+            return lhsVar == rhsVar;
         else if ( t->isRelNotEQ() || t->isRelEQML() )
-            return lhsVar != rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
+            return lhsVar != rhsVar;
 
-        return nullptr;
+        return false;
+    }
+
+    inline std::unique_ptr<TypeDescriptor> comparisonDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs, const std::shared_ptr<Token> &t) {
+        return Bool::createBooleanDescriptor(comparisonTruth(lhs, rhs, t));
     }
 };
 
 
-// #endif
\ No newline at end of file
+#endif
@@ -0,0 +1,459 @@
+#ifndef __INTEGER_HPP
+#define __INTEGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Arbitrary precision integer. A value that fits in 64 bits is held inline
+// and an operation on two such values is a single overflow checked machine
+// instruction. Only a result that does not fit is promoted to a heap Big -
+// sign and magnitude in 32-bit limbs, shared and never modified once built -
+// and any result that fits in 64 bits again is demoted back. Multiplication
+// switches from schoolbook to Karatsuba for large operands.
+//
+// Division and remainder truncate toward zero, like the C ints they replace;
+// the divisor must not be zero.
+//
+// This file is self-contained on purpose: aot/Transpiler pastes it into every
+// generated program.
+
+class Integer {
+
+public:
+    // What every integer descriptor runs is always inlined, so a small value
+    // costs no calls even in the unoptimized build.
+    [[gnu::always_inline]] Integer(): _small{0}, _big{nullptr} {}
+    [[gnu::always_inline]] Integer(int64_t value): _small{value}, _big{nullptr} {}
+
+    [[gnu::always_inline]] Integer(const Integer &other): _small{other._small}, _big{other._big} {
+        if ( _big != nullptr )
+            _big->refs++;
+    }
+
+    [[gnu::always_inline]] Integer(Integer &&other) noexcept: _small{other._small}, _big{other._big} {
+        other._big = nullptr;
+    }
+
+    // Two small values assign like the int64_t they hold.
+    [[gnu::always_inline]] Integer &operator=(const Integer &other) {
+        if ( other._big != nullptr )
+            other._big->refs++;
+        release();
+        _small = other._small;
+        _big = other._big;
+        return *this;
+    }
+
+    [[gnu::always_inline]] Integer &operator=(Integer &&other) noexcept {
+        if ( this != &other ) {
+            release();
+            _small = other._small;
+            _big = other._big;
+            other._big = nullptr;
+        }
+        return *this;
+    }
+
+    [[gnu::always_inline]] ~Integer() {
+        release();
+    }
+
+    // Decimal digits with an optional leading '-'.
+    static Integer parse(const std::string &text) {
+        bool negative = !text.empty() && text[0] == '-';
+        Mag mag;
+        for (size_t i = negative ? 1 : 0; i < text.size(); i++)
+            mulAddSmall(mag, 10, text[i] - '0');
+        return make(negative, std::move(mag));
+    }
+
+    [[gnu::always_inline]] bool isSmall() const { return _big == nullptr; }
+    [[gnu::always_inline]] int64_t small() const { return _small; }
+    bool fitsInt32() const { return isSmall() && _small >= INT32_MIN && _small <= INT32_MAX; }
+
+    int sign() const {
+        if ( isSmall() )
+            return (_small > 0) - (_small < 0);
+        return _big->negative ? -1 : 1;
+    }
+
+    double toDouble() const {
+        if ( isSmall() )
+            return (double) _small;
+        double d = 0.;
+        for (size_t i = _big->mag.size(); i-- > 0; )
+            d = d * 4294967296.0 + _big->mag[i];
+        return _big->negative ? -d : d;
+    }
+
+    std::string toString() const {
+        if ( isSmall() )
+            return std::to_string(_small);
+
+        Mag mag = _big->mag;
+        std::string digits;
+        while ( !mag.empty() ) {
+            uint32_t chunk = divSmall(mag, 1000000000u);
+            for (int i = 0; i < 9 && ( chunk != 0 || !mag.empty() ); i++, chunk /= 10)
+                digits += char('0' + chunk % 10);
+        }
+        if ( _big->negative )
+            digits += '-';
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+    // START "SMALL FAST PATHS"
+    Integer operator-() const {
+        int64_t r;
+        if ( isSmall() && !__builtin_sub_overflow((int64_t) 0, _small, &r) )
+            return Integer(r);
+        return make(sign() > 0, magnitude(*this));
+    }
+
+    friend Integer operator+(const Integer &a, const Integer &b) {
+        int64_t r;
+        if ( a.isSmall() && b.isSmall() && !__builtin_add_overflow(a._small, b._small, &r) )
+            return Integer(r);
+        return addSigned(a.sign() < 0, magnitude(a), b.sign() < 0, magnitude(b));
+    }
+
+    friend Integer operator-(const Integer &a, const Integer &b) {
+        int64_t r;
+        if ( a.isSmall() && b.isSmall() && !__builtin_sub_overflow(a._small, b._small, &r) )
+            return Integer(r);
+        return addSigned(a.sign() < 0, magnitude(a), b.sign() > 0, magnitude(b));
+    }
+
+    friend Integer operator*(const Integer &a, const Integer &b) {
+        int64_t r;
+        if ( a.isSmall() && b.isSmall() && !__builtin_mul_overflow(a._small, b._small, &r) )
+            return Integer(r);
+        return make(( a.sign() < 0 ) != ( b.sign() < 0 ), mulMag(magnitude(a), magnitude(b)));
+    }
+
+    friend Integer operator/(const Integer &a, const Integer &b) {
+        if ( a.isSmall() && b.isSmall() && !( a._small == INT64_MIN && b._small == -1 ) )
+            return Integer(a._small / b._small);
+        Mag remainder;
+        return make(( a.sign() < 0 ) != ( b.sign() < 0 ), divMag(magnitude(a), magnitude(b), remainder));
+    }
+
+    friend Integer operator%(const Integer &a, const Integer &b) {
+        if ( a.isSmall() && b.isSmall() )
+            return Integer(b._small == -1 ? 0 : a._small % b._small);
+        Mag remainder;
+        divMag(magnitude(a), magnitude(b), remainder);
+        return make(a.sign() < 0, std::move(remainder));
+    }
+
+    // In place when the sum stays small - a loop increment builds nothing.
+    Integer &operator+=(const Integer &b) {
+        int64_t r;
+        if ( isSmall() && b.isSmall() && !__builtin_add_overflow(_small, b._small, &r) ) {
+            _small = r;
+            return *this;
+        }
+        return *this = *this + b;
+    }
+
+    friend int compare(const Integer &a, const Integer &b) {
+        if ( a.isSmall() && b.isSmall() )
+            return (a._small > b._small) - (a._small < b._small);
+        if ( a.sign() != b.sign() )
+            return a.sign() < b.sign() ? -1 : 1;
+        int c = cmpMag(magnitude(a), magnitude(b));
+        return a.sign() < 0 ? -c : c;
+    }
+    // END "SMALL FAST PATHS"
+
+    friend bool operator==(const Integer &a, const Integer &b) { return compare(a, b) == 0; }
+    friend bool operator!=(const Integer &a, const Integer &b) { return compare(a, b) != 0; }
+    friend bool operator<(const Integer &a, const Integer &b)  { return compare(a, b) < 0; }
+    friend bool operator<=(const Integer &a, const Integer &b) { return compare(a, b) <= 0; }
+    friend bool operator>(const Integer &a, const Integer &b)  { return compare(a, b) > 0; }
+    friend bool operator>=(const Integer &a, const Integer &b) { return compare(a, b) >= 0; }
+
+    friend std::ostream &operator<<(std::ostream &out, const Integer &value) {
+        if ( value.isSmall() )
+            return out << value._small;
+        return out << value.toString();
+    }
+
+private:
+    // Little endian limbs without leading zeros; zero is the empty vector.
+    typedef std::vector<uint32_t> Mag;
+
+    struct Big {
+        std::atomic<int> refs;
+        bool negative;
+        Mag mag;
+    };
+
+    static constexpr size_t karatsubaLimbs = 32;
+
+    [[gnu::always_inline]] void release() {
+        if ( _big != nullptr && --_big->refs == 0 )
+            delete _big;
+    }
+
+    static Mag magnitude(const Integer &value) {
+        if ( !value.isSmall() )
+            return value._big->mag;
+
+        uint64_t u = value._small < 0 ? 0 - (uint64_t) value._small : (uint64_t) value._small;
+        Mag mag;
+        for (; u != 0; u >>= 32)
+            mag.push_back((uint32_t) u);
+        return mag;
+    }
+
+    // The one place a result is built - small whenever it fits.
+    static Integer make(bool negative, Mag mag) {
+        trim(mag);
+
+        if ( mag.size() <= 2 ) {
+            uint64_t u = mag.empty() ? 0 : mag[0] | ( mag.size() == 2 ? (uint64_t) mag[1] << 32 : 0 );
+            if ( !negative && u <= (uint64_t) INT64_MAX )
+                return Integer((int64_t) u);
+            if ( negative && u <= (uint64_t) INT64_MAX + 1 )
+                return Integer((int64_t) (0 - u));
+        }
+
+        Integer result;
+        result._big = new Big{ {1}, negative, std::move(mag) };
+        return result;
+    }
+
+    static void trim(Mag &mag) {
+        while ( !mag.empty() && mag.back() == 0 )
+            mag.pop_back();
+    }
+
+    static int cmpMag(const Mag &a, const Mag &b) {
+        if ( a.size() != b.size() )
+            return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0; )
+            if ( a[i] != b[i] )
+                return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+
+    static Mag addMag(const Mag &a, const Mag &b) {
+        const Mag &longer = a.size() >= b.size() ? a : b;
+        const Mag &shorter = a.size() >= b.size() ? b : a;
+
+        Mag sum(longer.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.size(); i++) {
+            carry += (uint64_t) longer[i] + ( i < shorter.size() ? shorter[i] : 0 );
+            sum[i] = (uint32_t) carry;
+            carry >>= 32;
+        }
+        sum[longer.size()] = (uint32_t) carry;
+        trim(sum);
+        return sum;
+    }
+
+    // a - b for a >= b.
+    static Mag subMag(const Mag &a, const Mag &b) {
+        Mag difference(a.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            int64_t d = (int64_t) a[i] - ( i < b.size() ? b[i] : 0 ) - borrow;
+            borrow = d < 0;
+            difference[i] = (uint32_t) ( d + ( borrow << 32 ) );
+        }
+        trim(difference);
+        return difference;
+    }
+
+    static Integer addSigned(bool aNegative, const Mag &a, bool bNegative, const Mag &b) {
+        if ( aNegative == bNegative )
+            return make(aNegative, addMag(a, b));
+        if ( cmpMag(a, b) >= 0 )
+            return make(aNegative, subMag(a, b));
+        return make(bNegative, subMag(b, a));
+    }
+
+    // acc += x * 2^(32 * shift)
+    static void addShifted(Mag &acc, const Mag &x, size_t shift) {
+        if ( acc.size() < x.size() + shift + 1 )
+            acc.resize(x.size() + shift + 1, 0);
+
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < x.size() || carry != 0; i++) {
+            carry += (uint64_t) acc[i + shift] + ( i < x.size() ? x[i] : 0 );
+            acc[i + shift] = (uint32_t) carry;
+            carry >>= 32;
+            if ( i + shift + 1 == acc.size() && carry != 0 )
+                acc.push_back(0);
+        }
+    }
+
+    static Mag mulSchool(const Mag &a, const Mag &b) {
+        if ( a.empty() || b.empty() )
+            return Mag();
+
+        Mag product(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.size(); j++) {
+                carry += (uint64_t) a[i] * b[j] + product[i + j];
+                product[i + j] = (uint32_t) carry;
+                carry >>= 32;
+            }
+            product[i + b.size()] = (uint32_t) carry;
+        }
+        trim(product);
+        return product;
+    }
+
+    static Mag mulMag(const Mag &a, const Mag &b) {
+        if ( a.size() < karatsubaLimbs || b.size() < karatsubaLimbs )
+            return mulSchool(a, b);
+
+        // Split both at half the longer operand: x = x1 * B^half + x0.
+        size_t half = std::max(a.size(), b.size()) / 2;
+        if ( a.size() <= half || b.size() <= half ) {
+            // Too unbalanced to split both - split only the longer one.
+            const Mag &longer = a.size() > b.size() ? a : b;
+            const Mag &shorter = a.size() > b.size() ? b : a;
+            Mag low(longer.begin(), longer.begin() + half), high(longer.begin() + half, longer.end());
+            trim(low);
+
+            Mag product = mulMag(low, shorter);
+            addShifted(product, mulMag(high, shorter), half);
+            trim(product);
+            return product;
+        }
+
+        Mag a0(a.begin(), a.begin() + half), a1(a.begin() + half, a.end());
+        Mag b0(b.begin(), b.begin() + half), b1(b.begin() + half, b.end());
+        trim(a0);
+        trim(b0);
+
+        Mag z0 = mulMag(a0, b0);
+        Mag z2 = mulMag(a1, b1);
+        Mag z1 = subMag(subMag(mulMag(addMag(a0, a1), addMag(b0, b1)), z0), z2);
+
+        Mag product = z0;
+        addShifted(product, z1, half);
+        addShifted(product, z2, 2 * half);
+        trim(product);
+        return product;
+    }
+
+    static void mulAddSmall(Mag &mag, uint32_t factor, uint32_t addend) {
+        uint64_t carry = addend;
+        for (auto &limb : mag) {
+            carry += (uint64_t) limb * factor;
+            limb = (uint32_t) carry;
+            carry >>= 32;
+        }
+        if ( carry != 0 )
+            mag.push_back((uint32_t) carry);
+    }
+
+    // mag /= divisor, returning the remainder.
+    static uint32_t divSmall(Mag &mag, uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = mag.size(); i-- > 0; ) {
+            remainder = ( remainder << 32 ) | mag[i];
+            mag[i] = (uint32_t) ( remainder / divisor );
+            remainder %= divisor;
+        }
+        trim(mag);
+        return (uint32_t) remainder;
+    }
+
+    // Knuth, TAOCP vol. 2, 4.3.1 algorithm D. Returns a / b, leaving a % b in remainder.
+    static Mag divMag(Mag a, Mag b, Mag &remainder) {
+        if ( cmpMag(a, b) < 0 ) {
+            remainder = a;
+            return Mag();
+        }
+
+        if ( b.size() == 1 ) {
+            uint32_t r = divSmall(a, b[0]);
+            remainder = r == 0 ? Mag() : Mag{ r };
+            return a;
+        }
+
+        // Normalize so the divisor's top limb has its high bit set. The
+        // dividend gains one limb, which may stay zero.
+        int shift = __builtin_clz(b.back());
+        auto normalize = [shift] (const Mag &x) {
+            Mag out(x.size() + 1, 0);
+            for (size_t i = 0; i < x.size(); i++) {
+                out[i] |= x[i] << shift;
+                if ( shift != 0 )
+                    out[i + 1] = x[i] >> (32 - shift);
+            }
+            return out;
+        };
+        Mag u = normalize(a), v = normalize(b);
+        v.pop_back();
+
+        size_t n = v.size(), m = a.size() - n;
+        Mag quotient(m + 1, 0);
+        uint64_t top = v[n - 1], next = v[n - 2];
+
+        for (size_t j = m + 1; j-- > 0; ) {
+            uint64_t numerator = ( (uint64_t) u[j + n] << 32 ) | u[j + n - 1];
+            uint64_t qhat = numerator / top, rhat = numerator % top;
+
+            while ( qhat > 0xFFFFFFFFull || qhat * next > ( ( rhat << 32 ) | u[j + n - 2] ) ) {
+                qhat--;
+                rhat += top;
+                if ( rhat > 0xFFFFFFFFull )
+                    break;
+            }
+
+            // u[j .. j+n] -= qhat * v
+            int64_t borrow = 0, t;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t p = qhat * v[i];
+                t = (int64_t) u[i + j] - borrow - (int64_t) ( p & 0xFFFFFFFFull );
+                u[i + j] = (uint32_t) t;
+                borrow = (int64_t) ( p >> 32 ) - ( t >> 32 );
+            }
+            t = (int64_t) u[j + n] - borrow;
+            u[j + n] = (uint32_t) t;
+
+            // qhat was one too large - add v back.
+            if ( t < 0 ) {
+                qhat--;
+                uint64_t sum = 0;
+                for (size_t i = 0; i < n; i++) {
+                    sum += (uint64_t) u[i + j] + v[i];
+                    u[i + j] = (uint32_t) sum;
+                    sum >>= 32;
+                }
+                u[j + n] += (uint32_t) sum;
+            }
+            quotient[j] = (uint32_t) qhat;
+        }
+
+        // Unnormalize the remainder.
+        u.resize(n);
+        if ( shift != 0 )
+            for (size_t i = 0; i < n; i++)
+                u[i] = ( u[i] >> shift ) | ( i + 1 < n ? u[i + 1] << (32 - shift) : 0 );
+        trim(u);
+        remainder = u;
+
+        trim(quotient);
+        return quotient;
+    }
+
+    int64_t _small;
+    Big *_big;
+};
+
+#endif
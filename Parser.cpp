@@ -2,18 +2,20 @@
 #include <memory>
 
 #include "Parser.hpp"
+#include "Script.hpp"
 
-Parser::Parser(Lexer &lex):
-    lexer{lex}
+Parser::Parser(Lexer &lex, bool lazyFunctions):
+    lexer{lex},
+    _lazyFunctions{lazyFunctions}
 {}
 
 void Parser::die(std::string where, std::string message, std::shared_ptr<Token> token) {
-    std::cout << where << " " << message << std::endl;
+    Script::out() << where << " " << message << std::endl;
     token->print();
-    std::cout << std::endl;
-    std::cout << "\nThe following is a list of tokens that have been identified up to this point.\n";
+    Script::out() << std::endl;
+    Script::out() << "\nThe following is a list of tokens that have been identified up to this point.\n";
     lexer.printProcessedTokens();
-    exit(1);
+    Script::exit(1);
 }
 
 std::unique_ptr<Statements> Parser::file_input() {
@@ -21,21 +23,27 @@ std::unique_ptr<Statements> Parser::file_input() {
     std::string scope = "Parser::file_input()";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
-    auto tok = lexer.getToken();
     std::unique_ptr<Statements> stmts = std::make_unique<Statements>();
 
-    while ( !tok->eof() ) {
-        lexer.ungetToken();
-        stmts->addStatement(stmt());
-
-        tok = lexer.getToken();
-    }
+    while ( auto statement = next_stmt() )
+        stmts->addStatement(std::move(statement));
 
     return stmts;
 }
 
+std::unique_ptr<Statement> Parser::next_stmt() {
+
+    auto tok = lexer.getToken();
+
+    if ( tok->eof() )
+        return nullptr;
+
+    lexer.ungetToken();
+    return stmt();
+}
+
 
 std::unique_ptr<Statement> Parser::stmt() {
     // stmt -> simple_stmt | compound_stmt
@@ -43,7 +51,7 @@ std::unique_ptr<Statement> Parser::stmt() {
     std::string scope = "Parser::stmt()";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
@@ -61,17 +69,17 @@ std::unique_ptr<Statement> Parser::stmt() {
 
 std::unique_ptr<Statement> Parser::simple_stmt() {
     // Parse grammar rule
-    // <simple_stmt> -> { print_stmt | assign_stmt | call_stmt | return_stmt } NEWLINE
-    // We haven't done -> arrayop
+    // <simple_stmt> -> { print_stmt | assign_stmt | call_stmt | return_stmt | array_stmt } NEWLINE
+    // <array_stmt>  -> <id> '.' 'append' '(' test ')' | <id> '[' test ']' '=' test
 
     std::string scope = "Parser::simple_stmt";
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
     if ( tok->eol() )
-        std::cout << "hello there" << std::endl;
+        Script::out() << "hello there" << std::endl;
 
     if ( !(tok->isPrint() || tok->isName() || tok->isReturn()) ) {
         die(scope, "violating rule", tok);
@@ -85,9 +93,10 @@ std::unique_ptr<Statement> Parser::simple_stmt() {
 
     }
     else if ( tok->isReturn() ) {
-        // std::unique_ptr<ReturnStatement> retStmt = return_stmt();
-        // getEOF(scope);
-        // return retStmt;
+        lexer.ungetToken();
+        std::unique_ptr<ReturnStatement> retStmt = return_stmt();
+        getEOL(scope);
+        return retStmt;
     }
     else if ( tok->isName() ) {
 
@@ -101,12 +110,46 @@ std::unique_ptr<Statement> Parser::simple_stmt() {
             return assignStmt;
         }
         else if (tok->isOpenParen()) {
-            // std::unique_ptr<Stmt> callStmt = call(cachedToken);
-            // getEOF(scope);
-            // return callStmt;
+            lexer.ungetToken();
+            auto callStmt = std::make_unique<FunctionCallStatement>(call(cachedToken));
+            getEOL(scope);
+            return callStmt;
+        }
+        else if ( tok->isPeriod() ) {
+            tok = lexer.getToken();
+            if ( tok->getName() != "append" )
+                die(scope, "Expected `append`, instead got", tok);
+
+            tok = lexer.getToken();
+            if ( !tok->isOpenParen() )
+                die(scope, "Expected `OPENPAREN`, instead got", tok);
+
+            auto value = test();
+
+            tok = lexer.getToken();
+            if ( !tok->isCloseParen() )
+                die(scope, "Expected `CLOSEPAREN`, instead got", tok);
+
+            getEOL(scope);
+            return std::make_unique<AppendStatement>(cachedToken->getName(), std::move(value));
+        }
+        else if ( tok->isOpenSquareBracket() ) {
+            auto index = test();
+
+            tok = lexer.getToken();
+            if ( !tok->isCloseSquareBracket() )
+                die(scope, "Expected `]`, instead got", tok);
+
+            tok = lexer.getToken();
+            if ( !tok->isAssignmentOperator() )
+                die(scope, "Expected `ASSIGN_OP`, instead got", tok);
+
+            auto rhs = test();
+            getEOL(scope);
+            return std::make_unique<SubscriptAssignStmt>(cachedToken->getName(), std::move(index), std::move(rhs));
         } else {
             die(scope, "Unidentified -> 1 <-", tok);
-        } // Remember to add else if(tok->isPerioid()) // array operator
+        }
 
     } else {
         die(scope, "Unidentified -> 1 <-", tok);
@@ -129,7 +172,7 @@ std::unique_ptr<PrintStatement> Parser::print_stmt() {
     std::string scope = "Parser::print_stmt()";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
@@ -147,7 +190,7 @@ std::unique_ptr<AssignStmt> Parser::assign_stmt(std::shared_ptr<Token> varName)
     std::string scope = "Parser::assign_stmt";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto assignOp = lexer.getToken();
     if ( !assignOp->isAssignmentOperator() )
@@ -156,7 +199,7 @@ std::unique_ptr<AssignStmt> Parser::assign_stmt(std::shared_ptr<Token> varName)
     std::unique_ptr<ExprNode> rightHandSideExpr = test();
 
     if (debug)
-        std::cout << scope << " return" << std::endl;
+        Script::out() << scope << " return" << std::endl;
 
 
     return std::make_unique<AssignStmt>(varName->getName(), std::move(rightHandSideExpr));
@@ -167,7 +210,7 @@ std::unique_ptr<Statement> Parser::compound_stmt() {
     std::string scope = "Parser::compound_stmt";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
@@ -188,6 +231,80 @@ std::unique_ptr<Statement> Parser::compound_stmt() {
 }
 
 
+std::unique_ptr<Statement> Parser::func_def() {
+    // Parses the grammar rule
+    // <func_def> -> 'def' ID '(' [parameter_list] ')' ':' func_suite
+
+    std::string scope = "Parser::func_def";
+
+    if (debug)
+        Script::out() << scope << std::endl;
+
+    auto tok = lexer.getToken();
+    if ( !tok->isFunc() )
+        die(scope, "Expected `def` keyword, instead got", tok);
+
+    auto funcName = lexer.getToken();
+    if ( !funcName->isName() )
+        die(scope, "Expected `NAME` for function, instead got", funcName);
+
+    tok = lexer.getToken();
+    if ( !tok->isOpenParen() )
+        die(scope, "Expected `OPENPAREN`, instead got", tok);
+
+    std::vector<std::string> params = parameter_list();
+
+    tok = lexer.getToken();
+    if ( !tok->isCloseParen() )
+        die(scope, "Expected `CLOSEPAREN`, instead got", tok);
+
+    tok = lexer.getToken();
+    if ( !tok->isColon() )
+        die(scope, "Expected `:` symbol, instead got", tok);
+
+    if ( _lazyFunctions ) {
+        auto lazySuite = skip_func_suite();
+        return std::make_unique<FunctionDefinition>(funcName->getName(), params, std::move(lazySuite));
+    }
+
+    std::unique_ptr<Statements> stmts = func_suite();
+
+    if (debug)
+        Script::out() << scope << " return" << std::endl;
+
+    return std::make_unique<FunctionDefinition>(funcName->getName(), params, std::move(stmts), false);
+}
+
+std::vector<std::string> Parser::parameter_list() {
+    // Parses the grammar rule
+    // <parameter_list> -> ID { ',' ID }*
+
+    std::string scope = "Parser::parameter_list";
+    std::vector<std::string> params;
+
+    auto tok = lexer.getToken();
+    if ( tok->isCloseParen() ) {
+        lexer.ungetToken();
+        return params;
+    }
+
+    if ( !tok->isName() )
+        die(scope, "Expected `NAME` parameter, instead got", tok);
+    params.push_back(tok->getName());
+
+    tok = lexer.getToken();
+    while ( tok->isComma() ) {
+        tok = lexer.getToken();
+        if ( !tok->isName() )
+            die(scope, "Expected `NAME` parameter, instead got", tok);
+        params.push_back(tok->getName());
+        tok = lexer.getToken();
+    }
+
+    lexer.ungetToken();
+    return params;
+}
+
 std::unique_ptr<IfStatement> Parser::if_stmt() {
 
     // Parses the grammar rule
@@ -197,7 +314,7 @@ std::unique_ptr<IfStatement> Parser::if_stmt() {
     std::string scope = "Parser::if_stmt";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto ifStatement = std::make_unique<IfStatement>();
     auto tok = lexer.getToken();
@@ -273,7 +390,7 @@ std::unique_ptr<IfStatement> Parser::if_stmt() {
 
 
     if (debug)
-        std::cout << scope << " return" << std::endl;
+        Script::out() << scope << " return" << std::endl;
 
     return ifStatement;
 }
@@ -283,7 +400,7 @@ std::unique_ptr<RangeStmt> Parser::for_stmt() {
     std::string scope = "Parser::for_stmt";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
@@ -306,8 +423,23 @@ std::unique_ptr<RangeStmt> Parser::for_stmt() {
 
     tok = lexer.getToken();
 
-    if ( !tok->isRange() )
-        die(scope, "Expected `RANGE`, instead got", tok);
+    // for <id> in prange(...) - range(...) with its iterations spread over threads.
+    bool parallel = tok->isName() && tok->getName() == "prange";
+
+    // for <id> in <test> - iterate a list or a string.
+    if ( !tok->isRange() && !parallel ) {
+        lexer.ungetToken();
+        auto iterable = test();
+
+        tok = lexer.getToken();
+        if ( !tok->isColon() )
+            die(scope, "Expected `:` symbol, instead got", tok);
+
+        std::unique_ptr<RangeStmt> range = std::make_unique<RangeStmt>(varName);
+        range->addIterable(std::move(iterable));
+        range->addStatements(suite());
+        return range;
+    }
 
     tok = lexer.getToken();
 
@@ -333,12 +465,14 @@ std::unique_ptr<RangeStmt> Parser::for_stmt() {
     std::unique_ptr<Statements> stmts = suite();
 
     if (debug)
-        std::cout << scope << " return" << std::endl;
+        Script::out() << scope << " return" << std::endl;
 
     std::unique_ptr<RangeStmt> range = std::make_unique<RangeStmt>(varName);
     // range->parseTestList(list);
     range->addTestList(std::move(list));
     range->addStatements(std::move(stmts));
+    if ( parallel )
+        range->makeParallel();
 
     return range;
     // return std::make_unique<ForStmt>(varName, wholeNumber, std::move(stmts));
@@ -351,7 +485,7 @@ std::unique_ptr<Statements> Parser::suite() {
     std::unique_ptr<Statements> stmts = std::make_unique<Statements>();
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();  // Expect an EOL
     if ( !tok->eol() )
@@ -382,7 +516,7 @@ std::unique_ptr<Statements> Parser::func_suite() {
     // <func_suite> -> NEWLINE INDENT {stmt | return_stmt} + DEDENT
     std::string scope = "Parser::func_suit()";
     if (debug)
-      std::cout << scope << std::endl;
+      Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();  // Parse NEWLINE
     if (!tok->eol())
@@ -396,9 +530,9 @@ std::unique_ptr<Statements> Parser::func_suite() {
     tok = lexer.getToken();
     while (!tok->isDedent()) {
         if(tok->isReturn()) {
-          std::cout << "Getting return\n";
           lexer.ungetToken();
           stmts->addStatement(return_stmt());
+          getEOL(scope);
           tok = lexer.getToken();
           break;
         }
@@ -413,10 +547,45 @@ std::unique_ptr<Statements> Parser::func_suite() {
     return nullptr;
 }
 
+std::vector<std::shared_ptr<Token>> Parser::skip_func_suite() {
+    // Pre-parse of <func_suite>: only balances INDENT/DEDENT and records the
+    // tokens so func_suite() can run over them on the function's first call.
+    std::string scope = "Parser::skip_func_suite()";
+    if (debug)
+      Script::out() << scope << std::endl;
+
+    std::vector<std::shared_ptr<Token>> tokens;
+
+    auto tok = lexer.getToken();  // Parse NEWLINE
+    if (!tok->eol())
+        die(scope, "Expected an EOL token, instead got: ", tok);
+    tokens.push_back(tok);
+
+    tok = lexer.getToken();      // Parse INDENT TOKEN
+    if (!tok->isIndent())
+        die(scope, "Expected an INDENT token, instead got: ", tok );
+    tokens.push_back(tok);
+
+    int depth = 1;
+    while ( depth > 0 ) {
+        tok = lexer.getToken();
+        if ( tok->eof() )
+            die(scope, "Expected a DEDENT token, instead got: ", tok);
+
+        if ( tok->isIndent() )
+            depth++;
+        else if ( tok->isDedent() )
+            depth--;
+        tokens.push_back(tok);
+    }
+
+    return tokens;
+}
+
 std::unique_ptr<ReturnStatement> Parser::return_stmt() {
     std::string scope = "Parser::return_stmt";
     if (debug)
-      std::cout << scope << std::endl;
+      Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
     if (!tok->isReturn())
@@ -443,173 +612,159 @@ std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> Parser::testlist() {
     return p;
 }
 
-std::unique_ptr<ExprNode> Parser::test() {
+// START "EXPRESSIONS"
+// Expressions are parsed by precedence climbing instead of one function per
+// grammar level. The binding powers reproduce the grammar exactly:
+//
+//     test       -> or_test
+//     or_test    -> and_test { 'or' and_test }
+//     and_test   -> not_test { 'and' not_test }
+//     not_test   -> 'not' not_test | comparison
+//     comparison -> arith_expr { ( comp_op | 'in' | 'not' 'in' ) arith_expr }
+//     arith_expr -> term { ( + | - ) term }
+//     term       -> factor { ( * | / | % ) factor }
+//     factor     -> '-' factor | atom [ '(' testlist ')' ] { '[' test ']' }
+//
+// Every binary level is left associative, so the right operand is parsed at
+// one power above the operator's own.
+
+enum BindingPower : uint8_t {
+    BP_NONE = 0, BP_OR, BP_AND, BP_NOT, BP_COMPARISON, BP_ARITH, BP_TERM, BP_FACTOR
+};
+
+struct BindingPowers {
+    uint8_t keyword[KW_COUNT];
+    uint8_t relOp[REL_COUNT];
+    uint8_t symbol[128];
+};
+
+static constexpr BindingPowers buildBindingPowers() {
+    BindingPowers powers{};
+
+    powers.keyword[KW_OR] = BP_OR;
+    powers.keyword[KW_AND] = BP_AND;
+
+    for (int k = REL_EQ; k < REL_COUNT; k++)
+        powers.relOp[k] = BP_COMPARISON;
+    powers.keyword[KW_IN] = BP_COMPARISON;
+
+    powers.symbol['+'] = powers.symbol['-'] = BP_ARITH;
+    powers.symbol['*'] = powers.symbol['/'] = powers.symbol['%'] = BP_TERM;
+
+    return powers;
+}
 
-    std::string scope = "*Parser::test()";
+static constexpr BindingPowers bindingPowers = buildBindingPowers();
 
-    if (debug)
-        std::cout << scope << std::endl;
+static inline int infixPower(const Token &tok) {
+    if ( tok.keywordKind() != KW_NONE )
+        return bindingPowers.keyword[tok.keywordKind()];
+    if ( tok.relOpKind() != REL_NONE )
+        return bindingPowers.relOp[tok.relOpKind()];
+    return bindingPowers.symbol[tok.symbol() & 0x7f];
+}
 
-    return or_test();
+template <typename Node>
+static std::unique_ptr<ExprNode> binaryNode(std::shared_ptr<Token> tok, std::unique_ptr<ExprNode> left, std::unique_ptr<ExprNode> right) {
+    auto p = std::make_unique<Node>(tok);
+    p->_left = std::move(left);
+    p->_right = std::move(right);
+    return p;
 }
 
-std::unique_ptr<ExprNode> Parser::or_test() {
+std::unique_ptr<ExprNode> Parser::test() {
+    return binary_expr(BP_OR);
+}
 
-    std::string scope = "*Parser::or_test()";
+std::unique_ptr<ExprNode> Parser::binary_expr(int minPower) {
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << "Parser::binary_expr(" << minPower << ")" << std::endl;
 
-    std::unique_ptr<ExprNode> left = and_test();
+    std::unique_ptr<ExprNode> left = unary_expr(minPower);
     auto tok = lexer.getToken();
 
-    while ( tok->isOr() ) {
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = and_test();
-        left = std::move(p);
-        tok = lexer.getToken();
-    }
-
-    lexer.ungetToken();
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
-
-    return left;
-}
+    for (int power = infixPower(*tok); ; power = infixPower(*tok)) {
 
-std::unique_ptr<ExprNode> Parser::and_test() {
-    std::string scope = "*Parser::and_test()";
+        // a not in b is not (a in b). Nothing else may follow an operand
+        // with 'not', so one token of lookahead is enough.
+        std::shared_ptr<Token> negation;
+        if ( tok->isNot() && minPower <= BP_COMPARISON ) {
+            negation = tok;
+            tok = lexer.getToken();
+            if ( !tok->isIn() )
+                die("Parser::binary_expr", "Expected `IN` after not, instead got", tok);
+            power = BP_COMPARISON;
+        }
 
-    if (debug)
-        std::cout << scope << std::endl;
+        if ( power < minPower || power == BP_NONE )
+            break;
 
-    std::unique_ptr<ExprNode> left = not_test();
-    auto tok = lexer.getToken();
+        auto right = binary_expr(power + 1);
 
-    while ( tok->isAnd() ) {
+        if ( tok->isIn() ) {
+            left = binaryNode<MembershipExprNode>(tok, std::move(left), std::move(right));
+            if ( negation != nullptr ) {
+                auto p = std::make_unique<BooleanExprNode>(negation);
+                p->_left = std::move(left);
+                left = std::move(p);
+            }
+        }
+        else if ( power <= BP_AND )
+            left = binaryNode<BooleanExprNode>(tok, std::move(left), std::move(right));
+        else if ( power == BP_COMPARISON )
+            left = binaryNode<ComparisonExprNode>(tok, std::move(left), std::move(right));
+        else
+            left = binaryNode<InfixExprNode>(tok, std::move(left), std::move(right));
 
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = not_test();
-        left = std::move(p);
         tok = lexer.getToken();
     }
-    lexer.ungetToken();
-
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
 
+    lexer.ungetToken();
     return left;
 }
 
-std::unique_ptr<ExprNode> Parser::not_test() {
-
-    std::string scope = "*Parser::not_test()";
-
-    if (debug)
-        std::cout << scope << std::endl;
+// Prefix operators: 'not' only where a not_test may start - anywhere else it
+// falls through to atom(), which rejects it as the descent parser did.
+std::unique_ptr<ExprNode> Parser::unary_expr(int minPower) {
 
     auto tok = lexer.getToken();
 
-    if ( tok->isNot() ) {
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = not_test();
+    if ( tok->isNot() && minPower <= BP_NOT ) {
+        auto p = std::make_unique<BooleanExprNode>(tok);
+        p->_left = binary_expr(BP_NOT);
         return p;
-
-    } else {
-        lexer.ungetToken();
-        return comparison();
     }
-}
-
-std::unique_ptr<ExprNode> Parser::comparison() {
-    // This function parses the grammar rule:
 
-    // <comparison> -> <arith_expr> { <comp_op> <arith_expr> }*
-
-    std::string scope = "*Parser::comparison()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    std::unique_ptr<ExprNode> left = arith_expr();
-    auto tok = lexer.getToken();
-
-    while (tok->isCompOp()) {
-        std::unique_ptr<ComparisonExprNode> p = std::make_unique<ComparisonExprNode>(tok);
-
-        p->_left = std::move(left);
-        p->_right = arith_expr();
-        left = std::move(p);
-        tok = lexer.getToken();
+    if ( tok->isSubtractionOperator() ) {
+        auto p = std::make_unique<InfixExprNode>(tok);
+        p->_left = unary_expr(BP_FACTOR);
+        p->_right = nullptr;
+        return p;
     }
 
     lexer.ungetToken();
+    auto left = atom();
 
-    if (debug)
-        std::cout << scope << " return" << std::endl;
-
-    return left;
-}
-
-std::unique_ptr<ExprNode> Parser::arith_expr() {
-    // This function parses the grammar rules:
-
-    // <arith_expr> -> <term> { ( + | - ) <term> }
-    std::string scope = "*Parser::arith_expr()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    std::unique_ptr<ExprNode> left = term();
-    auto tok = lexer.getToken();
-
-    while (tok->isAdditionOperator() || tok->isSubtractionOperator()) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = term();
-        left = std::move(p);
-        tok = lexer.getToken();
+    if ( left->token()->isName() ) {
+        bool isCall = lexer.getToken()->isOpenParen();
+        lexer.ungetToken();
+        if ( isCall )
+            left = call( left->token() );
     }
-    lexer.ungetToken();
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
 
-    return left;
-}
-
-//TODO -> add support for -> // <- op in tokenizer
-std::unique_ptr<ExprNode> Parser::term() {
-    // This function parses the grammar rules:
-
-    // <term> -> <factor> { ( * | / | % | // ) <factor> }*
-    std::string scope = "ExprNode *Parser::term()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    std::unique_ptr<ExprNode> left = factor();
-
-    auto tok = lexer.getToken();
-
-    while ( tok->isMultiplicationOperator() || tok->isDivisionOperator() || tok->isModuloOperator() ) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = factor();
-        left = std::move(p);
-        tok = lexer.getToken();
+    for (tok = lexer.getToken(); tok->isOpenSquareBracket(); tok = lexer.getToken()) {
+        auto index = test();
+        auto close = lexer.getToken();
+        if ( !close->isCloseSquareBracket() )
+            die("Parser::unary_expr", "Expected `]`, instead got", close);
+        left = std::make_unique<Subscript>(tok, std::move(left), std::move(index));
     }
     lexer.ungetToken();
 
-    if (debug)
-        std::cout << scope << " return" << std::endl;
-
     return left;
 }
+// END "EXPRESSIONS"
 
 std::unique_ptr<ExprNode> Parser::call(std::shared_ptr<Token> ID) {
 
@@ -620,66 +775,26 @@ std::unique_ptr<ExprNode> Parser::call(std::shared_ptr<Token> ID) {
         die(scope, "Expected (", tok);
     }
 
-    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> tlist = testlist();
-
     tok = lexer.getToken();
+    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> tlist;
 
-    if ( !tok->isCloseParen() ) {
-        die(scope, "Expected )", tok);
-    }
-
-    return std::make_unique<FunctionCall>(ID, std::move(tlist));
-
-}
-
-std::unique_ptr<ExprNode> Parser::factor() {
-    // This function parses the grammar rules:
-
-    // <factor> -> {'-'} <factor> | <atom>
-    // TODO: is this correct?
-    std::string scope = "*Parser::factor()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    auto tok = lexer.getToken();
-
-    if ( tok->isSubtractionOperator() ) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = factor();
-        p->_right = nullptr;
-
-        return p;
-
+    if ( tok->isCloseParen() ) {
+        tlist = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
     } else {
-
         lexer.ungetToken();
+        tlist = testlist();
 
-        if (debug)
-            std::cout << scope << " return" << std::endl;
-
-        auto left = atom();
-
-        if ( left->token()->isName() ) {
-            if ( lexer.getToken()->isOpenParen() ) {
-                //function
-                lexer.ungetToken();
-                return call( left->token() );
-            } else {
-                lexer.ungetToken();
-            }
+        tok = lexer.getToken();
 
+        if ( !tok->isCloseParen() ) {
+            die(scope, "Expected )", tok);
         }
+    }
 
-        return left;
-
+    return std::make_unique<FunctionCall>(ID, std::move(tlist));
 
-    }
-    die("Parser::factor", "ERROR", tok);
-    return nullptr;
 }
 
-
 std::unique_ptr<ExprNode> Parser::atom() {
     //This function parses the grammar rules:
 
@@ -687,10 +802,13 @@ std::unique_ptr<ExprNode> Parser::atom() {
     // <atom> -> <number>
     // <atom> -> <string>+
     // <atom> -> '(' <test> ')'
+    // <atom> -> '[' [ <testlist> ] ']'
+    // <atom> -> '{' [ <test> ':' <test> { ',' <test> ':' <test> } ] '}'
+    // <atom> -> 'len' '(' <test> ')'
     std::string scope = "Parser::atom";
 
     if (debug)
-        std::cout << scope << std::endl;
+        Script::out() << scope << std::endl;
 
     auto tok = lexer.getToken();
 
@@ -709,6 +827,45 @@ std::unique_ptr<ExprNode> Parser::atom() {
             die("Parser::atom", "Expected close-parenthesis, instead got", token);
         return p;
     }
+    else if ( tok->isOpenSquareBracket() ) {
+        auto elements = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+        if ( !lexer.getToken()->isCloseSquareBracket() ) {
+            lexer.ungetToken();
+            elements = testlist();
+            auto token = lexer.getToken();
+            if ( !token->isCloseSquareBracket() )
+                die("Parser::atom", "Expected `]`, instead got", token);
+        }
+        return std::make_unique<ListExp>(tok, std::move(elements));
+    }
+    else if ( tok->isOpenBracket() ) {
+        auto keys = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+        auto values = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+        auto token = lexer.getToken();
+        while ( !token->isCloseBracket() ) {
+            lexer.ungetToken();
+            keys->push_back(test());
+            token = lexer.getToken();
+            if ( !token->isColon() )
+                die("Parser::atom", "Expected `:` after a dict key, instead got", token);
+            values->push_back(test());
+            token = lexer.getToken();
+            if ( token->isComma() )
+                token = lexer.getToken();
+            else if ( !token->isCloseBracket() )
+                die("Parser::atom", "Expected `}`, instead got", token);
+        }
+        return std::make_unique<DictExp>(tok, std::move(keys), std::move(values));
+    }
+    else if ( tok->isLen() ) {
+        if ( !lexer.getToken()->isOpenParen() )
+            die("Parser::atom", "Expected `OPENPAREN` after len, instead got", tok);
+        auto sequence = test();
+        auto token = lexer.getToken();
+        if ( !token->isCloseParen() )
+            die("Parser::atom", "Expected close-parenthesis, instead got", token);
+        return std::make_unique<LenExp>(tok, std::move(sequence));
+    }
     die(scope, "Unexpected token", tok);
 
     return nullptr;
@@ -12,7 +12,7 @@
 class Parser { 
     public:
 
-        Parser(Lexer &);
+        Parser(Lexer &, bool lazyFunctions = false);
 
         void die(
             std::string, 
@@ -24,6 +24,9 @@ class Parser {
 
         std::unique_ptr<Statements> file_input();
 
+        // One top-level statement at a time - nullptr once the input is exhausted.
+        std::unique_ptr<Statement> next_stmt();
+
         std::unique_ptr<Statement> stmt();
 
         std::unique_ptr<Statement> simple_stmt();
@@ -41,20 +44,17 @@ class Parser {
         std::vector<std::string> parameter_list();
 
         std::unique_ptr<Statements> suite();
+        std::unique_ptr<Statements> func_suite();
+        std::vector<std::shared_ptr<Token>> skip_func_suite();
+
+        std::unique_ptr<ReturnStatement> return_stmt();
 
         std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testlist();
 
 
         std::unique_ptr<ExprNode> test();
-        std::unique_ptr<ExprNode> or_test();
-        std::unique_ptr<ExprNode> and_test();
-        std::unique_ptr<ExprNode> not_test();
-        std::unique_ptr<ExprNode> comparison();
-        std::unique_ptr<ExprNode> arith_expr();
-        
-        std::unique_ptr<ExprNode> term();
-        
-        std::unique_ptr<ExprNode> factor();
+        std::unique_ptr<ExprNode> binary_expr(int minPower);
+        std::unique_ptr<ExprNode> unary_expr(int minPower);
 
         std::unique_ptr<ExprNode> call(std::shared_ptr<Token>);
 
@@ -62,6 +62,7 @@ class Parser {
 
     private:
         Lexer &lexer;
+        bool _lazyFunctions;
         // std::shared_ptr<FunctionMap> _functionMap;
 
 };
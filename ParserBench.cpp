@@ -0,0 +1,325 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+
+#include "Parser.hpp"
+#include "lex/Lexer.hpp"
+
+// Expression parser throughput benchmark - lexes an expression dense file
+// once, then parses every line with the precedence climbing parser and with
+// the nine level recursive descent chain it replaced, replaying the same
+// tokens for both. Reports expressions per second for each and checks that
+// the two build the same trees. Without an input file it generates one.
+//
+//     make parsebench.x && ./parsebench.x [file] [repetitions]
+
+static std::string generateSource() {
+    std::string src;
+    const char *names[] = { "alpha", "beta", "gamma", "delta" };
+    for (int i = 0; i < 20000; i++) {
+        std::string a = names[i % 4], b = names[(i + 1) % 4], n = std::to_string(i);
+        src += a + " + " + n + " * (" + b + " - 3) % 7 >= -" + b + " / 2 and not " + a + " == " + n + "\n";
+        src += "(" + a + " * " + b + " + 1) * (" + a + " - " + b + ") - " + n + " < 100 or " + b + " != 0\n";
+        src += a + " - -" + b + " * 2 + f(" + a + ", " + b + " + 1) - " + n + " % 3 <> " + a + "\n";
+        src += n + "\n";
+    }
+    return src;
+}
+
+// START "DESCENT BASELINE"
+// The expression layer as it was before precedence climbing, scope strings
+// included.
+class DescentParser {
+
+public:
+    DescentParser(Lexer &lex): lexer{lex} {}
+
+    std::unique_ptr<ExprNode> test() {
+        std::string scope = "*Parser::test()";
+        if (debug)
+            std::cout << scope << std::endl;
+        return or_test();
+    }
+
+private:
+    void die(std::string where, std::string message) {
+        std::cout << where << " " << message << std::endl;
+        exit(1);
+    }
+
+    std::unique_ptr<ExprNode> or_test() {
+        std::string scope = "*Parser::or_test()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        std::unique_ptr<ExprNode> left = and_test();
+        auto tok = lexer.getToken();
+        while ( tok->isOr() ) {
+            auto p = std::make_unique<BooleanExprNode>(tok);
+            p->_left = std::move(left);
+            p->_right = and_test();
+            left = std::move(p);
+            tok = lexer.getToken();
+        }
+        lexer.ungetToken();
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> and_test() {
+        std::string scope = "*Parser::and_test()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        std::unique_ptr<ExprNode> left = not_test();
+        auto tok = lexer.getToken();
+        while ( tok->isAnd() ) {
+            auto p = std::make_unique<BooleanExprNode>(tok);
+            p->_left = std::move(left);
+            p->_right = not_test();
+            left = std::move(p);
+            tok = lexer.getToken();
+        }
+        lexer.ungetToken();
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> not_test() {
+        std::string scope = "*Parser::not_test()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        auto tok = lexer.getToken();
+        if ( tok->isNot() ) {
+            auto p = std::make_unique<BooleanExprNode>(tok);
+            p->_left = not_test();
+            return p;
+        }
+        lexer.ungetToken();
+        return comparison();
+    }
+
+    std::unique_ptr<ExprNode> comparison() {
+        std::string scope = "*Parser::comparison()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        std::unique_ptr<ExprNode> left = arith_expr();
+        auto tok = lexer.getToken();
+        while ( tok->isCompOp() ) {
+            auto p = std::make_unique<ComparisonExprNode>(tok);
+            p->_left = std::move(left);
+            p->_right = arith_expr();
+            left = std::move(p);
+            tok = lexer.getToken();
+        }
+        lexer.ungetToken();
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> arith_expr() {
+        std::string scope = "*Parser::arith_expr()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        std::unique_ptr<ExprNode> left = term();
+        auto tok = lexer.getToken();
+        while ( tok->isAdditionOperator() || tok->isSubtractionOperator() ) {
+            auto p = std::make_unique<InfixExprNode>(tok);
+            p->_left = std::move(left);
+            p->_right = term();
+            left = std::move(p);
+            tok = lexer.getToken();
+        }
+        lexer.ungetToken();
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> term() {
+        std::string scope = "ExprNode *Parser::term()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        std::unique_ptr<ExprNode> left = factor();
+        auto tok = lexer.getToken();
+        while ( tok->isMultiplicationOperator() || tok->isDivisionOperator() || tok->isModuloOperator() ) {
+            auto p = std::make_unique<InfixExprNode>(tok);
+            p->_left = std::move(left);
+            p->_right = factor();
+            left = std::move(p);
+            tok = lexer.getToken();
+        }
+        lexer.ungetToken();
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> call(std::shared_ptr<Token> ID) {
+        std::string scope = "Parser::call()";
+        lexer.getToken();
+
+        auto tlist = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+        auto tok = lexer.getToken();
+        if ( !tok->isCloseParen() ) {
+            lexer.ungetToken();
+            do {
+                tlist->push_back(test());
+                tok = lexer.getToken();
+            } while ( tok->isComma() );
+
+            if ( !tok->isCloseParen() )
+                die(scope, "Expected )");
+        }
+        return std::make_unique<FunctionCall>(ID, std::move(tlist));
+    }
+
+    std::unique_ptr<ExprNode> factor() {
+        std::string scope = "*Parser::factor()";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        auto tok = lexer.getToken();
+        if ( tok->isSubtractionOperator() ) {
+            auto p = std::make_unique<InfixExprNode>(tok);
+            p->_left = factor();
+            p->_right = nullptr;
+            return p;
+        }
+
+        lexer.ungetToken();
+        auto left = atom();
+        if ( left->token()->isName() ) {
+            bool isCall = lexer.getToken()->isOpenParen();
+            lexer.ungetToken();
+            if ( isCall )
+                return call(left->token());
+        }
+        return left;
+    }
+
+    std::unique_ptr<ExprNode> atom() {
+        std::string scope = "Parser::atom";
+        if (debug)
+            std::cout << scope << std::endl;
+
+        auto tok = lexer.getToken();
+        if ( tok->isName() )
+            return std::make_unique<Variable>(tok);
+        else if ( tok->isWholeNumber() )
+            return std::make_unique<WholeNumber>(tok);
+        else if ( tok->isString() )
+            return std::make_unique<StringExp>(tok);
+        else if ( tok->isFloat() )
+            return std::make_unique<Double>(tok);
+        else if ( tok->isOpenParen() ) {
+            std::unique_ptr<ExprNode> p = test();
+            if ( !lexer.getToken()->isCloseParen() )
+                die(scope, "Expected close-parenthesis");
+            return p;
+        }
+        die(scope, "Unexpected token");
+        return nullptr;
+    }
+
+    Lexer &lexer;
+};
+// END "DESCENT BASELINE"
+
+// A printable form of the tree that ignores node addresses.
+static std::string shape(ExprNode *node) {
+    if ( node == nullptr )
+        return "_";
+
+    std::stringstream out;
+    auto tok = node->token();
+    out << tok->getName() << tok->getWholeNumber() << tok->symbol()
+        << int(tok->keywordKind()) << int(tok->relOpKind());
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(node) )
+        out << "(I " << shape(infix->_left.get()) << " " << shape(infix->_right.get()) << ")";
+    else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) )
+        out << "(C " << shape(comparison->_left.get()) << " " << shape(comparison->_right.get()) << ")";
+    else if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) )
+        out << "(B " << shape(boolean->_left.get()) << " " << shape(boolean->_right.get()) << ")";
+    else if ( dynamic_cast<FunctionCall *>(node) )
+        out << "(call)";
+
+    return out.str();
+}
+
+// Parses every line as one expression followed by its EOL.
+template <typename ParseExpression>
+static std::vector<std::unique_ptr<ExprNode>> parseLines(const std::vector<std::shared_ptr<Token>> &tokens, ParseExpression parse) {
+    Lexer lex(tokens);
+    std::vector<std::unique_ptr<ExprNode>> trees;
+
+    while ( !lex.getToken()->eof() ) {
+        lex.ungetToken();
+        trees.push_back(parse(lex));
+        if ( !lex.getToken()->eol() ) {
+            std::cout << "line " << trees.size() << " is not a single expression" << std::endl;
+            exit(1);
+        }
+    }
+    return trees;
+}
+
+int main(int argc, char *argv[]) {
+
+    std::string path;
+    bool generated = argc < 2;
+
+    if ( generated ) {
+        path = "/tmp/parsebench." + std::to_string(getpid()) + ".txt";
+        std::ofstream out(path);
+        out << generateSource();
+    } else {
+        path = argv[1];
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 5;
+
+    std::vector<std::shared_ptr<Token>> tokens;
+    {
+        std::ifstream in(path);
+        Lexer lex(in);
+        do {
+            tokens.push_back(lex.getToken());
+        } while ( !tokens.back()->eof() );
+    }
+
+    auto climbing = [] (Lexer &lex) { return Parser(lex).test(); };
+    auto descent = [] (Lexer &lex) { return DescentParser(lex).test(); };
+
+    std::cout << "Parsing " << path << " (" << tokens.size() << " tokens) x " << repetitions << std::endl;
+
+    size_t expressions = parseLines(tokens, climbing).size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        parseLines(tokens, descent);
+    std::chrono::duration<double> descentTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        parseLines(tokens, climbing);
+    std::chrono::duration<double> climbingTime = std::chrono::steady_clock::now() - start;
+
+    auto a = parseLines(tokens, descent), b = parseLines(tokens, climbing);
+    bool same = a.size() == b.size();
+    for (size_t i = 0; same && i < a.size(); i++)
+        same = shape(a[i].get()) == shape(b[i].get());
+
+    double total = (double) expressions * repetitions;
+    std::cout << "descent: " << total / descentTime.count() / 1e6 << " M expressions/s, "
+              << descentTime.count() * 1e9 / (tokens.size() * repetitions) << " ns/token" << std::endl;
+    std::cout << "precedence climbing: " << total / climbingTime.count() / 1e6 << " M expressions/s, "
+              << climbingTime.count() * 1e9 / (tokens.size() * repetitions) << " ns/token" << std::endl;
+    std::cout << (same ? "trees identical" : "TREES DIFFER") << std::endl;
+
+    if ( generated )
+        unlink(path.c_str());
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "Script.hpp"
+
+namespace Script {
+
+static thread_local std::ostream *current = nullptr;
+static thread_local bool inJob = false;
+
+std::ostream &out() {
+    return current != nullptr ? *current : std::cout;
+}
+
+Redirect::Redirect(std::ostream &to):
+    _previous{current}
+{
+    current = &to;
+}
+
+Redirect::~Redirect() {
+    current = _previous;
+}
+
+Job::Job():
+    _previous{inJob}
+{
+    inJob = true;
+}
+
+Job::~Job() {
+    inJob = _previous;
+}
+
+void exit(int status) {
+    out().flush();
+
+    if ( inJob )
+        throw Exit{status};
+
+    std::exit(status);
+}
+
+};
@@ -0,0 +1,51 @@
+#ifndef __SCRIPT_HPP
+#define __SCRIPT_HPP
+
+#include <ostream>
+
+// What the running script writes to and how it ends, per thread - so one
+// process can run several scripts side by side (see --batch in main.cpp).
+// Outside a batch job that is std::cout and the process exit status.
+
+namespace Script {
+
+    // Where print statements and error messages go.
+    std::ostream &out();
+
+    // Points this thread's out() at `to` while it lives.
+    class Redirect {
+    public:
+        Redirect(std::ostream &to);
+        ~Redirect();
+
+        Redirect(const Redirect &) = delete;
+        Redirect &operator=(const Redirect &) = delete;
+
+    private:
+        std::ostream *_previous;
+    };
+
+    // Thrown by exit() inside a batch job, for the job to catch.
+    struct Exit {
+        int status;
+    };
+
+    // Marks this thread as running a batch job while it lives.
+    class Job {
+    public:
+        Job();
+        ~Job();
+
+        Job(const Job &) = delete;
+        Job &operator=(const Job &) = delete;
+
+    private:
+        bool _previous;
+    };
+
+    // Ends the script after a fatal error - the process, or just the batch job.
+    [[noreturn]] void exit(int status);
+
+};
+
+#endif
@@ -1,6 +1,8 @@
 #include <stack>
 #include <iostream>
 #include "SymTab.hpp"
+#include "DescriptorFunctions.hpp"
+#include "Script.hpp"
 
 // https://stackoverflow.com/questions/41871115/why-would-i-stdmove-an-stdshared-ptr
 
@@ -19,12 +21,12 @@ void SymTab::addDescriptor(std::string vName, std::shared_ptr<NumberDescriptor>
         globalSymTab[vName] = std::move(descriptor);
 }
 
-void SymTab::createEntryFor(std::string vName, int value) {
+void SymTab::createEntryFor(std::string vName, Integer value) {
 
     if (debug)
-        std::cout << "SymTab::createEntryFor(INT) ->" << value << "<-" << std::endl;
+        Script::out() << "SymTab::createEntryFor(INT) ->" << value << "<-" << std::endl;
     auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::INTEGER);
-    descriptor->_value.intValue = value;
+    descriptor->_intValue = std::move(value);
     addDescriptor(vName, descriptor);
     //globalSymTab[vName] = std::move(descriptor);
 }
@@ -32,7 +34,7 @@ void SymTab::createEntryFor(std::string vName, int value) {
 void SymTab::createEntryFor(std::string vName, double value) {
 
     if (debug)
-        std::cout << "SymTab::createEntryFor(DOUBLE) ->" << value << "<-" << std::endl;
+        Script::out() << "SymTab::createEntryFor(DOUBLE) ->" << value << "<-" << std::endl;
 
     auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::DOUBLE);
     descriptor->_value.doubleValue = value;
@@ -42,7 +44,7 @@ void SymTab::createEntryFor(std::string vName, double value) {
 void SymTab::createEntryFor(std::string vName, bool value) {
 
     if (debug)
-        std::cout << "SymTab::createEntryFor(BOOL) ->" << value << "<-" << std::endl;
+        Script::out() << "SymTab::createEntryFor(BOOL) ->" << value << "<-" << std::endl;
 
     auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::BOOL);
     descriptor->_value.boolValue = (int) value;
@@ -51,7 +53,7 @@ void SymTab::createEntryFor(std::string vName, bool value) {
 
 void SymTab::createEntryFor(std::string vName, std::string value) {
     if (debug)
-        std::cout << "SymTab::createEntryFor(STRING) ->" << value << "<-" << std::endl;
+        Script::out() << "SymTab::createEntryFor(STRING) ->" << value << "<-" << std::endl;
 
     auto descriptor = std::make_shared<StringDescriptor>(TypeDescriptor::STRING);
     descriptor->_stringValue = value;
@@ -98,17 +100,32 @@ bool SymTab::erase(std::string vName) {
 TypeDescriptor *SymTab::getValueFor(std::string vName) {
 
     if ( !isDefined(vName) ) {
-        std::cout << "SymTab::getValueFor: " << vName << " has not been defined.\n";
-        exit(1);
+        Script::out() << "SymTab::getValueFor: " << vName << " has not been defined.\n";
+        Script::exit(1);
     }
 
     if (debug)
-        std::cout << "SymTab::getValueFor: " << vName << "\n";
+        Script::out() << "SymTab::getValueFor: " << vName << "\n";
 
+    if ( symTab.size() > 0 )
+        return (symTab.top()).find(vName)->second.get();
     return globalSymTab.find(vName)->second.get();
 
 }
 
+SymTab SymTab::snapshot() const {
+
+    SymTab copy;
+    auto &visible = symTab.size() > 0 ? symTab.top() : globalSymTab;
+
+    for (auto &entry : visible)
+        if ( entry.second != nullptr )
+            copy.globalSymTab[entry.first] = Descriptor::copyReferencePtr(entry.second.get());
+
+    copy._functionTable = _functionTable;
+    return copy;
+}
+
 void SymTab::openScope() {
 
     std::map<std::string, std::shared_ptr<TypeDescriptor>> newScope;
@@ -118,8 +135,8 @@ void SymTab::openScope() {
 void SymTab::closeScope() {
 
     if ( symTab.size() == 0 ) {
-        std::cout << "SymTab::closeScope() -> can't close scope - stack size is zero" << std::endl;
-        exit(1);
+        Script::out() << "SymTab::closeScope() -> can't close scope - stack size is zero" << std::endl;
+        Script::exit(1);
     }
     symTab.pop();
 }
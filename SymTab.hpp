@@ -4,6 +4,7 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <memory>
 
 #include "Descriptor.hpp"
 
@@ -19,7 +20,7 @@ class SymTab {
 public:
     bool isDefined(std::string vName);
     bool erase(std::string vName);
-    void createEntryFor(std::string, int);
+    void createEntryFor(std::string, Integer);
     void createEntryFor(std::string, double);
     void createEntryFor(std::string, bool);
     void createEntryFor(std::string, std::string);
@@ -32,9 +33,19 @@ public:
     void openScope();
     void closeScope();
 
+    // A table holding copies of the variables visible here, and the same
+    // functions - where a prange worker starts.
+    SymTab snapshot() const;
+
     std::shared_ptr<TypeDescriptor> getReturnValue() { return _returnValue; }
     void setReturnValue(std::shared_ptr<TypeDescriptor> rv) { _returnValue = rv; }
 
+    // Set by a return inside a function - the statements after it are
+    // skipped until the call ends. Outside a function there is nothing to
+    // return from.
+    bool isReturning() const { return _returning; }
+    void setReturning(bool returning) { _returning = returning && !symTab.empty(); }
+
     void setFunction(std::string fName, std::shared_ptr<FunctionDefinition> fDef) { _functionTable[fName] = fDef; }
     std::shared_ptr<FunctionDefinition> getFunction(std::string fName) { return _functionTable[fName]; }
 
@@ -58,6 +69,7 @@ private:
 	>> symTab;
 
     std::shared_ptr<TypeDescriptor> _returnValue;
+    bool _returning = false;
 };
 
 #endif //EXPRINTER_SYMTAB_HPP
@@ -3,11 +3,14 @@
 
 #include "Token.hpp"
 #include "Debug.hpp"
+#include "Script.hpp"
 
 Token::Token():
   _name{""},
   _relExp{""},
   _keyword{""},
+  _keywordKind{KW_NONE},
+  _relOpKind{REL_NONE},
   _eof{false},
   _eol{false},
   _isFloat{false},
@@ -17,69 +20,97 @@ Token::Token():
   _float{0.}
   {}
 
-Token::Token(std::string tok) {
-  _keyword = tok;
+Token::Token(std::string tok):
+  Token()
+{
+  setKeyword(tok);
 } 
 
+Token::Token(KeywordKind kind):
+  Token()
+{
+  setKeyword(kind);
+}
+
+// The string setters are for tokens built outside the Lexer; they map the
+// spelling back to its kind.
+void Token::setKeyword(std::string keyword) {
+  _keyword = keyword;
+  _keywordKind = KW_NONE;
+  for (int k = KW_NONE + 1; k < KW_COUNT; k++) {
+    if ( keyword == keywordNames[k] )
+      _keywordKind = static_cast<KeywordKind>(k);
+  }
+}
+
+void Token::relExp(std::string exp) {
+  _relExp = exp;
+  _relOpKind = REL_NONE;
+  for (int k = REL_NONE + 1; k < REL_COUNT; k++) {
+    if ( exp == relOpNames[k] )
+      _relOpKind = static_cast<RelOpKind>(k);
+  }
+}
+
 void Token::dumpData() const {
-  std::cout << "_name: " << _name << std::endl;
-  std::cout << "_relExp: " << _relExp << std::endl;
-  std::cout << "_keyword: " << _keyword << std::endl;
-  std::cout << "_eof: " << _eof << std::endl;
-  std::cout << "_eol: " << _eol << std::endl;
-  std::cout << "_isWholeNumber: " << _isWholeNumber << std::endl;
-  std::cout << "_symbol: " << _symbol << std::endl;
-  std::cout << "_wholeNumber: " << _wholeNumber << std::endl;
+  Script::out() << "_name: " << _name << std::endl;
+  Script::out() << "_relExp: " << _relExp << std::endl;
+  Script::out() << "_keyword: " << _keyword << std::endl;
+  Script::out() << "_eof: " << _eof << std::endl;
+  Script::out() << "_eol: " << _eol << std::endl;
+  Script::out() << "_isWholeNumber: " << _isWholeNumber << std::endl;
+  Script::out() << "_symbol: " << _symbol << std::endl;
+  Script::out() << "_wholeNumber: " << _wholeNumber << std::endl;
 }
 
 void Token::print() const {
     if (tokenDebug)
-      std::cout << std::setw(15) << std::left;
-    if( eol() )                             std::cout << "EOL" ;
-    else if ( eof() )                       std::cout << "EOF" ;
-    else if ( isOpenParen() )               std::cout << "(" ;
-    else if ( isCloseParen() )              std::cout << ")" ;
-    else if ( isOpenSquareBracket() )       std::cout << "[";
-    else if ( isCloseSquareBracket() )      std::cout << "]";
-    else if ( isAssignmentOperator() )      std::cout << "=" ;
-    else if ( isSemiColon() )               std::cout << ";" ;
-    else if ( isColon() )                   std::cout << ":" ;
-    else if ( isMultiplicationOperator() )  std::cout << "*" ;
-    else if ( isAdditionOperator() )        std::cout << "+" ;
-    else if ( isSubtractionOperator() )     std::cout << "-" ;
-    else if ( isModuloOperator() )          std::cout << "%" ;
-    else if ( isDivisionOperator() )        std::cout << "/" ;
-    else if ( isName() )                    std::cout << getName();
-    else if ( isWholeNumber() )             std::cout << getWholeNumber();
-    else if ( isFloat() )                   std::cout << getFloat();
-    else if ( isRelOp() )                   std::cout << getRelOp();
-    else if ( isOpenBracket() )             std::cout << "{";
-    else if ( isCloseBracket() )            std::cout << "}";
-    else if ( isComma() )                   std::cout << ",";
+      Script::out() << std::setw(15) << std::left;
+    if( eol() )                             Script::out() << "EOL" ;
+    else if ( eof() )                       Script::out() << "EOF" ;
+    else if ( isOpenParen() )               Script::out() << "(" ;
+    else if ( isCloseParen() )              Script::out() << ")" ;
+    else if ( isOpenSquareBracket() )       Script::out() << "[";
+    else if ( isCloseSquareBracket() )      Script::out() << "]";
+    else if ( isAssignmentOperator() )      Script::out() << "=" ;
+    else if ( isSemiColon() )               Script::out() << ";" ;
+    else if ( isColon() )                   Script::out() << ":" ;
+    else if ( isMultiplicationOperator() )  Script::out() << "*" ;
+    else if ( isAdditionOperator() )        Script::out() << "+" ;
+    else if ( isSubtractionOperator() )     Script::out() << "-" ;
+    else if ( isModuloOperator() )          Script::out() << "%" ;
+    else if ( isDivisionOperator() )        Script::out() << "/" ;
+    else if ( isName() )                    Script::out() << getName();
+    else if ( isWholeNumber() )             Script::out() << getWholeNumber();
+    else if ( isFloat() )                   Script::out() << getFloat();
+    else if ( isRelOp() )                   Script::out() << getRelOp();
+    else if ( isOpenBracket() )             Script::out() << "{";
+    else if ( isCloseBracket() )            Script::out() << "}";
+    else if ( isComma() )                   Script::out() << ",";
     else if ( isKeyword() ) {
-      if ( isPrint() )       std::cout << "print";
-      else if ( isFor() )    std::cout << "for";
-      else if ( isIf() )     std::cout << "if";
-      else if ( isElIf() )   std::cout << "elif";
-      else if ( isElse() )   std::cout << "else";
-      else if ( isIndent() ) std::cout << "INDENT";
-      else if ( isDedent() ) std::cout << "DEDENT";
-      else if ( isAnd() )    std::cout << "and";
-      else if ( isOr() )     std::cout << "or";
-      else if ( isNot() )    std::cout << "not";
-      else if ( isIn() )     std::cout << "in";
-      else if ( isRange() )  std::cout << "range";
-      else if ( isPeriod() ) std::cout << ".";
-      else if ( isFunc() )   std::cout << "def";
-      else if ( isLen() )    std::cout << "len";
+      if ( isPrint() )       Script::out() << "print";
+      else if ( isFor() )    Script::out() << "for";
+      else if ( isIf() )     Script::out() << "if";
+      else if ( isElIf() )   Script::out() << "elif";
+      else if ( isElse() )   Script::out() << "else";
+      else if ( isIndent() ) Script::out() << "INDENT";
+      else if ( isDedent() ) Script::out() << "DEDENT";
+      else if ( isAnd() )    Script::out() << "and";
+      else if ( isOr() )     Script::out() << "or";
+      else if ( isNot() )    Script::out() << "not";
+      else if ( isIn() )     Script::out() << "in";
+      else if ( isRange() )  Script::out() << "range";
+      else if ( isPeriod() ) Script::out() << ".";
+      else if ( isFunc() )   Script::out() << "def";
+      else if ( isLen() )    Script::out() << "len";
       else {
-        std::cout << "Unidentified Keyword ... update Token.cpp / Token.hpp";
+        Script::out() << "Unidentified Keyword ... update Token.cpp / Token.hpp";
       }
     }
     else if ( isString() ) {
-      std::cout << getString();
+      Script::out() << getString();
     } else {
-      std::cout << "Uninitialized token.\n";
+      Script::out() << "Uninitialized token.\n";
       dumpData();
     }
 
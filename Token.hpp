@@ -3,11 +3,15 @@
 
 #include <string>
 
+#include "lex/TokenKinds.hpp"
+#include "Integer.hpp"
+
 class Token {
 
 public:
     Token();
     Token(std::string tok);
+    Token(KeywordKind kind);
 
     bool &eof()  { return _eof; }
     bool &eol()  { return _eol; }
@@ -29,40 +33,32 @@ public:
     
 
     void symbol(char c) { _symbol = c; }
-    char symbol() { return _symbol; }
+    char symbol() const { return _symbol; }
 
-    void relExp(std::string exp) { _relExp = exp; }
+    void relExp(std::string exp);
+    void relExp(RelOpKind kind) { _relOpKind = kind; _relExp = relOpNames[kind]; }
     std::string getRelOp() const { return _relExp; }
+    RelOpKind relOpKind() const { return _relOpKind; }
 
-    bool isRelGT() const     { return _relExp == ">";  } //done
-    bool isRelLT() const     { return _relExp == "<";  } //done
-    bool isRelGTE() const    { return _relExp == ">="; } //done
-    bool isRelLTE() const    { return _relExp == "<="; } //done
-    bool isRelEQ() const     { return _relExp == "=="; } //done
-    bool isRelNotEQ() const  { return _relExp == "!="; } //done
-    bool isRelEQML() const   { return _relExp == "<>"; } //done
-    bool isRelAssign() const { return _relExp == "=";  }
+    bool isRelGT() const     { return _relOpKind == REL_GT;     } //done
+    bool isRelLT() const     { return _relOpKind == REL_LT;     } //done
+    bool isRelGTE() const    { return _relOpKind == REL_GTE;    } //done
+    bool isRelLTE() const    { return _relOpKind == REL_LTE;    } //done
+    bool isRelEQ() const     { return _relOpKind == REL_EQ;     } //done
+    bool isRelNotEQ() const  { return _relOpKind == REL_NOT_EQ; } //done
+    bool isRelEQML() const   { return _relOpKind == REL_EQML;   } //done
+    bool isRelAssign() const { return _relOpKind == REL_ASSIGN; }
 
 
     bool isRelOp() const {
-      return
-        _relExp != "" && (
-        isRelGT()     ||
-        isRelLT()     ||
-        isRelGTE()    ||
-        isRelLTE()    ||
-        isRelEQ()     ||
-        isRelNotEQ()  ||
-        isRelEQML()   ||
-        isRelAssign()     //needs to be taken out
-      );
+      return _relOpKind != REL_NONE;     // includes isRelAssign() - needs to be taken out
     }
 
     bool isCompOp() const { return isRelOp() && !isRelAssign(); }
 
     bool isColon()     const { return _symbol == ':'; }
     bool isSemiColon() const { return _symbol == ';'; }
-    bool isAssignmentOperator() const     { return _relExp == "="; }
+    bool isAssignmentOperator() const     { return _relOpKind == REL_ASSIGN; }
     bool isMultiplicationOperator() const { return _symbol == '*'; }
     bool isAdditionOperator() const       { return _symbol == '+'; }
     bool isSubtractionOperator() const    { return _symbol == '-'; }
@@ -84,7 +80,7 @@ public:
     void setName(std::string n) { _name = n; }
 
     bool isKeyword() const {
-      return _keyword.length() > 0;
+      return _keywordKind != KW_NONE;
     }
 
     bool isString() const { return _str.length() > 0; }
@@ -97,39 +93,39 @@ public:
       _str = str;
     }
 
-    void setKeyword(std::string keyword)  {
-      _keyword = keyword;
-    }
-
-    bool isPrint()  const { return _keyword == "print"; }
-    bool isFor()    const { return _keyword == "for";   }
-    bool isIf()     const { return _keyword == "if";    }
-    bool isElIf()   const { return _keyword == "elif";  }
-    bool isElse()   const { return _keyword == "else";  }
-    bool isIndent() const { return _keyword == "INDENT";}
-    bool isDedent() const { return _keyword == "DEDENT";}
-    bool isAnd()    const { return _keyword == "and";   }
-    bool isOr()     const { return _keyword == "or";    }
-    bool isNot()    const { return _keyword == "not";   }
-    bool isIn()     const { return _keyword == "in";    }
-    bool isRange()  const { return _keyword == "range"; }
-    bool isFunc()   const { return _keyword == "def";   }
-    bool isLen()    const { return _keyword == "len";   }
-    bool isPeriod() const { return _keyword == ".";     }
-    bool isReturn() const { return _keyword == "return";}
+    void setKeyword(std::string keyword);
+    void setKeyword(KeywordKind kind) { _keywordKind = kind; _keyword = keywordNames[kind]; }
+    KeywordKind keywordKind() const { return _keywordKind; }
+
+    bool isPrint()  const { return _keywordKind == KW_PRINT;  }
+    bool isFor()    const { return _keywordKind == KW_FOR;    }
+    bool isIf()     const { return _keywordKind == KW_IF;     }
+    bool isElIf()   const { return _keywordKind == KW_ELIF;   }
+    bool isElse()   const { return _keywordKind == KW_ELSE;   }
+    bool isIndent() const { return _keywordKind == KW_INDENT; }
+    bool isDedent() const { return _keywordKind == KW_DEDENT; }
+    bool isAnd()    const { return _keywordKind == KW_AND;    }
+    bool isOr()     const { return _keywordKind == KW_OR;     }
+    bool isNot()    const { return _keywordKind == KW_NOT;    }
+    bool isIn()     const { return _keywordKind == KW_IN;     }
+    bool isRange()  const { return _keywordKind == KW_RANGE;  }
+    bool isFunc()   const { return _keywordKind == KW_DEF;    }
+    bool isLen()    const { return _keywordKind == KW_LEN;    }
+    bool isPeriod() const { return _keywordKind == KW_PERIOD; }
+    bool isReturn() const { return _keywordKind == KW_RETURN; }
 
     bool isFloat()  const  { return _isFloat; }
-    float getFloat() const { return _float; }
-    void setFloat(float f) {
+    double getFloat() const { return _float; }
+    void setFloat(double f) {
       _float = f;
       _isFloat = true;
     }
 
     bool &isWholeNumber() { return _isWholeNumber; }
     bool isWholeNumber() const { return _isWholeNumber; }
-    int getWholeNumber() const { return _wholeNumber; }
-    void setWholeNumber(int n) {
-        _wholeNumber = n;
+    const Integer &getWholeNumber() const { return _wholeNumber; }
+    void setWholeNumber(Integer n) {
+        _wholeNumber = std::move(n);
         isWholeNumber() = true;
     }
 
@@ -142,12 +138,14 @@ private:
     std::string _relExp;
     std::string _keyword;
     std::string _str;
+    KeywordKind _keywordKind;
+    RelOpKind _relOpKind;
     bool _eof, _eol;
     bool _isFloat;
     bool _isWholeNumber;
     char _symbol;
-    float _float;
-    int _wholeNumber;
+    double _float;
+    Integer _wholeNumber;
 };
 
 #endif //EXPRINTER_TOKEN_HPP
@@ -0,0 +1,1518 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cerrno>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Transpiler.hpp"
+#include "../Parser.hpp"
+#include "../Script.hpp"
+#include "../lex/Lexer.hpp"
+#include "../statements/Statement.hpp"
+
+// Integer.hpp verbatim - the Makefile wraps it in a raw string literal.
+static const char *integerSource =
+#include "IntegerSource.inc"
+;
+
+// Everything the generated program needs, pasted ahead of the translated
+// code (after Integer). The generic paths follow DescriptorFunctions.hpp and
+// ArithExpr.cpp operation for operation, including their diagnostics.
+static const char *runtimePrelude = R"RUNTIME(#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum Type { INTEGER, DOUBLE, BOOL, STRING, LIST, DICT, UNDEFINED };
+enum CompOp { GT, LT, GTE, LTE, EQ, NE };
+
+struct Dict;
+
+struct Value {
+    Type type = UNDEFINED;
+    union { double doubleValue; int boolValue; } u = { 0 };
+    Integer intValue;
+    std::string str;
+    std::shared_ptr<std::vector<Value>> list;   // shared on copy, as ListDescriptor is
+    std::shared_ptr<Dict> dict;                 // likewise DictDescriptor
+
+    static Value Int(Integer v)        { Value r; r.type = INTEGER; r.intValue = std::move(v); return r; }
+    static Value Double(double v)      { Value r; r.type = DOUBLE; r.u.doubleValue = v; return r; }
+    static Value Bool(bool v)          { Value r; r.type = BOOL; r.u.boolValue = (int) v; return r; }
+    static Value String(std::string v) { Value r; r.type = STRING; r.str = v; return r; }
+    static Value List(std::vector<Value> v) {
+        Value r; r.type = LIST; r.list = std::make_shared<std::vector<Value>>(std::move(v)); return r;
+    }
+};
+
+// DictDescriptor::Table - dense entries in insertion order and an open
+// addressing index of entry numbers.
+struct Dict {
+    struct Entry { uint64_t hash; Value key, value; };
+    std::vector<Entry> entries;
+    std::vector<int32_t> index;
+};
+
+struct Ops   { Value l, r; };
+struct Ints  { Integer l, r; };
+struct Bools { bool l, r; };
+
+struct Fn {
+    Value (*code)(std::vector<Value> &);
+    size_t arity;
+};
+
+static bool validTypeOp(const Value &l, const Value &r) {
+    if ( l.type == LIST || r.type == LIST || l.type == DICT || r.type == DICT )
+        return false;
+    if ( l.type == r.type )
+        return true;
+    if ( l.type == BOOL && ( r.type == DOUBLE || r.type == INTEGER ) )
+        return true;
+    if ( r.type == BOOL && ( l.type == DOUBLE || l.type == INTEGER ) )
+        return true;
+    return ( r.type == INTEGER && l.type == DOUBLE ) || ( l.type == INTEGER && r.type == DOUBLE );
+}
+
+static void checkTypeCompatibility(const char *scope, const Ops &o) {
+    if ( !validTypeOp(o.l, o.r) ) {
+        std::cout << scope << "-Fatal Error - Operands / Operators not compatible" << std::endl;
+        std::cout << "Operator Enum { INTEGER = 0, DOUBLE = 1, BOOL = 2, STRING = 3, LIST = 4, DICT = 5 }" << std::endl;
+        std::cout << "LHS Operator: " << o.l.type << "\t RHS Operator: " << o.r.type << std::endl;
+        exit(1);
+    }
+}
+
+static const Value &get(const Value &v, const char *name) {
+    if ( v.type == UNDEFINED ) {
+        std::cout << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
+        std::cout << "Use of undefined variable, " << name << std::endl;
+        exit(1);
+    }
+    return v;
+}
+
+static inline const Integer &getI(bool defined, const Integer &v, const char *name) {
+    if ( !defined )
+        get(Value(), name);
+    return v;
+}
+
+static const Integer &toInt(const Value &v) {
+    if ( v.type != INTEGER ) {
+        std::cout << "Fatal Error Descriptor::Int::dieIfNotInt" << std::endl;
+        exit(1);
+    }
+    return v.intValue;
+}
+
+static int64_t toSmall(const Integer &v) {
+    if ( !v.isSmall() ) {
+        std::cout << "Fatal Error Descriptor::Int::getSmallIntValue - " << v << " is out of range" << std::endl;
+        exit(1);
+    }
+    return v.small();
+}
+
+static bool truth(const Value &v) {
+    if ( v.type != BOOL ) {
+        std::cout << "Fatal Error Descriptor::Int::dieIfNotBool" << std::endl;
+        exit(1);
+    }
+    return (bool) v.u.boolValue;
+}
+
+static inline Integer negI(const Integer &v) { return -v; }
+
+template <char Op>
+static inline Integer arithI(const Ints &o) {
+    if ( Op == '+' ) return o.l + o.r;
+    if ( Op == '-' ) return o.l - o.r;
+    if ( Op == '*' ) return o.l * o.r;
+    if ( o.r.sign() == 0 ) {
+        std::cout << "Warning: Division by zero is undefined" << std::endl;
+        exit(1);
+    }
+    return Op == '/' ? o.l / o.r : o.l % o.r;
+}
+
+// The bits andDescriptor / orDescriptor / negate look at.
+static int truthBits(const Value &v) {
+    if ( v.type == INTEGER )
+        return v.intValue.sign();
+    if ( v.type == BOOL )
+        return v.u.boolValue;
+    int bits;
+    memcpy(&bits, &v.u.doubleValue, sizeof bits);
+    return bits;
+}
+
+template <CompOp Op, class T>
+static inline bool compareAs(T l, T r) {
+    switch (Op) {
+        case GT:  return l > r;
+        case LT:  return l < r;
+        case GTE: return l >= r;
+        case LTE: return l <= r;
+        case EQ:  return l == r;
+        default:  return l != r;
+    }
+}
+
+template <CompOp Op>
+static inline bool cmpI(const Ints &o) { return compareAs<Op>(o.l, o.r); }
+
+template <bool IsAnd>
+static inline bool logicB(Bools o) { return IsAnd ? ( o.l && o.r ) : ( o.l || o.r ); }
+
+template <char Op>
+static Value arith(const Ops &o) {
+    checkTypeCompatibility("InfixExprNode::evaluate()", o);
+
+    if ( o.l.type == STRING && o.r.type == STRING && Op == '+' )
+        return Value::String(o.l.str + o.r.str);
+    if ( o.l.type == DOUBLE && o.r.type == DOUBLE )
+        return Value::Double(o.l.u.doubleValue + o.r.u.doubleValue);
+    if ( o.l.type != INTEGER || o.r.type != INTEGER ) {
+        std::cout << "Unsupported Type Returning Garbage Value 1" << std::endl;
+        return Value::Int(1);
+    }
+    return Value::Int(arithI<Op>(Ints{ o.l.intValue, o.r.intValue }));
+}
+
+static Value unaryMinus(Value v) {
+    if ( v.type == INTEGER )
+        return Value::Int(negI(v.intValue));
+    if ( v.type == DOUBLE )
+        return Value::Double(v.u.doubleValue * -1);
+    std::cout << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << v.type << std::endl;
+    exit(1);
+}
+
+static double numberOf(const Value &v) {
+    if ( v.type == INTEGER )
+        return v.intValue.toDouble();
+    if ( v.type == DOUBLE )
+        return v.u.doubleValue;
+    return 1.;
+}
+
+template <CompOp Op>
+static Value compare(const Ops &o) {
+    checkTypeCompatibility("ComparisonExprNode::evaluate()", o);
+
+    if ( o.l.type == STRING && o.r.type == STRING )
+        return Value::Bool(compareAs<Op>(o.l.str, o.r.str));
+    if ( o.l.type == INTEGER && o.r.type == INTEGER )
+        return Value::Bool(compareAs<Op>(o.l.intValue, o.r.intValue));
+    return Value::Bool(compareAs<Op>(numberOf(o.l), numberOf(o.r)));
+}
+
+// The right side is evaluated only when the left doesn't decide.
+template <bool IsAnd, class Right>
+static Value logic(const Value &l, Right right) {
+    bool number = l.type == INTEGER || l.type == DOUBLE || l.type == BOOL;
+    if ( number && (truthBits(l) > 0) != IsAnd )
+        return Value::Bool(!IsAnd);
+
+    Ops o{ l, right() };
+    checkTypeCompatibility("BooleanExprNode::evaluate()", o);
+
+    if ( o.l.type == STRING || o.r.type == STRING ) {
+        std::cout << "andDescriptor bad types - quitting" << std::endl;
+        exit(1);
+    }
+    return Value::Bool(logicB<IsAnd>(Bools{ truthBits(o.l) > 0, truthBits(o.r) > 0 }));
+}
+
+static Value negate(const Value &v) {
+    if ( v.type == BOOL )
+        return Value::Bool(!v.u.boolValue);
+    if ( v.type == DOUBLE || v.type == INTEGER )
+        return Value::Bool(truthBits(v) == 0);
+    return Value::Bool(false);
+}
+
+static std::vector<Value> &toList(const Value &v) {
+    if ( v.type != LIST ) {
+        std::cout << "Fatal Error Descriptor::List::dieIfNotList" << std::endl;
+        exit(1);
+    }
+    return *v.list;
+}
+
+static size_t normalizeIndex(const Value &index, size_t length) {
+    const Integer &value = toInt(index);
+    int64_t i = value.isSmall() ? value.small() : INT64_MAX;
+    if ( i < 0 && value.isSmall() )
+        i += (int64_t) length;
+
+    if ( i < 0 || i >= (int64_t) length ) {
+        std::cout << "Fatal Error Descriptor::List::normalizeIndex - index " << value << " out of range" << std::endl;
+        exit(1);
+    }
+    return (size_t) i;
+}
+
+static void printRepr(const Value &v);
+
+// START "DICT"
+// Descriptor::Dict over Values - the same hashes, probing and growth.
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t hashDouble(double d) {
+    if ( d == (double) (int64_t) d && d >= -9.2e18 && d <= 9.2e18 )
+        return mix((uint64_t) (int64_t) d);
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof bits);
+    return mix(bits);
+}
+
+static uint64_t hashOf(const Value &key) {
+    if ( key.type == STRING ) {
+        uint64_t h = 14695981039346656037ULL;
+        for (unsigned char c : key.str) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h == 0 ? 1 : h;
+    }
+    if ( key.type == INTEGER )
+        return key.intValue.isSmall() ? mix((uint64_t) key.intValue.small()) : hashDouble(key.intValue.toDouble());
+    if ( key.type == BOOL )
+        return mix((uint64_t) key.u.boolValue);
+    if ( key.type == DOUBLE )
+        return hashDouble(key.u.doubleValue);
+
+    std::cout << "Fatal Error Descriptor::Dict::hashOf - unhashable type " << key.type << std::endl;
+    exit(1);
+}
+
+static bool isNumber(const Value &v) { return v.type == INTEGER || v.type == DOUBLE || v.type == BOOL; }
+
+static double asNumber(const Value &v) {
+    if ( v.type == DOUBLE )
+        return v.u.doubleValue;
+    return v.type == BOOL ? (double) v.u.boolValue : v.intValue.toDouble();
+}
+
+static bool contains(const Dict &dict, const Value &key);
+static const Value &dictGet(const Dict &dict, const Value &key);
+
+static bool equalValues(const Value &a, const Value &b) {
+    if ( isNumber(a) && isNumber(b) ) {
+        if ( a.type == DOUBLE || b.type == DOUBLE )
+            return asNumber(a) == asNumber(b);
+        Integer x = a.type == BOOL ? Integer((int64_t) a.u.boolValue) : a.intValue;
+        Integer y = b.type == BOOL ? Integer((int64_t) b.u.boolValue) : b.intValue;
+        return compare(x, y) == 0;
+    }
+    if ( a.type != b.type )
+        return false;
+    if ( a.type == STRING )
+        return a.str == b.str;
+    if ( a.type == LIST ) {
+        if ( a.list->size() != b.list->size() )
+            return false;
+        for (size_t i = 0; i < a.list->size(); i++)
+            if ( !equalValues((*a.list)[i], (*b.list)[i]) )
+                return false;
+        return true;
+    }
+    if ( a.type == DICT ) {
+        if ( a.dict->entries.size() != b.dict->entries.size() )
+            return false;
+        for (auto &entry : a.dict->entries)
+            if ( !contains(*b.dict, entry.key) || !equalValues(entry.value, dictGet(*b.dict, entry.key)) )
+                return false;
+        return true;
+    }
+    return false;
+}
+
+static int64_t dictFind(const Dict &dict, const Value &key, uint64_t hash) {
+    if ( dict.index.empty() )
+        return -1;
+
+    size_t mask = dict.index.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        int32_t at = dict.index[slot];
+        if ( at < 0 )
+            return -1;
+        if ( dict.entries[at].hash == hash && equalValues(dict.entries[at].key, key) )
+            return at;
+    }
+}
+
+static void indexEntry(Dict &dict, size_t at) {
+    size_t mask = dict.index.size() - 1;
+    size_t slot = dict.entries[at].hash & mask;
+    while ( dict.index[slot] >= 0 )
+        slot = (slot + 1) & mask;
+    dict.index[slot] = (int32_t) at;
+}
+
+static void dictSet(Dict &dict, const Value &key, const Value &value) {
+    uint64_t hash = hashOf(key);
+
+    int64_t at = dictFind(dict, key, hash);
+    if ( at >= 0 ) {
+        dict.entries[at].value = value;
+        return;
+    }
+
+    dict.entries.push_back({ hash, key, value });
+    if ( dict.entries.size() * 3 > dict.index.size() * 2 ) {
+        dict.index.assign(std::max<size_t>(8, dict.index.size() * 2), -1);
+        for (size_t i = 0; i < dict.entries.size(); i++)
+            indexEntry(dict, i);
+    } else {
+        indexEntry(dict, dict.entries.size() - 1);
+    }
+}
+
+static bool contains(const Dict &dict, const Value &key) {
+    return dictFind(dict, key, hashOf(key)) >= 0;
+}
+
+static const Value &dictGet(const Dict &dict, const Value &key) {
+    int64_t at = dictFind(dict, key, hashOf(key));
+    if ( at < 0 ) {
+        std::cout << "Fatal Error Descriptor::Dict::get - key ";
+        printRepr(key);
+        std::cout << " not found" << std::endl;
+        exit(1);
+    }
+    return dict.entries[at].value;
+}
+
+// { k0: v0, k1: v1, ... } from k0, v0, k1, v1, ...
+static Value dictOf(const std::vector<Value> &items) {
+    Value r;
+    r.type = DICT;
+    r.dict = std::make_shared<Dict>();
+    for (size_t i = 0; i < items.size(); i += 2)
+        dictSet(*r.dict, items[i], items[i + 1]);
+    return r;
+}
+
+// o.l in o.r
+static bool contains(const Ops &o) {
+    if ( o.r.type == DICT )
+        return contains(*o.r.dict, o.l);
+    if ( o.r.type == LIST ) {
+        for (auto &item : *o.r.list)
+            if ( equalValues(item, o.l) )
+                return true;
+        return false;
+    }
+    if ( o.r.type == STRING ) {
+        if ( o.l.type != STRING ) {
+            std::cout << "Fatal Error Descriptor::contains - 'in <string>' requires string as left operand" << std::endl;
+            exit(1);
+        }
+        return o.r.str.find(o.l.str) != std::string::npos;
+    }
+    std::cout << "Fatal Error Descriptor::contains - type " << o.r.type << " is not a container" << std::endl;
+    exit(1);
+}
+// END "DICT"
+
+static size_t length(const Value &v) {
+    if ( v.type == DICT )
+        return v.dict->entries.size();
+    return v.type == STRING ? v.str.size() : toList(v).size();
+}
+
+static Value subscript(const Value &sequence, const Value &index) {
+    if ( sequence.type == DICT )
+        return dictGet(*sequence.dict, index);
+    if ( sequence.type == STRING )
+        return Value::String(sequence.str.substr(normalizeIndex(index, sequence.str.size()), 1));
+    std::vector<Value> &list = toList(sequence);
+    return list[normalizeIndex(index, list.size())];
+}
+
+// Element i of a sequence being iterated - the bounds were checked by the loop.
+static Value itemAt(const Value &sequence, size_t i) {
+    if ( sequence.type == DICT )
+        return sequence.dict->entries[i].key;
+    return sequence.type == STRING ? Value::String(sequence.str.substr(i, 1)) : (*sequence.list)[i];
+}
+
+// container[index] = item on a list or a dict
+static void setItem(const Value &container, const Value &index, const Value &item) {
+    if ( container.type == DICT ) {
+        dictSet(*container.dict, index, item);
+        return;
+    }
+    std::vector<Value> &list = toList(container);
+    list[normalizeIndex(index, list.size())] = item;
+}
+
+static void iterable(const Value &v) {
+    if ( v.type != LIST && v.type != STRING && v.type != DICT ) {
+        std::cout << "RangeStmt::evaluate - Fatal Error - type " << v.type << " is not iterable" << std::endl;
+        exit(1);
+    }
+}
+
+static std::string reprDouble(double value) {
+    if ( value != value )
+        return "nan";
+    if ( value == value * 2 && value != 0 )
+        return value < 0 ? "-inf" : "inf";
+
+    char buffer[32];
+    char *end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::scientific).ptr;
+    std::string text(buffer, end);
+
+    std::string sign = text[0] == '-' ? "-" : "";
+    if ( !sign.empty() )
+        text.erase(0, 1);
+
+    size_t e = text.find('e');
+    int exponent = atoi(text.c_str() + e + 1);
+    std::string digits;
+    for (char c : text.substr(0, e))
+        if ( c != '.' )
+            digits += c;
+
+    if ( exponent < -4 || exponent >= 16 ) {
+        std::string mantissa = digits.substr(0, 1) + ( digits.size() > 1 ? "." + digits.substr(1) : "" );
+        std::string power = std::to_string(exponent < 0 ? -exponent : exponent);
+        return sign + mantissa + "e" + ( exponent < 0 ? "-" : "+" ) + ( power.size() < 2 ? "0" : "" ) + power;
+    }
+    if ( exponent < 0 )
+        return sign + "0." + std::string(-exponent - 1, '0') + digits;
+
+    if ( digits.size() <= (size_t) exponent + 1 )
+        return sign + digits + std::string(exponent + 1 - digits.size(), '0') + ".0";
+    return sign + digits.substr(0, exponent + 1) + "." + digits.substr(exponent + 1);
+}
+
+static std::string strDouble(double value) {
+    char buffer[32];
+    char *end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::general, 12).ptr;
+    std::string text(buffer, end);
+
+    if ( text.find_first_not_of("-0123456789") != std::string::npos )
+        return text;
+    if ( text.size() - (text[0] == '-') < 12 )
+        return text + ".0";
+
+    end = std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::scientific, 11).ptr;
+    text.assign(buffer, end);
+    size_t e = text.find('e');
+    size_t last = text.find_last_not_of('0', e - 1);
+    if ( text[last] == '.' )
+        last--;
+    return text.substr(0, last + 1) + text.substr(e);
+}
+
+static std::string reprString(const std::string &value) {
+    char quote = value.find('\'') != std::string::npos && value.find('"') == std::string::npos ? '"' : '\'';
+    std::string text(1, quote);
+
+    for (unsigned char c : value) {
+        if ( c == quote || c == '\\' )
+            text += std::string("\\") + (char) c;
+        else if ( c == '\n' )
+            text += "\\n";
+        else if ( c == '\t' )
+            text += "\\t";
+        else if ( c == '\r' )
+            text += "\\r";
+        else if ( c < 0x20 || c >= 0x7F ) {
+            char hex[5];
+            snprintf(hex, sizeof hex, "\\x%02x", c);
+            text += hex;
+        } else
+            text += (char) c;
+    }
+    return text + quote;
+}
+
+static void print(const Value &v);
+
+static void printRepr(const Value &v) {
+    if ( v.type == DOUBLE )      std::cout << reprDouble(v.u.doubleValue);
+    else if ( v.type == STRING ) std::cout << reprString(v.str);
+    else                         print(v);
+}
+
+static void print(const Value &v) {
+    if ( v.type == INTEGER )     std::cout << v.intValue;
+    else if ( v.type == DOUBLE ) std::cout << strDouble(v.u.doubleValue);
+    else if ( v.type == BOOL )   std::cout << v.u.boolValue;
+    else if ( v.type == LIST ) {
+        std::cout << "[";
+        for (size_t i = 0; i < v.list->size(); i++) {
+            if ( i > 0 )
+                std::cout << ", ";
+            printRepr((*v.list)[i]);
+        }
+        std::cout << "]";
+    }
+    else if ( v.type == DICT ) {
+        std::cout << "{";
+        for (size_t i = 0; i < v.dict->entries.size(); i++) {
+            if ( i > 0 )
+                std::cout << ", ";
+            printRepr(v.dict->entries[i].key);
+            std::cout << ": ";
+            printRepr(v.dict->entries[i].value);
+        }
+        std::cout << "}";
+    }
+    else                         std::cout << v.str;
+}
+
+static int rangeMode(int64_t start, int64_t end, int64_t step) {
+    // 0 -> no iterations, 1 -> counting down, 2 -> counting up
+    if ( start > end && step < 0 )
+        return 1;
+    if ( start < end && 1 <= step )
+        return 2;
+    if ( start == end )
+        return 0;
+    std::cout << "Invalid For Loop" << std::endl;
+    std::cout << "Start: " << start << "\t End: " << end << "\t Step: " << step << std::endl;
+    exit(1);
+}
+
+static void loopVariableDefined(const char *name) {
+    std::cout << "Variable " << name << " is defined - dying (( FIX )) " << std::endl;
+    exit(1);
+}
+
+// Builtins - builtins/Builtins.cpp with the scalar kernels. A list of small
+// ints or of doubles takes the path an unboxed ListDescriptor would.
+static void dieBuiltin(const char *scope, const std::string &message) {
+    std::cout << "Builtins::" << scope << " - Fatal Error - " << message << std::endl;
+    exit(1);
+}
+
+static void expectArguments(const std::vector<Value> &args, size_t count) {
+    if ( args.size() != count ) {
+        std::cout << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
+        exit(1);
+    }
+}
+
+static const std::vector<Value> &listArgument(const char *scope, const Value &v) {
+    if ( v.type != LIST )
+        dieBuiltin(scope, "argument is not a list");
+    return *v.list;
+}
+
+static bool allSmallInts(const std::vector<Value> &list) {
+    for (auto &v : list)
+        if ( v.type != INTEGER || !v.intValue.isSmall() )
+            return false;
+    return !list.empty();
+}
+
+static bool allDoubles(const std::vector<Value> &list) {
+    for (auto &v : list)
+        if ( v.type != DOUBLE )
+            return false;
+    return !list.empty();
+}
+
+static Integer fromInt128(__int128 value) {
+    if ( value >= INT64_MIN && value <= INT64_MAX )
+        return Integer((int64_t) value);
+    uint64_t low = (uint64_t) value;
+    Integer two32(int64_t(1) << 32);
+    Integer high((int64_t) (value >> 64));
+    return (high * two32 + Integer((int64_t) (low >> 32))) * two32 + Integer((int64_t) (low & 0xFFFFFFFF));
+}
+
+// Eight partial sums combined in the kernels' fixed order.
+template <class Term>
+static double laneSum(size_t n, Term term) {
+    double lanes[8] = { 0 };
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int j = 0; j < 8; j++)
+            lanes[j] += term(i + j);
+    double total = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+    for (; i < n; i++)
+        total += term(i);
+    return total;
+}
+
+static Value numericArgument(const char *scope, const Value &v) {
+    if ( v.type == INTEGER || v.type == DOUBLE )
+        return v;
+    if ( v.type == BOOL )
+        return Value::Int(Integer((int64_t) v.u.boolValue));
+    dieBuiltin(scope, "unsupported operand type " + std::to_string(v.type));
+    return v;
+}
+
+static double asDouble(const Value &v) {
+    return v.type == DOUBLE ? v.u.doubleValue : v.intValue.toDouble();
+}
+
+// Exact until the first float, as sum() is.
+static Value addNumbers(const Value &total, const Value &n) {
+    if ( total.type == INTEGER && n.type == INTEGER )
+        return Value::Int(total.intValue + n.intValue);
+    return Value::Double(asDouble(total) + asDouble(n));
+}
+
+static Value boxedSum(const char *scope, const std::vector<Value> &list) {
+    Value total = Value::Int(0);
+    for (auto &v : list)
+        total = addNumbers(total, numericArgument(scope, v));
+    return total;
+}
+
+static Value builtinSum(std::vector<Value> &args) {
+    expectArguments(args, 1);
+    auto &list = listArgument("sum", args[0]);
+
+    if ( allSmallInts(list) ) {
+        __int128 total = 0;
+        for (auto &v : list)
+            total += v.intValue.small();
+        return Value::Int(fromInt128(total));
+    }
+    if ( allDoubles(list) )
+        return Value::Double(laneSum(list.size(), [&](size_t i) { return list[i].u.doubleValue; }));
+    return boxedSum("sum", list);
+}
+
+static int compareElements(const char *scope, const Value &a, const Value &b) {
+    if ( a.type == STRING && b.type == STRING )
+        return a.str.compare(b.str);
+    if ( a.type == STRING || b.type == STRING )
+        dieBuiltin(scope, "elements are not comparable");
+
+    Value x = numericArgument(scope, a), y = numericArgument(scope, b);
+    if ( x.type == INTEGER && y.type == INTEGER )
+        return compare(x.intValue, y.intValue);
+    return asDouble(x) < asDouble(y) ? -1 : asDouble(x) > asDouble(y) ? 1 : 0;
+}
+
+template <bool IsMin>
+static Value builtinExtreme(std::vector<Value> &args) {
+    const char *scope = IsMin ? "min" : "max";
+    if ( args.empty() )
+        expectArguments(args, 1);
+
+    const std::vector<Value> &list = args.size() > 1 ? args : listArgument(scope, args[0]);
+    if ( list.empty() )
+        dieBuiltin(scope, "arg is an empty sequence");
+
+    size_t best = 0;
+    for (size_t i = 1; i < list.size(); i++) {
+        int order = compareElements(scope, list[i], list[best]);
+        if ( IsMin ? order < 0 : order > 0 )
+            best = i;
+    }
+    return list[best];
+}
+
+static Value builtinMean(std::vector<Value> &args) {
+    expectArguments(args, 1);
+    auto &list = listArgument("mean", args[0]);
+    if ( list.empty() )
+        dieBuiltin("mean", "mean requires at least one data point");
+
+    double total;
+    if ( allSmallInts(list) ) {
+        __int128 exact = 0;
+        for (auto &v : list)
+            exact += v.intValue.small();
+        total = (double) exact;
+    } else if ( allDoubles(list) ) {
+        total = laneSum(list.size(), [&](size_t i) { return list[i].u.doubleValue; });
+    } else {
+        Value sum = boxedSum("mean", list);
+        total = sum.type == DOUBLE ? sum.u.doubleValue : sum.intValue.toDouble();
+    }
+    return Value::Double(total / list.size());
+}
+
+static Value builtinDot(std::vector<Value> &args) {
+    expectArguments(args, 2);
+    auto &a = listArgument("dot", args[0]);
+    auto &b = listArgument("dot", args[1]);
+    size_t n = a.size();
+    if ( n != b.size() )
+        dieBuiltin("dot", "lists have different lengths");
+
+    if ( allSmallInts(a) && allSmallInts(b) ) {
+        __int128 total = 0;
+        bool fits = true;
+        for (size_t i = 0; fits && i < n; i++)
+            fits = !__builtin_add_overflow(total, (__int128) a[i].intValue.small() * b[i].intValue.small(), &total);
+        if ( fits )
+            return Value::Int(fromInt128(total));
+    }
+    if ( allDoubles(a) && allDoubles(b) )
+        return Value::Double(laneSum(n, [&](size_t i) { return a[i].u.doubleValue * b[i].u.doubleValue; }));
+
+    Value total = Value::Int(0);
+    for (size_t i = 0; i < n; i++) {
+        Value x = numericArgument("dot", a[i]), y = numericArgument("dot", b[i]);
+        if ( x.type == INTEGER && y.type == INTEGER )
+            total = addNumbers(total, Value::Int(x.intValue * y.intValue));
+        else
+            total = addNumbers(total, Value::Double(asDouble(x) * asDouble(y)));
+    }
+    return total;
+}
+
+typedef Value (*Builtin)(std::vector<Value> &);
+
+static Builtin lookupBuiltin(const char *name) {
+    if ( strcmp(name, "sum") == 0 )  return builtinSum;
+    if ( strcmp(name, "min") == 0 )  return builtinExtreme<true>;
+    if ( strcmp(name, "max") == 0 )  return builtinExtreme<false>;
+    if ( strcmp(name, "mean") == 0 ) return builtinMean;
+    if ( strcmp(name, "dot") == 0 )  return builtinDot;
+    return nullptr;
+}
+
+template <class Args>
+static Value callFn(const Fn &fn, const char *name, size_t nargs, Args args) {
+    if ( fn.code == nullptr ) {
+        if ( Builtin builtin = lookupBuiltin(name) ) {
+            std::vector<Value> values = args();
+            return builtin(values);
+        }
+        std::cout << "FunctionCall::evaluate - Fatal Error - Call to undefined function " << name << std::endl;
+        exit(1);
+    }
+    if ( fn.arity != nargs ) {
+        std::cout << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
+        exit(1);
+    }
+    std::vector<Value> values = args();
+    return fn.code(values);
+}
+)RUNTIME";
+
+static const char *compOpName(const std::shared_ptr<Token> &tok) {
+    if ( tok->isRelGT() )  return "GT";
+    if ( tok->isRelLT() )  return "LT";
+    if ( tok->isRelGTE() ) return "GTE";
+    if ( tok->isRelLTE() ) return "LTE";
+    if ( tok->isRelEQ() )  return "EQ";
+    return "NE";
+}
+
+Transpiler::Transpiler():
+    _inFunction{false},
+    _tmp{0}
+{}
+
+// START "INFERENCE"
+void Transpiler::collectTopLevel(Statements *stmts) {
+
+    for (auto &&stmt : stmts->_statements) {
+        Statement *s = stmt.get();
+
+        if ( auto assign = dynamic_cast<AssignStmt *>(s) ) {
+            _globals.insert(assign->_lhsVariable);
+            _assignments[assign->_lhsVariable].push_back(assign->_rhsExpression.get());
+            collectExprNames(assign->_rhsExpression.get(), _globals);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(s) ) {
+            _globals.insert(range->_id);
+            if ( range->_iterable != nullptr ) {
+                _untypedGlobals.insert(range->_id);
+                collectExprNames(range->_iterable.get(), _globals);
+            } else {
+                _loopVars.insert(range->_id);
+                for (auto &&arg : *range->_testList)
+                    collectExprNames(arg.get(), _globals);
+            }
+            collectTopLevel(range->_forBody.get());
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(s) ) {
+            collectExprNames(ifStatement->_if->_if.first.get(), _globals);
+            collectTopLevel(ifStatement->_if->_if.second.get());
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif) {
+                    collectExprNames(elif.first.get(), _globals);
+                    collectTopLevel(elif.second.get());
+                }
+            if ( ifStatement->_else != nullptr )
+                collectTopLevel(ifStatement->_else->_stmts.get());
+        } else if ( auto print = dynamic_cast<PrintStatement *>(s) ) {
+            for (auto &&item : *print->_testList)
+                collectExprNames(item.get(), _globals);
+        } else if ( auto ret = dynamic_cast<ReturnStatement *>(s) ) {
+            collectExprNames(ret->_returnExpr.get(), _globals);
+        } else if ( auto call = dynamic_cast<FunctionCallStatement *>(s) ) {
+            collectExprNames(call->_exprNodeCall.get(), _globals);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(s) ) {
+            _globals.insert(append->_listName);
+            _untypedGlobals.insert(append->_listName);
+            collectExprNames(append->_value.get(), _globals);
+        } else if ( auto subscriptAssign = dynamic_cast<SubscriptAssignStmt *>(s) ) {
+            _globals.insert(subscriptAssign->_listName);
+            _untypedGlobals.insert(subscriptAssign->_listName);
+            collectExprNames(subscriptAssign->_index.get(), _globals);
+            collectExprNames(subscriptAssign->_rhsExpression.get(), _globals);
+        }
+    }
+}
+
+// Every name a function body touches is local to it - SymTab::openScope hides the globals.
+void Transpiler::collectNames(Statements *stmts, std::set<std::string> &names) {
+
+    for (auto &&stmt : stmts->_statements) {
+        Statement *s = stmt.get();
+
+        if ( auto assign = dynamic_cast<AssignStmt *>(s) ) {
+            names.insert(assign->_lhsVariable);
+            collectExprNames(assign->_rhsExpression.get(), names);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(s) ) {
+            names.insert(range->_id);
+            collectExprNames(range->_iterable.get(), names);
+            if ( range->_testList != nullptr )
+                for (auto &&arg : *range->_testList)
+                    collectExprNames(arg.get(), names);
+            collectNames(range->_forBody.get(), names);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(s) ) {
+            collectExprNames(ifStatement->_if->_if.first.get(), names);
+            collectNames(ifStatement->_if->_if.second.get(), names);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif) {
+                    collectExprNames(elif.first.get(), names);
+                    collectNames(elif.second.get(), names);
+                }
+            if ( ifStatement->_else != nullptr )
+                collectNames(ifStatement->_else->_stmts.get(), names);
+        } else if ( auto print = dynamic_cast<PrintStatement *>(s) ) {
+            for (auto &&item : *print->_testList)
+                collectExprNames(item.get(), names);
+        } else if ( auto ret = dynamic_cast<ReturnStatement *>(s) ) {
+            collectExprNames(ret->_returnExpr.get(), names);
+        } else if ( auto call = dynamic_cast<FunctionCallStatement *>(s) ) {
+            collectExprNames(call->_exprNodeCall.get(), names);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(s) ) {
+            names.insert(append->_listName);
+            collectExprNames(append->_value.get(), names);
+        } else if ( auto subscriptAssign = dynamic_cast<SubscriptAssignStmt *>(s) ) {
+            names.insert(subscriptAssign->_listName);
+            collectExprNames(subscriptAssign->_index.get(), names);
+            collectExprNames(subscriptAssign->_rhsExpression.get(), names);
+        }
+    }
+}
+
+void Transpiler::collectExprNames(ExprNode *expr, std::set<std::string> &names) {
+
+    if ( expr == nullptr )
+        return;
+
+    if ( dynamic_cast<Variable *>(expr) )
+        names.insert(expr->token()->getName());
+    else if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        collectExprNames(infix->_left.get(), names);
+        collectExprNames(infix->_right.get(), names);
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        collectExprNames(comparison->_left.get(), names);
+        collectExprNames(comparison->_right.get(), names);
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        collectExprNames(boolean->_left.get(), names);
+        collectExprNames(boolean->_right.get(), names);
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr) ) {
+        _functionNames.insert(call->_functionName);
+        for (auto &&arg : *call->_testList)
+            collectExprNames(arg.get(), names);
+    } else if ( auto list = dynamic_cast<ListExp *>(expr) ) {
+        for (auto &&element : *list->_elements)
+            collectExprNames(element.get(), names);
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr) ) {
+        collectExprNames(subscript->_sequence.get(), names);
+        collectExprNames(subscript->_index.get(), names);
+    } else if ( auto len = dynamic_cast<LenExp *>(expr) ) {
+        collectExprNames(len->_sequence.get(), names);
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr) ) {
+        for (size_t i = 0; i < dict->_keys->size(); i++) {
+            collectExprNames((*dict->_keys)[i].get(), names);
+            collectExprNames((*dict->_values)[i].get(), names);
+        }
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr) ) {
+        collectExprNames(membership->_left.get(), names);
+        collectExprNames(membership->_right.get(), names);
+    }
+}
+
+void Transpiler::inferTypes() {
+
+    // Optimistically type every assigned global as an int, then demote the
+    // ones that receive anything else until nothing changes.
+    for (auto &assignment : _assignments)
+        _intGlobals.insert(assignment.first);
+    for (auto &loopVar : _loopVars)
+        _intGlobals.insert(loopVar);
+    for (auto &name : _untypedGlobals)
+        _intGlobals.erase(name);
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto &assignment : _assignments) {
+            if ( !_intGlobals.count(assignment.first) )
+                continue;
+            for (auto rhs : assignment.second) {
+                if ( kindOf(rhs) != INT ) {
+                    _intGlobals.erase(assignment.first);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (debug)
+        for (auto &name : _intGlobals)
+            std::cout << "Transpiler::inferTypes - " << name << " is an int" << std::endl;
+}
+
+Transpiler::Kind Transpiler::kindOf(ExprNode *expr) {
+
+    if ( dynamic_cast<WholeNumber *>(expr) || dynamic_cast<LenExp *>(expr) )
+        return INT;
+
+    if ( dynamic_cast<Variable *>(expr) )
+        return isTyped(expr->token()->getName()) ? INT : DYN;
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        if ( infix->_right == nullptr )
+            return kindOf(infix->_left.get()) == INT ? INT : DYN;
+        return kindOf(infix->_left.get()) == INT && kindOf(infix->_right.get()) == INT ? INT : DYN;
+    }
+
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) )
+        return kindOf(comparison->_left.get()) == INT && kindOf(comparison->_right.get()) == INT ? BOOL : DYN;
+
+    if ( dynamic_cast<MembershipExprNode *>(expr) )
+        return BOOL;
+
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        if ( kindOf(boolean->_left.get()) == DYN )
+            return DYN;
+        if ( boolean->token()->isNot() )
+            return BOOL;
+        return kindOf(boolean->_right.get()) == DYN ? DYN : BOOL;
+    }
+
+    return DYN;
+}
+// END "INFERENCE"
+
+
+// START "EMISSION"
+std::string Transpiler::translate(Statements &program) {
+
+    collectTopLevel(&program);
+    inferTypes();
+
+    // Function definitions can appear anywhere - the function table is global.
+    std::vector<Statements *> pending{ &program };
+    while ( !pending.empty() ) {
+        Statements *stmts = pending.back();
+        pending.pop_back();
+
+        for (auto &&stmt : stmts->_statements) {
+            if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt.get()) ) {
+                std::string symbol = "f_" + funcDef->_funcName + "_" + std::to_string(_functions.size());
+                _functions.push_back({ funcDef, symbol, nullptr, "" });
+                parseBody(_functions.back());
+                _functionSymbols[funcDef] = symbol;
+                _functionNames.insert(funcDef->_funcName);
+                if ( _functions.back().body != nullptr )
+                    pending.push_back(_functions.back().body);
+            } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+                pending.push_back(range->_forBody.get());
+            } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+                pending.push_back(ifStatement->_if->_if.second.get());
+                if ( ifStatement->_elif != nullptr )
+                    for (auto &&elif : ifStatement->_elif->_elif)
+                        pending.push_back(elif.second.get());
+                if ( ifStatement->_else != nullptr )
+                    pending.push_back(ifStatement->_else->_stmts.get());
+            }
+        }
+    }
+
+    _out.str("");
+    _out << "// Generated by statement.x --aot\n";
+    _out << integerSource << "\n" << runtimePrelude << "\n";
+
+    for (auto &name : _globals) {
+        if ( isTyped(name) )
+            _out << "static Integer v_" << name << ";\nstatic bool d_" << name << ";\n";
+        else
+            _out << "static Value v_" << name << ";\n";
+    }
+    for (auto &name : _functionNames)
+        _out << "static Fn fn_" << name << ";\n";
+    _out << "\n";
+
+    for (auto &function : _functions)
+        _out << "static Value " << function.symbol << "(std::vector<Value> &args);\n";
+    _out << "\n";
+
+    for (auto &function : _functions)
+        emitFunction(function);
+
+    _out << "int main() {\n";
+    emitStatements(&program, "    ");
+    _out << "    return 0;\n}\n";
+
+    return _out.str();
+}
+
+int Transpiler::compile(Statements &program, std::string executable) {
+
+    // g++ runs without a shell, so the names need no quoting - only one
+    // starting with '-' would read as an option.
+    if ( !executable.empty() && executable[0] == '-' )
+        executable = "./" + executable;
+
+    std::string source = executable + ".cpp";
+    std::ofstream out(source);
+
+    if ( !out.is_open() ) {
+        std::cout << "Transpiler::compile - Unable to open " << source << std::endl;
+        return 1;
+    }
+
+    out << translate(program);
+    out.close();
+
+    std::vector<std::string> command = { "g++", "-O2", "-std=c++17", "-o", executable, source };
+
+    if (debug) {
+        for (auto &arg : command)
+            std::cout << arg << ' ';
+        std::cout << std::endl;
+    }
+
+    std::vector<char *> argv;
+    for (auto &arg : command)
+        argv.push_back(arg.data());
+    argv.push_back(nullptr);
+
+    std::cout.flush();
+    pid_t child = fork();
+    if ( child == 0 ) {
+        execvp(argv[0], argv.data());
+        std::cout << "Transpiler::compile - Unable to run g++" << std::endl;
+        _exit(127);
+    }
+
+    if ( child < 0 ) {
+        std::cout << "Transpiler::compile - Unable to run g++" << std::endl;
+        return 1;
+    }
+
+    int status;
+    while ( waitpid(child, &status, 0) < 0 )
+        if ( errno != EINTR )
+            return 1;
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
+
+// A lazy body is parsed here from a copy of its tokens, so the definition
+// is left as the interpreter would find it. One that doesn't parse fails
+// when it is called, as it does with --lazy.
+void Transpiler::parseBody(Function &function) {
+
+    auto def = function.def;
+    if ( def->isParsed() ) {
+        function.body = def->suite();
+        return;
+    }
+
+    std::ostringstream errors;
+    Script::Redirect redirect(errors);
+    Script::Job job;
+
+    try {
+        Lexer replay(std::vector<std::shared_ptr<Token>>(def->_lazySuite));
+        Parser parser(replay);
+        _lazyBodies.push_back(parser.func_suite());
+        function.body = _lazyBodies.back().get();
+    } catch (const Script::Exit &) {
+        function.parseError = errors.str();
+    }
+}
+
+void Transpiler::emitFunction(Function &function) {
+
+    if ( function.body == nullptr ) {
+        _out << "static Value " << function.symbol << "(std::vector<Value> &) {\n";
+        _out << "    std::cout << " << quote(function.parseError) << ";\n";
+        _out << "    exit(1);\n}\n\n";
+        return;
+    }
+
+    std::set<std::string> locals(function.def->_paramList.begin(), function.def->_paramList.end());
+    collectNames(function.body, locals);
+
+    _out << "static Value " << function.symbol << "(std::vector<Value> &args) {\n";
+    for (auto &name : locals)
+        _out << "    Value l_" << name << ";\n";
+    for (size_t i = 0; i < function.def->_paramList.size(); i++)
+        _out << "    l_" << function.def->_paramList[i] << " = args[" << i << "];\n";
+
+    _inFunction = true;
+    emitStatements(function.body, "    ");
+    _inFunction = false;
+
+    _out << "    return Value::Int(0);\n}\n\n";
+}
+
+void Transpiler::emitStatements(Statements *stmts, std::string indent) {
+    for (auto &&stmt : stmts->_statements)
+        emitStatement(stmt.get(), indent);
+}
+
+void Transpiler::emitStatement(Statement *stmt, std::string indent) {
+
+    if ( auto assign = dynamic_cast<AssignStmt *>(stmt) ) {
+        std::string name = assign->_lhsVariable;
+        if ( isTyped(name) )
+            _out << indent << "v_" << name << " = " << intValue(assign->_rhsExpression.get()) << "; d_" << name << " = true;\n";
+        else
+            _out << indent << var(name) << " = " << value(assign->_rhsExpression.get()) << ";\n";
+
+    } else if ( auto print = dynamic_cast<PrintStatement *>(stmt) ) {
+        for (auto &&item : *print->_testList) {
+            Kind kind;
+            std::string code = expr(item.get(), kind);
+            if ( kind == DYN )
+                _out << indent << "print(" << code << "); std::cout << \" \";\n";
+            else
+                _out << indent << "std::cout << (" << code << ") << \" \";\n";
+        }
+        _out << indent << "std::cout << std::endl;\n";
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        std::vector<std::pair<ExprNode *, Statements *>> branches;
+        branches.push_back({ ifStatement->_if->_if.first.get(), ifStatement->_if->_if.second.get() });
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif)
+                branches.push_back({ elif.first.get(), elif.second.get() });
+
+        for (size_t i = 0; i < branches.size(); i++) {
+            Kind kind;
+            std::string cond = expr(branches[i].first, kind);
+            if ( kind != BOOL )
+                cond = "truth(" + value(branches[i].first) + ")";
+            _out << indent << (i == 0 ? "if (" : "} else if (") << cond << ") {\n";
+            emitStatements(branches[i].second, indent + "    ");
+        }
+        if ( ifStatement->_else != nullptr ) {
+            _out << indent << "} else {\n";
+            emitStatements(ifStatement->_else->_stmts.get(), indent + "    ");
+        }
+        _out << indent << "}\n";
+
+    } else if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        if ( range->_iterable != nullptr ) {
+            emitSequenceLoop(range, indent);
+            return;
+        }
+
+        // prange(...) compiles to the same serial loop as range(...).
+        auto &testList = *range->_testList;
+        std::string id = range->_id;
+        std::string n = std::to_string(_tmp++);
+        std::string start = "start" + n, end = "end" + n, step = "step" + n, mode = "mode" + n;
+        bool typed = isTyped(id);
+
+        _out << indent << "{\n";
+        std::string in = indent + "    ";
+
+        if ( testList.size() > 3 ) {
+            _out << in << "std::cout << \"Too many nodes!\" << std::endl;\n" << in << "exit(1);\n";
+            _out << indent << "}\n";
+            return;
+        }
+
+        _out << in << "int64_t " << start << " = 0, " << end << " = 0, " << step << " = 1;\n";
+        std::string bounds[3] = { start, end, step };
+        int first = testList.size() == 1 ? 1 : 0;
+        for (size_t i = 0; i < testList.size(); i++)
+            _out << in << bounds[first + i] << " = toSmall(" << intValue(testList[i].get()) << ");\n";
+
+        std::string defined = typed ? "d_" + id : var(id) + ".type != UNDEFINED";
+        std::string current = typed ? "v_" + id : "toInt(" + var(id) + ")";
+        std::string increment = typed
+            ? "v_" + id + " += " + step
+            : var(id) + " = Value::Int(arithI<'+'>(Ints{ toInt(" + var(id) + "), " + step + " }))";
+
+        _out << in << "if ( " << defined << " )\n" << in << "    loopVariableDefined(\"" << id << "\");\n";
+        if ( typed )
+            _out << in << "v_" << id << " = " << start << "; d_" << id << " = true;\n";
+        else
+            _out << in << var(id) << " = Value::Int(" << start << ");\n";
+
+        _out << in << "int " << mode << " = rangeMode(" << start << ", " << end << ", " << step << ");\n";
+        _out << in << "if ( " << mode << " != 0 )\n";
+        _out << in << "for (; " << mode << " == 2 ? " << current << " < " << end << " : " << current << " > " << end
+             << "; " << increment << ") {\n";
+
+        _liveLoopVars.push_back(id);
+        emitStatements(range->_forBody.get(), in + "    ");
+        _liveLoopVars.pop_back();
+
+        _out << in << "}\n";
+        if ( typed )
+            _out << in << "d_" << id << " = false;\n";
+        else
+            _out << in << var(id) << " = Value();\n";
+        _out << indent << "}\n";
+
+    } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt) ) {
+        _out << indent << "fn_" << funcDef->_funcName << " = Fn{ &" << _functionSymbols[funcDef] << ", "
+             << funcDef->_paramList.size() << " };\n";
+
+    } else if ( auto ret = dynamic_cast<ReturnStatement *>(stmt) ) {
+        if ( _inFunction )
+            _out << indent << "return " << value(ret->_returnExpr.get()) << ";\n";
+        else
+            _out << indent << "(void) " << value(ret->_returnExpr.get()) << ";\n";
+
+    } else if ( auto call = dynamic_cast<FunctionCallStatement *>(stmt) ) {
+        _out << indent << "(void) " << value(call->_exprNodeCall.get()) << ";\n";
+
+    } else if ( auto append = dynamic_cast<AppendStatement *>(stmt) ) {
+        std::string name = append->_listName;
+        _out << indent << "{\n";
+        _out << indent << "    Value item = " << value(append->_value.get()) << ";\n";
+        _out << indent << "    toList(get(" << var(name) << ", \"" << name << "\")).push_back(item);\n";
+        _out << indent << "}\n";
+
+    } else if ( auto subscriptAssign = dynamic_cast<SubscriptAssignStmt *>(stmt) ) {
+        std::string name = subscriptAssign->_listName;
+        _out << indent << "{\n";
+        _out << indent << "    Value index = " << value(subscriptAssign->_index.get()) << ";\n";
+        _out << indent << "    Value item = " << value(subscriptAssign->_rhsExpression.get()) << ";\n";
+        _out << indent << "    setItem(get(" << var(name) << ", \"" << name << "\"), index, item);\n";
+        _out << indent << "}\n";
+
+    } else {
+        std::cout << "Transpiler::emitStatement - Fatal Error - unsupported statement" << std::endl;
+        exit(1);
+    }
+}
+
+// for x in <sequence> - a Value walked by index, re-reading its length each
+// pass as RangeStmt::iterateSequence does.
+void Transpiler::emitSequenceLoop(RangeStmt *range, std::string indent) {
+    std::string id = range->_id;
+    std::string n = std::to_string(_tmp++);
+    std::string sequence = "sequence" + n, i = "i" + n;
+    std::string in = indent + "    ";
+
+    _out << indent << "{\n";
+    _out << in << "Value " << sequence << " = " << value(range->_iterable.get()) << ";\n";
+    _out << in << "iterable(" << sequence << ");\n";
+    _out << in << "if ( " << var(id) << ".type != UNDEFINED )\n" << in << "    loopVariableDefined(\"" << id << "\");\n";
+    _out << in << "for (size_t " << i << " = 0; " << i << " < length(" << sequence << "); " << i << "++) {\n";
+    _out << in << "    " << var(id) << " = itemAt(" << sequence << ", " << i << ");\n";
+
+    _liveLoopVars.push_back(id);
+    emitStatements(range->_forBody.get(), in + "    ");
+    _liveLoopVars.pop_back();
+
+    _out << in << "}\n";
+    _out << in << var(id) << " = Value();\n";
+    _out << indent << "}\n";
+}
+
+std::string Transpiler::expr(ExprNode *node, Kind &kind) {
+
+    auto tok = node->token();
+
+    if ( dynamic_cast<WholeNumber *>(node) ) {
+        kind = INT;
+        const Integer &n = tok->getWholeNumber();
+        if ( n.isSmall() && n.small() != INT64_MIN )
+            return "Integer(INT64_C(" + n.toString() + "))";
+        return "[]() -> const Integer & { static const Integer n = Integer::parse(\"" + n.toString() + "\"); return n; }()";
+    }
+
+    if ( dynamic_cast<Double *>(node) ) {
+        std::ostringstream literal;
+        literal << std::setprecision(17) << tok->getFloat();
+        kind = DYN;
+        return "Value::Double(" + literal.str() + ")";
+    }
+
+    if ( dynamic_cast<StringExp *>(node) ) {
+        kind = DYN;
+        return "Value::String(" + quote(tok->getString()) + ")";
+    }
+
+    if ( dynamic_cast<Variable *>(node) )
+        return readVar(tok->getName(), kind);
+
+    kind = kindOf(node);
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+        if ( infix->_right == nullptr )
+            return kind == INT
+                ? "negI(" + intValue(infix->_left.get()) + ")"
+                : "unaryMinus(" + value(infix->_left.get()) + ")";
+
+        std::string op = std::string("'") + tok->symbol() + "'";
+        if ( kind == INT )
+            return "arithI<" + op + ">(Ints{ " + intValue(infix->_left.get()) + ", " + intValue(infix->_right.get()) + " })";
+        return "arith<" + op + ">(Ops{ " + value(infix->_left.get()) + ", " + value(infix->_right.get()) + " })";
+    }
+
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) ) {
+        std::string op = compOpName(tok);
+        if ( kind == BOOL )
+            return "cmpI<" + op + ">(Ints{ " + intValue(comparison->_left.get()) + ", " + intValue(comparison->_right.get()) + " })";
+        return "compare<" + op + ">(Ops{ " + value(comparison->_left.get()) + ", " + value(comparison->_right.get()) + " })";
+    }
+
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) ) {
+        if ( kind == DYN ) {
+            if ( tok->isNot() )
+                return "negate(" + value(boolean->_left.get()) + ")";
+            std::string isAnd = tok->isAnd() ? "true" : "false";
+            return "logic<" + isAnd + ">(" + value(boolean->_left.get()) + ", [&] { return " + value(boolean->_right.get()) + "; })";
+        }
+
+        // andDescriptor / orDescriptor treat an operand as true when it is > 0.
+        Kind lKind, rKind;
+        std::string left = expr(boolean->_left.get(), lKind);
+
+        if ( tok->isNot() )
+            return lKind == BOOL ? "!(" + left + ")" : "((" + left + ") == 0)";
+
+        std::string right = expr(boolean->_right.get(), rKind);
+        if ( lKind == INT ) left = "((" + left + ") > 0)";
+        if ( rKind == INT ) right = "((" + right + ") > 0)";
+
+        // C++'s && and || skip the right side as the interpreter does.
+        return "(" + left + (tok->isAnd() ? " && " : " || ") + right + ")";
+    }
+
+    if ( auto call = dynamic_cast<FunctionCall *>(node) ) {
+        std::string args;
+        for (auto &&arg : *call->_testList)
+            args += (args.empty() ? "" : ", ") + value(arg.get());
+
+        kind = DYN;
+        return "callFn(fn_" + call->_functionName + ", \"" + call->_functionName + "\", "
+               + std::to_string(call->_testList->size()) + ", [&] { return std::vector<Value>{ " + args + " }; })";
+    }
+
+    if ( auto list = dynamic_cast<ListExp *>(node) ) {
+        std::string elements;
+        for (auto &&element : *list->_elements)
+            elements += (elements.empty() ? "" : ", ") + value(element.get());
+        kind = DYN;
+        return "Value::List(std::vector<Value>{ " + elements + " })";
+    }
+
+    if ( auto subscript = dynamic_cast<Subscript *>(node) ) {
+        kind = DYN;
+        return "subscript(" + value(subscript->_sequence.get()) + ", " + value(subscript->_index.get()) + ")";
+    }
+
+    if ( auto len = dynamic_cast<LenExp *>(node) )
+        return "Integer((int64_t) length(" + value(len->_sequence.get()) + "))";
+
+    if ( auto dict = dynamic_cast<DictExp *>(node) ) {
+        std::string items;
+        for (size_t i = 0; i < dict->_keys->size(); i++)
+            items += (items.empty() ? "" : ", ") + value((*dict->_keys)[i].get()) + ", " + value((*dict->_values)[i].get());
+        kind = DYN;
+        return "dictOf(std::vector<Value>{ " + items + " })";
+    }
+
+    if ( auto membership = dynamic_cast<MembershipExprNode *>(node) )
+        return "contains(Ops{ " + value(membership->_left.get()) + ", " + value(membership->_right.get()) + " })";
+
+    std::cout << "Transpiler::expr - Fatal Error - unsupported expression" << std::endl;
+    exit(1);
+}
+
+std::string Transpiler::value(ExprNode *node) {
+    Kind kind;
+    std::string code = expr(node, kind);
+
+    if ( kind == INT )
+        return "Value::Int(" + code + ")";
+    if ( kind == BOOL )
+        return "Value::Bool(" + code + ")";
+    return code;
+}
+
+std::string Transpiler::intValue(ExprNode *node) {
+    Kind kind;
+    std::string code = expr(node, kind);
+
+    if ( kind == INT )
+        return code;
+    return "toInt(" + value(node) + ")";
+}
+
+bool Transpiler::isTyped(std::string name) {
+    return !_inFunction && _intGlobals.count(name) > 0;
+}
+
+std::string Transpiler::var(std::string name) {
+    return (_inFunction ? "l_" : "v_") + name;
+}
+
+std::string Transpiler::readVar(std::string name, Kind &kind) {
+
+    if ( !isTyped(name) ) {
+        kind = DYN;
+        return "get(" + var(name) + ", \"" + name + "\")";
+    }
+
+    kind = INT;
+    for (auto &loopVar : _liveLoopVars)
+        if ( loopVar == name )
+            return "v_" + name;
+    return "getI(d_" + name + ", v_" + name + ", \"" + name + "\")";
+}
+
+std::string Transpiler::quote(std::string str) {
+
+    std::ostringstream quoted;
+    quoted << '"';
+    for (unsigned char c : str) {
+        if ( c == '"' || c == '\\' )
+            quoted << '\\' << c;
+        else if ( c < 0x20 || c >= 0x7F )
+            quoted << '\\' << std::oct << std::setw(3) << std::setfill('0') << (int) c << std::dec;
+        else
+            quoted << c;
+    }
+    quoted << '"';
+    return quoted.str();
+}
+// END "EMISSION"
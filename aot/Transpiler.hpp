@@ -0,0 +1,88 @@
+#ifndef __TRANSPILER_HPP
+#define __TRANSPILER_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class ExprNode;
+class Statement;
+class Statements;
+class FunctionDefinition;
+class RangeStmt;
+
+// The Transpiler turns a parsed program into a standalone C++17 program with
+// the same observable behaviour as the interpreter - output, error messages
+// and exit status. Top level variables that are only ever assigned integers
+// become plain ints; everything else goes through a small generic Value
+// runtime that mirrors DescriptorFunctions.hpp.
+
+class Transpiler {
+
+public:
+    Transpiler();
+
+    std::string translate(Statements &program);
+
+    // Writes <executable>.cpp and builds it with g++ -O2, run directly rather
+    // than through a shell. Returns g++'s exit status.
+    int compile(Statements &program, std::string executable);
+
+private:
+    enum Kind { INT, BOOL, DYN };
+
+    struct Function {
+        FunctionDefinition *def;
+        std::string symbol;
+        // nullptr for a lazy body that doesn't parse - then parseError is
+        // what the parser printed.
+        Statements *body;
+        std::string parseError;
+    };
+
+    // type inference
+    void collectTopLevel(Statements *stmts);
+    void collectNames(Statements *stmts, std::set<std::string> &names);
+    void collectExprNames(ExprNode *expr, std::set<std::string> &names);
+    void inferTypes();
+    bool inferStatements(Statements *stmts);
+    Kind kindOf(ExprNode *expr);
+
+    // emission
+    void parseBody(Function &function);
+    void emitFunction(Function &function);
+    void emitStatements(Statements *stmts, std::string indent);
+    void emitStatement(Statement *stmt, std::string indent);
+    void emitSequenceLoop(RangeStmt *range, std::string indent);
+    std::string expr(ExprNode *expr, Kind &kind);
+    std::string value(ExprNode *expr);
+    std::string intValue(ExprNode *expr);
+
+    bool isTyped(std::string name);
+    std::string var(std::string name);
+    std::string readVar(std::string name, Kind &kind);
+    std::string quote(std::string str);
+
+    std::ostringstream _out;
+    std::vector<Function> _functions;
+    std::vector<std::unique_ptr<Statements>> _lazyBodies;
+    std::map<FunctionDefinition *, std::string> _functionSymbols;
+    std::set<std::string> _functionNames;
+
+    std::set<std::string> _globals;
+    std::set<std::string> _intGlobals;
+    std::map<std::string, std::vector<ExprNode *>> _assignments;
+    std::set<std::string> _loopVars;
+    // Lists and the names that iterate them - never plain ints.
+    std::set<std::string> _untypedGlobals;
+
+    // Loop variables whose loop we are currently inside - always defined.
+    std::vector<std::string> _liveLoopVars;
+    bool _inFunction;
+    int _tmp;
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include <iostream>
+
+#include "Builtins.hpp"
+#include "Kernels.hpp"
+#include "../DescriptorFunctions.hpp"
+#include "../Script.hpp"
+
+namespace Builtins {
+
+static void die(const std::string &scope, const std::string &message) {
+    Script::out() << "Builtins::" << scope << " - Fatal Error - " << message << std::endl;
+    Script::exit(1);
+}
+
+static void expectArguments(Arguments &args, size_t count) {
+    if ( args.size() != count ) {
+        Script::out() << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
+        Script::exit(1);
+    }
+}
+
+static ListDescriptor::Elements &elementsOf(const std::string &scope, TypeDescriptor *t) {
+    if ( t->type() != TypeDescriptor::LIST )
+        die(scope, "argument is not a list");
+    return *Descriptor::List::dieIfNotList(t)->_elements;
+}
+
+static Integer fromInt128(__int128 value) {
+    if ( value >= INT64_MIN && value <= INT64_MAX )
+        return Integer((int64_t) value);
+
+    // high * 2^64 + low, with low split so each half fits an int64.
+    uint64_t low = (uint64_t) value;
+    Integer two32(int64_t(1) << 32);
+    Integer high((int64_t) (value >> 64));
+    return (high * two32 + Integer((int64_t) (low >> 32))) * two32 + Integer((int64_t) (low & 0xFFFFFFFF));
+}
+
+// START "NUMBERS"
+// One element of a boxed list, as Python's arithmetic sees it.
+struct Number {
+    bool isDouble;
+    Integer intValue;
+    double doubleValue;
+
+    double toDouble() const { return isDouble ? doubleValue : intValue.toDouble(); }
+};
+
+static Number numberOf(const std::string &scope, TypeDescriptor *t) {
+    if ( t->type() == TypeDescriptor::INTEGER )
+        return { false, Descriptor::Int::getIntValue(t), 0 };
+    if ( t->type() == TypeDescriptor::BOOL )
+        return { false, Integer((int64_t) Descriptor::Bool::getBoolValue(t)), 0 };
+    if ( t->type() == TypeDescriptor::DOUBLE )
+        return { true, Integer(), Descriptor::Double::getDoubleValue(t) };
+
+    die(scope, "unsupported operand type " + std::to_string(t->type()));
+    return {};
+}
+
+// A running total that stays exact until the first float, as sum() does.
+struct Total {
+    Number value{ false, Integer(), 0 };
+
+    void add(const Number &n) {
+        if ( !value.isDouble && !n.isDouble )
+            value.intValue += n.intValue;
+        else {
+            value.doubleValue = value.toDouble() + n.toDouble();
+            value.isDouble = true;
+        }
+    }
+
+    std::unique_ptr<TypeDescriptor> descriptor() const {
+        if ( value.isDouble )
+            return Descriptor::Double::createDoubleDescriptor(value.doubleValue);
+        return Descriptor::Int::createIntDescriptor(value.intValue);
+    }
+};
+
+static Total boxedSum(const std::string &scope, TypeDescriptor *list) {
+    Total total;
+    for (size_t i = 0; i < Descriptor::List::length(list); i++)
+        total.add(numberOf(scope, Descriptor::List::getItem(list, i).get()));
+    return total;
+}
+
+// <0, 0, >0 like strcmp - ints exactly, strings by bytes, mixed numbers as doubles.
+static int compareElements(const std::string &scope, TypeDescriptor *a, TypeDescriptor *b) {
+    bool aString = a->type() == TypeDescriptor::STRING, bString = b->type() == TypeDescriptor::STRING;
+
+    if ( aString && bString )
+        return Descriptor::String::getStringValue(a).compare(Descriptor::String::getStringValue(b));
+    if ( aString || bString )
+        die(scope, "elements are not comparable");
+
+    Number x = numberOf(scope, a), y = numberOf(scope, b);
+    if ( !x.isDouble && !y.isDouble )
+        return compare(x.intValue, y.intValue);
+    return x.toDouble() < y.toDouble() ? -1 : x.toDouble() > y.toDouble() ? 1 : 0;
+}
+// END "NUMBERS"
+
+// START "BUILTINS"
+static std::unique_ptr<TypeDescriptor> sum(Arguments &args) {
+    expectArguments(args, 1);
+    auto &elements = elementsOf("sum", args[0].get());
+
+    if ( elements.storage == ListDescriptor::INTS )
+        return Descriptor::Int::createIntDescriptor(fromInt128(Kernels::sumInts(elements.ints.data(), elements.ints.size())));
+    if ( elements.storage == ListDescriptor::DOUBLES )
+        return Descriptor::Double::createDoubleDescriptor(Kernels::sumDoubles(elements.doubles.data(), elements.doubles.size()));
+
+    return boxedSum("sum", args[0].get()).descriptor();
+}
+
+template <bool IsMin>
+static std::unique_ptr<TypeDescriptor> extreme(Arguments &args) {
+    std::string scope = IsMin ? "min" : "max";
+
+    if ( args.empty() )
+        expectArguments(args, 1);
+
+    // min(a, b, ...) reduces its arguments.
+    std::shared_ptr<TypeDescriptor> list = args[0];
+    if ( args.size() > 1 ) {
+        list = Descriptor::List::createListDescriptor();
+        for (auto &arg : args)
+            Descriptor::List::append(list.get(), Descriptor::copyReferencePtr(arg.get()));
+    }
+
+    auto &elements = elementsOf(scope, list.get());
+    size_t n = elements.size();
+
+    if ( n == 0 )
+        die(scope, "arg is an empty sequence");
+
+    if ( elements.storage == ListDescriptor::INTS ) {
+        int64_t best = IsMin ? Kernels::minInts(elements.ints.data(), n) : Kernels::maxInts(elements.ints.data(), n);
+        return Descriptor::Int::createIntDescriptor(best);
+    }
+    if ( elements.storage == ListDescriptor::DOUBLES ) {
+        double best = IsMin ? Kernels::minDoubles(elements.doubles.data(), n) : Kernels::maxDoubles(elements.doubles.data(), n);
+        return Descriptor::Double::createDoubleDescriptor(best);
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < n; i++) {
+        int order = compareElements(scope, elements.boxed[i].get(), elements.boxed[best].get());
+        if ( IsMin ? order < 0 : order > 0 )
+            best = i;
+    }
+    return Descriptor::copyReferencePtr(elements.boxed[best].get());
+}
+
+static std::unique_ptr<TypeDescriptor> mean(Arguments &args) {
+    expectArguments(args, 1);
+    auto &elements = elementsOf("mean", args[0].get());
+    size_t n = elements.size();
+
+    if ( n == 0 )
+        die("mean", "mean requires at least one data point");
+
+    double total;
+    if ( elements.storage == ListDescriptor::INTS )
+        total = (double) Kernels::sumInts(elements.ints.data(), n);
+    else if ( elements.storage == ListDescriptor::DOUBLES )
+        total = Kernels::sumDoubles(elements.doubles.data(), n);
+    else
+        total = boxedSum("mean", args[0].get()).value.toDouble();
+
+    return Descriptor::Double::createDoubleDescriptor(total / n);
+}
+
+static std::unique_ptr<TypeDescriptor> dot(Arguments &args) {
+    expectArguments(args, 2);
+    auto &a = elementsOf("dot", args[0].get());
+    auto &b = elementsOf("dot", args[1].get());
+    size_t n = a.size();
+
+    if ( n != b.size() )
+        die("dot", "lists have different lengths");
+
+    if ( a.storage == ListDescriptor::INTS && b.storage == ListDescriptor::INTS ) {
+        __int128 result;
+        if ( Kernels::dotInts(a.ints.data(), b.ints.data(), n, result) )
+            return Descriptor::Int::createIntDescriptor(fromInt128(result));
+    }
+    if ( a.storage == ListDescriptor::DOUBLES && b.storage == ListDescriptor::DOUBLES )
+        return Descriptor::Double::createDoubleDescriptor(Kernels::dotDoubles(a.doubles.data(), b.doubles.data(), n));
+
+    Total total;
+    for (size_t i = 0; i < n; i++) {
+        Number x = numberOf("dot", Descriptor::List::getItem(args[0].get(), i).get());
+        Number y = numberOf("dot", Descriptor::List::getItem(args[1].get(), i).get());
+        if ( !x.isDouble && !y.isDouble )
+            total.add({ false, x.intValue * y.intValue, 0 });
+        else
+            total.add({ true, Integer(), x.toDouble() * y.toDouble() });
+    }
+    return total.descriptor();
+}
+// END "BUILTINS"
+
+Builtin lookup(const std::string &name) {
+    if ( name == "sum" )  return sum;
+    if ( name == "min" )  return extreme<true>;
+    if ( name == "max" )  return extreme<false>;
+    if ( name == "mean" ) return mean;
+    if ( name == "dot" )  return dot;
+    return nullptr;
+}
+
+};
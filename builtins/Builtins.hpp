@@ -0,0 +1,28 @@
+#ifndef __BUILTINS_HPP
+#define __BUILTINS_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Descriptor.hpp"
+
+// Native functions reachable through FunctionCall when no def of the same
+// name is in scope:
+//
+//     sum(list)  min(list)  max(list)  mean(list)  dot(list, list)
+//
+// min and max also take two or more plain arguments. Unboxed int and double
+// lists go straight to the Kernels; boxed lists are reduced element by
+// element with Python's int / float promotion.
+
+namespace Builtins {
+
+    using Arguments = std::vector<std::shared_ptr<TypeDescriptor>>;
+    using Builtin = std::unique_ptr<TypeDescriptor> (*)(Arguments &);
+
+    // nullptr when name is not a builtin.
+    Builtin lookup(const std::string &name);
+};
+
+#endif
@@ -0,0 +1,441 @@
+#include <algorithm>
+
+#include "Kernels.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace Kernels {
+
+// START "SCALAR"
+// The eight partial sums of a double reduction, combined the way the vector
+// versions end up combining their lanes.
+static inline double combineLanes(const double lanes[8]) {
+    return ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+}
+
+static __int128 sumIntsScalar(const int64_t *x, size_t n) {
+    __int128 total = 0;
+    for (size_t i = 0; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+static double sumDoublesScalar(const double *x, size_t n) {
+    double lanes[8] = { 0 };
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int j = 0; j < 8; j++)
+            lanes[j] += x[i + j];
+
+    double total = combineLanes(lanes);
+    for (; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+static int64_t minIntsScalar(const int64_t *x, size_t n) {
+    return *std::min_element(x, x + n);
+}
+
+static int64_t maxIntsScalar(const int64_t *x, size_t n) {
+    return *std::max_element(x, x + n);
+}
+
+static double minDoublesScalar(const double *x, size_t n) {
+    double best = x[0];
+    for (size_t i = 1; i < n; i++)
+        if ( x[i] < best )
+            best = x[i];
+    return best;
+}
+
+static double maxDoublesScalar(const double *x, size_t n) {
+    double best = x[0];
+    for (size_t i = 1; i < n; i++)
+        if ( x[i] > best )
+            best = x[i];
+    return best;
+}
+
+static bool dotIntsScalar(const int64_t *a, const int64_t *b, size_t n, __int128 &result) {
+    __int128 total = 0;
+    for (size_t i = 0; i < n; i++)
+        if ( __builtin_add_overflow(total, (__int128) a[i] * b[i], &total) )
+            return false;
+    result = total;
+    return true;
+}
+
+static double dotDoublesScalar(const double *a, const double *b, size_t n) {
+    double lanes[8] = { 0 };
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int j = 0; j < 8; j++)
+            lanes[j] += a[i + j] * b[i + j];
+
+    double total = combineLanes(lanes);
+    for (; i < n; i++)
+        total += a[i] * b[i];
+    return total;
+}
+// END "SCALAR"
+
+#if defined(__x86_64__)
+
+// Exact integer sums in 64-bit lanes: each element is split into its low 32
+// bits, its high 32 bits (unsigned) and its sign, and the three are summed
+// separately. None of them can carry out of a lane within a chunk.
+static const size_t exactChunk = size_t(1) << 30;
+
+static __int128 assemble(const uint64_t *low, const uint64_t *high, const uint64_t *negative, int lanes) {
+    unsigned __int128 l = 0, h = 0, g = 0;
+    for (int j = 0; j < lanes; j++) {
+        l += low[j];
+        h += high[j];
+        g += negative[j];
+    }
+    return (__int128) (l + (h << 32)) - (__int128) (g << 64);
+}
+
+// START "SSE2"
+static __int128 sumIntsSse2(const int64_t *x, size_t n) {
+    const __m128i lowMask = _mm_set1_epi64x(0xFFFFFFFF);
+    __int128 total = 0;
+    size_t i = 0;
+
+    while ( i + 2 <= n ) {
+        size_t end = i + std::min((n - i) & ~size_t(1), exactChunk);
+        __m128i low = _mm_setzero_si128(), high = low, negative = low;
+
+        for (; i < end; i += 2) {
+            __m128i v = _mm_loadu_si128((const __m128i *) (x + i));
+            low = _mm_add_epi64(low, _mm_and_si128(v, lowMask));
+            high = _mm_add_epi64(high, _mm_srli_epi64(v, 32));
+            negative = _mm_add_epi64(negative, _mm_srli_epi64(v, 63));
+        }
+
+        uint64_t l[2], h[2], g[2];
+        _mm_storeu_si128((__m128i *) l, low);
+        _mm_storeu_si128((__m128i *) h, high);
+        _mm_storeu_si128((__m128i *) g, negative);
+        total += assemble(l, h, g, 2);
+    }
+
+    for (; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+static double sumDoublesSse2(const double *x, size_t n) {
+    __m128d r0 = _mm_setzero_pd(), r1 = r0, r2 = r0, r3 = r0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        r0 = _mm_add_pd(r0, _mm_loadu_pd(x + i));
+        r1 = _mm_add_pd(r1, _mm_loadu_pd(x + i + 2));
+        r2 = _mm_add_pd(r2, _mm_loadu_pd(x + i + 4));
+        r3 = _mm_add_pd(r3, _mm_loadu_pd(x + i + 6));
+    }
+
+    __m128d d = _mm_add_pd(_mm_add_pd(r0, r2), _mm_add_pd(r1, r3));
+    double total = _mm_cvtsd_f64(d) + _mm_cvtsd_f64(_mm_unpackhi_pd(d, d));
+    for (; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+// The vector minimum and maximum don't order NaNs or signed zeros the way
+// Python does, so those lists are rescanned by the scalar loop.
+static double minDoublesSse2(const double *x, size_t n) {
+    if ( n < 2 )
+        return minDoublesScalar(x, n);
+
+    __m128d best = _mm_loadu_pd(x), unordered = _mm_cmpunord_pd(best, best);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(x + i);
+        unordered = _mm_or_pd(unordered, _mm_cmpunord_pd(v, v));
+        best = _mm_min_pd(best, v);
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, best);
+    double result = std::min(lanes[0], lanes[1]);
+    for (; i < n; i++)
+        result = x[i] < result || x[i] != x[i] ? x[i] : result;
+
+    if ( _mm_movemask_pd(unordered) != 0 || result != result || result == 0 )
+        return minDoublesScalar(x, n);
+    return result;
+}
+
+static double maxDoublesSse2(const double *x, size_t n) {
+    if ( n < 2 )
+        return maxDoublesScalar(x, n);
+
+    __m128d best = _mm_loadu_pd(x), unordered = _mm_cmpunord_pd(best, best);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(x + i);
+        unordered = _mm_or_pd(unordered, _mm_cmpunord_pd(v, v));
+        best = _mm_max_pd(best, v);
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, best);
+    double result = std::max(lanes[0], lanes[1]);
+    for (; i < n; i++)
+        result = x[i] > result || x[i] != x[i] ? x[i] : result;
+
+    if ( _mm_movemask_pd(unordered) != 0 || result != result || result == 0 )
+        return maxDoublesScalar(x, n);
+    return result;
+}
+
+static double dotDoublesSse2(const double *a, const double *b, size_t n) {
+    __m128d r0 = _mm_setzero_pd(), r1 = r0, r2 = r0, r3 = r0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        r0 = _mm_add_pd(r0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        r1 = _mm_add_pd(r1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        r2 = _mm_add_pd(r2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        r3 = _mm_add_pd(r3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+
+    __m128d d = _mm_add_pd(_mm_add_pd(r0, r2), _mm_add_pd(r1, r3));
+    double total = _mm_cvtsd_f64(d) + _mm_cvtsd_f64(_mm_unpackhi_pd(d, d));
+    for (; i < n; i++)
+        total += a[i] * b[i];
+    return total;
+}
+// END "SSE2"
+
+// START "AVX2"
+AVX2_TARGET static __int128 sumIntsAvx2(const int64_t *x, size_t n) {
+    const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+    __int128 total = 0;
+    size_t i = 0;
+
+    while ( i + 4 <= n ) {
+        size_t end = i + std::min((n - i) & ~size_t(3), exactChunk);
+        __m256i low = _mm256_setzero_si256(), high = low, negative = low;
+
+        for (; i < end; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *) (x + i));
+            low = _mm256_add_epi64(low, _mm256_and_si256(v, lowMask));
+            high = _mm256_add_epi64(high, _mm256_srli_epi64(v, 32));
+            negative = _mm256_add_epi64(negative, _mm256_srli_epi64(v, 63));
+        }
+
+        uint64_t l[4], h[4], g[4];
+        _mm256_storeu_si256((__m256i *) l, low);
+        _mm256_storeu_si256((__m256i *) h, high);
+        _mm256_storeu_si256((__m256i *) g, negative);
+        total += assemble(l, h, g, 4);
+    }
+
+    for (; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+AVX2_TARGET static double sumDoublesAvx2(const double *x, size_t n) {
+    __m256d a = _mm256_setzero_pd(), b = a;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = _mm256_add_pd(a, _mm256_loadu_pd(x + i));
+        b = _mm256_add_pd(b, _mm256_loadu_pd(x + i + 4));
+    }
+
+    __m256d c = _mm256_add_pd(a, b);
+    __m128d d = _mm_add_pd(_mm256_castpd256_pd128(c), _mm256_extractf128_pd(c, 1));
+    double total = _mm_cvtsd_f64(d) + _mm_cvtsd_f64(_mm_unpackhi_pd(d, d));
+    for (; i < n; i++)
+        total += x[i];
+    return total;
+}
+
+template <bool IsMin>
+AVX2_TARGET static int64_t extremeIntsAvx2(const int64_t *x, size_t n) {
+    if ( n < 4 )
+        return IsMin ? minIntsScalar(x, n) : maxIntsScalar(x, n);
+
+    __m256i best = _mm256_loadu_si256((const __m256i *) x);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (x + i));
+        __m256i replace = IsMin ? _mm256_cmpgt_epi64(best, v) : _mm256_cmpgt_epi64(v, best);
+        best = _mm256_blendv_epi8(best, v, replace);
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, best);
+    int64_t result = IsMin ? minIntsScalar(lanes, 4) : maxIntsScalar(lanes, 4);
+    for (; i < n; i++)
+        result = IsMin ? std::min(result, x[i]) : std::max(result, x[i]);
+    return result;
+}
+
+template <bool IsMin>
+AVX2_TARGET static double extremeDoublesAvx2(const double *x, size_t n) {
+    if ( n < 4 )
+        return IsMin ? minDoublesScalar(x, n) : maxDoublesScalar(x, n);
+
+    __m256d best = _mm256_loadu_pd(x), unordered = _mm256_cmp_pd(best, best, _CMP_UNORD_Q);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        unordered = _mm256_or_pd(unordered, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        best = IsMin ? _mm256_min_pd(best, v) : _mm256_max_pd(best, v);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, best);
+    double result = lanes[0];
+    for (int j = 1; j < 4; j++)
+        result = IsMin ? std::min(result, lanes[j]) : std::max(result, lanes[j]);
+    for (; i < n; i++)
+        result = (IsMin ? x[i] < result : x[i] > result) || x[i] != x[i] ? x[i] : result;
+
+    if ( _mm256_movemask_pd(unordered) != 0 || result != result || result == 0 )
+        return IsMin ? minDoublesScalar(x, n) : maxDoublesScalar(x, n);
+    return result;
+}
+
+// Products of elements that fit in 32 bits are exact in 64 bits and are
+// summed like sumInts. A wider element sends the whole list to the scalar
+// loop, which multiplies in 128 bits.
+AVX2_TARGET static bool dotIntsAvx2(const int64_t *a, const int64_t *b, size_t n, __int128 &result) {
+    const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i bias = _mm256_set1_epi64x(0x80000000);
+    __m256i wide = _mm256_setzero_si256();
+    __int128 total = 0;
+    size_t i = 0;
+
+    while ( i + 4 <= n ) {
+        size_t end = i + std::min((n - i) & ~size_t(3), exactChunk);
+        __m256i low = _mm256_setzero_si256(), high = low, negative = low;
+
+        for (; i < end; i += 4) {
+            __m256i va = _mm256_loadu_si256((const __m256i *) (a + i));
+            __m256i vb = _mm256_loadu_si256((const __m256i *) (b + i));
+            wide = _mm256_or_si256(wide, _mm256_srli_epi64(_mm256_add_epi64(va, bias), 32));
+            wide = _mm256_or_si256(wide, _mm256_srli_epi64(_mm256_add_epi64(vb, bias), 32));
+
+            __m256i p = _mm256_mul_epi32(va, vb);
+            low = _mm256_add_epi64(low, _mm256_and_si256(p, lowMask));
+            high = _mm256_add_epi64(high, _mm256_srli_epi64(p, 32));
+            negative = _mm256_add_epi64(negative, _mm256_srli_epi64(p, 63));
+        }
+
+        uint64_t l[4], h[4], g[4];
+        _mm256_storeu_si256((__m256i *) l, low);
+        _mm256_storeu_si256((__m256i *) h, high);
+        _mm256_storeu_si256((__m256i *) g, negative);
+        total += assemble(l, h, g, 4);
+    }
+
+    if ( !_mm256_testz_si256(wide, wide) )
+        return dotIntsScalar(a, b, n, result);
+
+    for (; i < n; i++)
+        if ( __builtin_add_overflow(total, (__int128) a[i] * b[i], &total) )
+            return false;
+    result = total;
+    return true;
+}
+
+AVX2_TARGET static double dotDoublesAvx2(const double *a, const double *b, size_t n) {
+    __m256d lo = _mm256_setzero_pd(), hi = lo;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        lo = _mm256_add_pd(lo, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        hi = _mm256_add_pd(hi, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+
+    __m256d c = _mm256_add_pd(lo, hi);
+    __m128d d = _mm_add_pd(_mm256_castpd256_pd128(c), _mm256_extractf128_pd(c, 1));
+    double total = _mm_cvtsd_f64(d) + _mm_cvtsd_f64(_mm_unpackhi_pd(d, d));
+    for (; i < n; i++)
+        total += a[i] * b[i];
+    return total;
+}
+// END "AVX2"
+
+#endif
+
+// START "DISPATCH"
+static Level detect() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+#else
+    return SCALAR;
+#endif
+}
+
+static const Level supported = detect();
+static Level current = supported;
+
+Level level() {
+    return current;
+}
+
+void setLevel(Level wanted) {
+    current = std::min(wanted, supported);
+}
+
+const char *levelName(Level which) {
+    static const char *names[] = { "scalar", "sse2", "avx2" };
+    return names[which];
+}
+
+#if defined(__x86_64__)
+#define DISPATCH(scalar, sse2, avx2) \
+    switch ( current ) { \
+        case AVX2: return avx2; \
+        case SSE2: return sse2; \
+        default:   return scalar; \
+    }
+#else
+#define DISPATCH(scalar, sse2, avx2) return scalar;
+#endif
+
+__int128 sumInts(const int64_t *x, size_t n) {
+    DISPATCH(sumIntsScalar(x, n), sumIntsSse2(x, n), sumIntsAvx2(x, n))
+}
+
+double sumDoubles(const double *x, size_t n) {
+    DISPATCH(sumDoublesScalar(x, n), sumDoublesSse2(x, n), sumDoublesAvx2(x, n))
+}
+
+// SSE2 has no 64-bit compare - the integer extremes are scalar below AVX2.
+int64_t minInts(const int64_t *x, size_t n) {
+    DISPATCH(minIntsScalar(x, n), minIntsScalar(x, n), extremeIntsAvx2<true>(x, n))
+}
+
+int64_t maxInts(const int64_t *x, size_t n) {
+    DISPATCH(maxIntsScalar(x, n), maxIntsScalar(x, n), extremeIntsAvx2<false>(x, n))
+}
+
+double minDoubles(const double *x, size_t n) {
+    DISPATCH(minDoublesScalar(x, n), minDoublesSse2(x, n), extremeDoublesAvx2<true>(x, n))
+}
+
+double maxDoubles(const double *x, size_t n) {
+    DISPATCH(maxDoublesScalar(x, n), maxDoublesSse2(x, n), extremeDoublesAvx2<false>(x, n))
+}
+
+// Nor a signed 32 x 32 multiply.
+bool dotInts(const int64_t *a, const int64_t *b, size_t n, __int128 &result) {
+    DISPATCH(dotIntsScalar(a, b, n, result), dotIntsScalar(a, b, n, result), dotIntsAvx2(a, b, n, result))
+}
+
+double dotDoubles(const double *a, const double *b, size_t n) {
+    DISPATCH(dotDoublesScalar(a, b, n), dotDoublesSse2(a, b, n), dotDoublesAvx2(a, b, n))
+}
+// END "DISPATCH"
+
+};
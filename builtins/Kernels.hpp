@@ -0,0 +1,40 @@
+#ifndef __KERNELS_HPP
+#define __KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Reduction kernels over unboxed list storage. Every kernel has a scalar
+// version and, on x86-64, SSE2 and AVX2 versions; the widest one the CPU
+// supports is picked at startup.
+//
+// Integer results are exact and identical at every level. Double sums and
+// dot products keep eight running partial sums (element i goes to sum i % 8)
+// that are combined in one fixed order, so every level rounds the same way -
+// though not necessarily the way a left to right loop would.
+
+namespace Kernels {
+
+    enum Level { SCALAR, SSE2, AVX2 };
+
+    Level level();
+    // Lowers (or restores) the level - never above what the CPU supports.
+    void setLevel(Level);
+    const char *levelName(Level);
+
+    __int128 sumInts(const int64_t *x, size_t n);
+    double sumDoubles(const double *x, size_t n);
+
+    // n must be at least 1. Doubles follow Python: the first of equal
+    // elements wins and a NaN only wins from the front.
+    int64_t minInts(const int64_t *x, size_t n);
+    int64_t maxInts(const int64_t *x, size_t n);
+    double minDoubles(const double *x, size_t n);
+    double maxDoubles(const double *x, size_t n);
+
+    // False when the exact result does not fit in 128 bits.
+    bool dotInts(const int64_t *a, const int64_t *b, size_t n, __int128 &result);
+    double dotDoubles(const double *a, const double *b, size_t n);
+};
+
+#endif
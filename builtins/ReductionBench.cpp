@@ -0,0 +1,83 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Kernels.hpp"
+
+// Reduction kernel benchmark - runs every kernel at each level the CPU
+// supports over the same random lists, reports ns per element and checks
+// that the levels agree bit for bit.
+//
+//     make reducebench.x && ./reducebench.x [elements] [repetitions]
+
+template <typename Kernel>
+static double nsPerElement(Kernel kernel, size_t n, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        kernel();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() * 1e9 / ((double) n * repetitions);
+}
+
+template <typename T>
+static bool sameBits(T a, T b) {
+    return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+int main(int argc, char *argv[]) {
+
+    size_t n = argc > 1 ? atol(argv[1]) : 1 << 20;
+    int repetitions = argc > 2 ? atoi(argv[2]) : 50;
+
+    std::mt19937_64 random(42);
+    std::vector<int64_t> ints(n), otherInts(n);
+    std::vector<double> doubles(n), otherDoubles(n);
+    for (size_t i = 0; i < n; i++) {
+        ints[i] = (int64_t) random();
+        otherInts[i] = (int64_t) (random() % 2000000) - 1000000;
+        doubles[i] = std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+        otherDoubles[i] = std::uniform_real_distribution<double>(-1, 1)(random);
+    }
+    std::vector<int64_t> narrowInts(otherInts.rbegin(), otherInts.rend());
+
+    std::cout << n << " elements x " << repetitions << std::endl;
+
+    Kernels::Level best = Kernels::level();
+    __int128 sumInts = 0, dotInts = 0;
+    double sumDoubles = 0, dotDoubles = 0, minDoubles = 0;
+    int64_t maxInts = 0;
+    bool same = true;
+
+    for (int l = Kernels::SCALAR; l <= best; l++) {
+        Kernels::setLevel((Kernels::Level) l);
+
+        __int128 s, d;
+        double sd, dd, md;
+        int64_t mi;
+        double t[6] = {
+            nsPerElement([&] { s = Kernels::sumInts(ints.data(), n); }, n, repetitions),
+            nsPerElement([&] { sd = Kernels::sumDoubles(doubles.data(), n); }, n, repetitions),
+            nsPerElement([&] { mi = Kernels::maxInts(ints.data(), n); }, n, repetitions),
+            nsPerElement([&] { md = Kernels::minDoubles(doubles.data(), n); }, n, repetitions),
+            nsPerElement([&] { Kernels::dotInts(otherInts.data(), narrowInts.data(), n, d); }, n, repetitions),
+            nsPerElement([&] { dd = Kernels::dotDoubles(doubles.data(), otherDoubles.data(), n); }, n, repetitions),
+        };
+
+        std::cout << Kernels::levelName((Kernels::Level) l) << ": ns/element"
+                  << "  sum ints " << t[0] << "  sum doubles " << t[1]
+                  << "  max ints " << t[2] << "  min doubles " << t[3]
+                  << "  dot ints " << t[4] << "  dot doubles " << t[5] << std::endl;
+
+        if ( l == Kernels::SCALAR ) {
+            sumInts = s; sumDoubles = sd; maxInts = mi; minDoubles = md; dotInts = d; dotDoubles = dd;
+        } else {
+            same = same && s == sumInts && d == dotInts && mi == maxInts && sameBits(sd, sumDoubles)
+                        && sameBits(md, minDoubles) && sameBits(dd, dotDoubles);
+        }
+    }
+
+    std::cout << (same ? "levels agree" : "LEVELS DIFFER") << std::endl;
+    return same ? 0 : 1;
+}
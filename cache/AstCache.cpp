@@ -0,0 +1,578 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "AstCache.hpp"
+#include "../statements/Statement.hpp"
+#include "../Debug.hpp"
+
+// Image layout: magic, format version, source hash, source length, then the
+// program as a pre-order walk of tagged nodes.
+static const char cacheMagic[4] = { 'P', 'Y', 'A', 'C' };
+static const uint32_t cacheVersion = 6;
+static const int maxDepth = 10000;
+
+enum StatementTag { ASSIGN = 1, PRINT, IF, RANGE, FUNC_DEF, RETURN, CALL_STMT, APPEND, SUBSCRIPT_ASSIGN, PRANGE };
+enum ExprTag { NO_EXPR = 0, WHOLE_NUMBER, DOUBLE, STRING, VARIABLE, INFIX, COMPARISON, BOOLEAN, CALL, LIST, SUBSCRIPT, LEN, DICT, MEMBERSHIP };
+
+AstCache::AstCache(std::string directory):
+    _directory{directory},
+    _pos{nullptr},
+    _end{nullptr},
+    _ok{true},
+    _depth{0}
+{}
+
+uint64_t AstCache::hash(const std::string &source) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : source) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string AstCache::pathFor(const std::string &source) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.ast", (unsigned long long) hash(source));
+    return _directory + "/" + name;
+}
+
+std::unique_ptr<Statements> AstCache::load(const std::string &source) {
+
+    std::string path = pathFor(source);
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if ( fd < 0 )
+        return nullptr;
+
+    struct stat st;
+    if ( fstat(fd, &st) != 0 || st.st_size < 24 ) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t size = st.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if ( mapped == MAP_FAILED )
+        return nullptr;
+
+    _pos = static_cast<const char *>(mapped);
+    _end = _pos + size;
+    _ok = true;
+    _depth = 0;
+
+    std::unique_ptr<Statements> stmts;
+
+    uint64_t storedHash, storedLength;
+    bool headerMatches = memcmp(_pos, cacheMagic, 4) == 0;
+    _pos += 4;
+    headerMatches = headerMatches && (uint32_t) readInt() == cacheVersion;
+    memcpy(&storedHash, _pos, 8);
+    memcpy(&storedLength, _pos + 8, 8);
+    _pos += 16;
+
+    // The length check guards against the (unlikely) hash collision.
+    if ( headerMatches && storedHash == hash(source) && storedLength == source.size() ) {
+        stmts = readStatements();
+        if ( !_ok || _pos != _end )
+            stmts = nullptr;
+    }
+
+    munmap(mapped, size);
+    _pos = _end = nullptr;
+
+    if (debug)
+        std::cout << "AstCache::load - " << path << (stmts ? " hit" : " unusable") << std::endl;
+
+    return stmts;
+}
+
+void AstCache::store(const std::string &source, Statements &stmts) {
+
+    uint64_t sourceHash = hash(source);
+    uint64_t sourceLength = source.size();
+
+    _buffer.clear();
+    _buffer.append(cacheMagic, 4);
+    writeInt(cacheVersion);
+    _buffer.append(reinterpret_cast<const char *>(&sourceHash), 8);
+    _buffer.append(reinterpret_cast<const char *>(&sourceLength), 8);
+    writeStatements(&stmts);
+
+    mkdir(_directory.c_str(), 0755);
+
+    // Write to a private name and rename so concurrent runs never see half an image.
+    std::string path = pathFor(source);
+    std::string tmpPath = path + ".tmp." + std::to_string(getpid());
+
+    std::ofstream out(tmpPath, std::ios::binary);
+    if ( !out.is_open() ) {
+        if (debug)
+            std::cout << "AstCache::store - unable to open " << tmpPath << std::endl;
+        return;
+    }
+    out.write(_buffer.data(), _buffer.size());
+    out.close();
+
+    if ( !out || rename(tmpPath.c_str(), path.c_str()) != 0 )
+        unlink(tmpPath.c_str());
+
+    _buffer.clear();
+}
+
+// START "WRITER"
+void AstCache::writeStatements(Statements *stmts) {
+    writeInt(stmts->_statements.size());
+    for (auto &&stmt : stmts->_statements)
+        writeStatement(stmt.get());
+}
+
+void AstCache::writeStatement(Statement *stmt) {
+
+    if ( auto assign = dynamic_cast<AssignStmt *>(stmt) ) {
+        writeByte(ASSIGN);
+        writeString(assign->_lhsVariable);
+        writeExpr(assign->_rhsExpression.get());
+
+    } else if ( auto print = dynamic_cast<PrintStatement *>(stmt) ) {
+        writeByte(PRINT);
+        writeExprList(print->_testList.get());
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        writeByte(IF);
+        writeExpr(ifStatement->_if->_if.first.get());
+        writeStatements(ifStatement->_if->_if.second.get());
+
+        if ( ifStatement->_elif == nullptr ) {
+            writeInt(0);
+        } else {
+            writeInt(ifStatement->_elif->_elif.size());
+            for (auto &&elif : ifStatement->_elif->_elif) {
+                writeExpr(elif.first.get());
+                writeStatements(elif.second.get());
+            }
+        }
+
+        writeByte(ifStatement->_else != nullptr);
+        if ( ifStatement->_else != nullptr )
+            writeStatements(ifStatement->_else->_stmts.get());
+
+    } else if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        writeByte(range->_parallel != nullptr ? PRANGE : RANGE);
+        writeString(range->_id);
+        writeExpr(range->_iterable.get());
+        if ( range->_iterable == nullptr )
+            writeExprList(range->_testList.get());
+        writeStatements(range->_forBody.get());
+
+    } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt) ) {
+        writeByte(FUNC_DEF);
+        writeString(funcDef->_funcName);
+        writeInt(funcDef->_paramList.size());
+        for (auto &param : funcDef->_paramList)
+            writeString(param);
+        // --cache refuses --lazy, so the body is always parsed here.
+        writeStatements(funcDef->suite());
+
+    } else if ( auto ret = dynamic_cast<ReturnStatement *>(stmt) ) {
+        writeByte(RETURN);
+        writeExpr(ret->_returnExpr.get());
+
+    } else if ( auto call = dynamic_cast<FunctionCallStatement *>(stmt) ) {
+        writeByte(CALL_STMT);
+        writeExpr(call->_exprNodeCall.get());
+
+    } else if ( auto append = dynamic_cast<AppendStatement *>(stmt) ) {
+        writeByte(APPEND);
+        writeString(append->_listName);
+        writeExpr(append->_value.get());
+
+    } else if ( auto subscriptAssign = dynamic_cast<SubscriptAssignStmt *>(stmt) ) {
+        writeByte(SUBSCRIPT_ASSIGN);
+        writeString(subscriptAssign->_listName);
+        writeExpr(subscriptAssign->_index.get());
+        writeExpr(subscriptAssign->_rhsExpression.get());
+
+    } else {
+        std::cout << "AstCache::writeStatement - Fatal Error - unknown statement" << std::endl;
+        exit(1);
+    }
+}
+
+void AstCache::writeExpr(ExprNode *expr) {
+
+    if ( expr == nullptr ) {
+        writeByte(NO_EXPR);
+        return;
+    }
+
+    auto tok = expr->token();
+
+    if ( dynamic_cast<WholeNumber *>(expr) ) {
+        writeByte(WHOLE_NUMBER);
+        writeString(tok->getWholeNumber().toString());
+    } else if ( dynamic_cast<Double *>(expr) ) {
+        double f = tok->getFloat();
+        writeByte(DOUBLE);
+        _buffer.append(reinterpret_cast<const char *>(&f), sizeof(f));
+    } else if ( dynamic_cast<StringExp *>(expr) ) {
+        writeByte(STRING);
+        writeString(tok->getString());
+    } else if ( dynamic_cast<Variable *>(expr) ) {
+        writeByte(VARIABLE);
+        writeString(tok->getName());
+    } else if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        writeByte(INFIX);
+        writeByte(tok->symbol());
+        writeExpr(infix->_left.get());
+        writeExpr(infix->_right.get());
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        writeByte(COMPARISON);
+        writeString(tok->getRelOp());
+        writeExpr(comparison->_left.get());
+        writeExpr(comparison->_right.get());
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        writeByte(BOOLEAN);
+        writeByte(tok->isNot() ? 'n' : tok->isAnd() ? 'a' : 'o');
+        writeExpr(boolean->_left.get());
+        writeExpr(boolean->_right.get());
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr) ) {
+        writeByte(CALL);
+        writeString(call->_functionName);
+        writeExprList(call->_testList.get());
+    } else if ( auto list = dynamic_cast<ListExp *>(expr) ) {
+        writeByte(LIST);
+        writeExprList(list->_elements.get());
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr) ) {
+        writeByte(SUBSCRIPT);
+        writeExpr(subscript->_sequence.get());
+        writeExpr(subscript->_index.get());
+    } else if ( auto len = dynamic_cast<LenExp *>(expr) ) {
+        writeByte(LEN);
+        writeExpr(len->_sequence.get());
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr) ) {
+        writeByte(DICT);
+        writeExprList(dict->_keys.get());
+        writeExprList(dict->_values.get());
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr) ) {
+        writeByte(MEMBERSHIP);
+        writeExpr(membership->_left.get());
+        writeExpr(membership->_right.get());
+    } else {
+        std::cout << "AstCache::writeExpr - Fatal Error - unknown expression" << std::endl;
+        exit(1);
+    }
+}
+
+void AstCache::writeExprList(std::vector<std::unique_ptr<ExprNode>> *exprs) {
+    writeInt(exprs->size());
+    for (auto &&expr : *exprs)
+        writeExpr(expr.get());
+}
+
+void AstCache::writeByte(uint8_t b) {
+    _buffer.push_back((char) b);
+}
+
+void AstCache::writeInt(int32_t v) {
+    _buffer.append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+void AstCache::writeString(const std::string &str) {
+    writeInt(str.size());
+    _buffer.append(str);
+}
+// END "WRITER"
+
+
+// START "READER"
+std::unique_ptr<Statements> AstCache::readStatements() {
+
+    auto stmts = std::make_unique<Statements>();
+    int32_t count = readInt();
+
+    if ( ++_depth > maxDepth || count < 0 )
+        _ok = false;
+
+    for (int32_t i = 0; _ok && i < count; i++)
+        stmts->addStatement(readStatement());
+
+    _depth--;
+    return stmts;
+}
+
+std::unique_ptr<Statement> AstCache::readStatement() {
+
+    uint8_t tag = readByte();
+    switch ( tag ) {
+
+        case ASSIGN: {
+            std::string name = readString();
+            return std::make_unique<AssignStmt>(name, readExpr());
+        }
+
+        case PRINT:
+            return std::make_unique<PrintStatement>(readExprList());
+
+        case IF: {
+            auto ifStatement = std::make_unique<IfStatement>();
+            auto cond = readExpr();
+            ifStatement->addIfStmt(std::make_unique<IfStmt>(std::move(cond), readStatements()));
+
+            int32_t elifCount = readInt();
+            if ( elifCount > 0 ) {
+                auto elifStmt = std::make_unique<ElifStmt>();
+                for (int32_t i = 0; _ok && i < elifCount; i++) {
+                    auto elifCond = readExpr();
+                    elifStmt->addStatement(std::move(elifCond), readStatements());
+                }
+                ifStatement->addElifStmt(std::move(elifStmt));
+            }
+
+            if ( readByte() )
+                ifStatement->addElseStmt(std::make_unique<ElseStmt>(readStatements()));
+            return ifStatement;
+        }
+
+        case RANGE:
+        case PRANGE: {
+            auto range = std::make_unique<RangeStmt>(readString());
+            auto iterable = readExpr();
+            if ( iterable != nullptr )
+                range->addIterable(std::move(iterable));
+            else
+                range->addTestList(readExprList());
+            range->addStatements(readStatements());
+            if ( tag == PRANGE && _ok )
+                range->makeParallel();
+            return range;
+        }
+
+        case FUNC_DEF: {
+            std::string name = readString();
+            std::vector<std::string> params;
+            int32_t paramCount = readInt();
+            for (int32_t i = 0; _ok && i < paramCount; i++)
+                params.push_back(readString());
+            return std::make_unique<FunctionDefinition>(name, params, readStatements(), false);
+        }
+
+        case RETURN:
+            return std::make_unique<ReturnStatement>(readExpr());
+
+        case CALL_STMT:
+            return std::make_unique<FunctionCallStatement>(readExpr());
+
+        case APPEND: {
+            std::string name = readString();
+            auto value = readExpr();
+            if ( value == nullptr )
+                _ok = false;
+            return std::make_unique<AppendStatement>(name, std::move(value));
+        }
+
+        case SUBSCRIPT_ASSIGN: {
+            std::string name = readString();
+            auto index = readExpr();
+            auto rhs = readExpr();
+            if ( index == nullptr || rhs == nullptr )
+                _ok = false;
+            return std::make_unique<SubscriptAssignStmt>(name, std::move(index), std::move(rhs));
+        }
+    }
+
+    _ok = false;
+    return nullptr;
+}
+
+std::unique_ptr<ExprNode> AstCache::readExpr() {
+
+    uint8_t tag = readByte();
+    if ( !_ok || tag == NO_EXPR )
+        return nullptr;
+
+    if ( ++_depth > maxDepth ) {
+        _ok = false;
+        return nullptr;
+    }
+
+    auto tok = std::make_shared<Token>();
+    std::unique_ptr<ExprNode> expr;
+
+    switch ( tag ) {
+
+        case WHOLE_NUMBER:
+            tok->setWholeNumber(Integer::parse(readString()));
+            expr = std::make_unique<WholeNumber>(tok);
+            break;
+
+        case DOUBLE: {
+            double f = 0;
+            if ( _end - _pos < (long) sizeof(f) ) {
+                _ok = false;
+                break;
+            }
+            memcpy(&f, _pos, sizeof(f));
+            _pos += sizeof(f);
+            tok->setFloat(f);
+            expr = std::make_unique<Double>(tok);
+            break;
+        }
+
+        case STRING:
+            tok->setString(readString());
+            expr = std::make_unique<StringExp>(tok);
+            break;
+
+        case VARIABLE:
+            tok->setName(readString());
+            expr = std::make_unique<Variable>(tok);
+            break;
+
+        case INFIX: {
+            tok->symbol(readByte());
+            auto infix = std::make_unique<InfixExprNode>(tok);
+            infix->_left = readExpr();
+            infix->_right = readExpr();
+            if ( infix->_left == nullptr )
+                _ok = false;
+            expr = std::move(infix);
+            break;
+        }
+
+        case COMPARISON: {
+            tok->relExp(readString());
+            auto comparison = std::make_unique<ComparisonExprNode>(tok);
+            comparison->_left = readExpr();
+            comparison->_right = readExpr();
+            if ( comparison->_left == nullptr || comparison->_right == nullptr )
+                _ok = false;
+            expr = std::move(comparison);
+            break;
+        }
+
+        case BOOLEAN: {
+            uint8_t op = readByte();
+            tok->setKeyword(op == 'n' ? "not" : op == 'a' ? "and" : "or");
+            auto boolean = std::make_unique<BooleanExprNode>(tok);
+            boolean->_left = readExpr();
+            boolean->_right = readExpr();
+            if ( boolean->_left == nullptr )
+                _ok = false;
+            expr = std::move(boolean);
+            break;
+        }
+
+        case CALL: {
+            tok->setName(readString());
+            auto args = readExprList();
+            expr = std::make_unique<FunctionCall>(tok, std::move(args));
+            break;
+        }
+
+        case LIST:
+            tok->symbol('[');
+            expr = std::make_unique<ListExp>(tok, readExprList());
+            break;
+
+        case SUBSCRIPT: {
+            tok->symbol('[');
+            auto sequence = readExpr();
+            auto index = readExpr();
+            if ( sequence == nullptr || index == nullptr )
+                _ok = false;
+            expr = std::make_unique<Subscript>(tok, std::move(sequence), std::move(index));
+            break;
+        }
+
+        case LEN: {
+            tok->setKeyword(KW_LEN);
+            auto sequence = readExpr();
+            if ( sequence == nullptr )
+                _ok = false;
+            expr = std::make_unique<LenExp>(tok, std::move(sequence));
+            break;
+        }
+
+        case DICT: {
+            tok->symbol('{');
+            auto keys = readExprList();
+            auto values = readExprList();
+            if ( keys->size() != values->size() )
+                _ok = false;
+            expr = std::make_unique<DictExp>(tok, std::move(keys), std::move(values));
+            break;
+        }
+
+        case MEMBERSHIP: {
+            tok->setKeyword(KW_IN);
+            auto membership = std::make_unique<MembershipExprNode>(tok);
+            membership->_left = readExpr();
+            membership->_right = readExpr();
+            if ( membership->_left == nullptr || membership->_right == nullptr )
+                _ok = false;
+            expr = std::move(membership);
+            break;
+        }
+
+        default:
+            _ok = false;
+    }
+
+    _depth--;
+    return expr;
+}
+
+std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> AstCache::readExprList() {
+
+    auto exprs = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+    int32_t count = readInt();
+
+    if ( count < 0 )
+        _ok = false;
+
+    for (int32_t i = 0; _ok && i < count; i++) {
+        exprs->push_back(readExpr());
+        if ( exprs->back() == nullptr )
+            _ok = false;
+    }
+
+    return exprs;
+}
+
+uint8_t AstCache::readByte() {
+    if ( _pos >= _end ) {
+        _ok = false;
+        return 0;
+    }
+    return (uint8_t) *_pos++;
+}
+
+int32_t AstCache::readInt() {
+    int32_t v = 0;
+    if ( _end - _pos < (long) sizeof(v) ) {
+        _ok = false;
+        return 0;
+    }
+    memcpy(&v, _pos, sizeof(v));
+    _pos += sizeof(v);
+    return v;
+}
+
+std::string AstCache::readString() {
+    int32_t length = readInt();
+    if ( length < 0 || _end - _pos < length ) {
+        _ok = false;
+        return "";
+    }
+    std::string str(_pos, length);
+    _pos += length;
+    return str;
+}
+// END "READER"
@@ -0,0 +1,59 @@
+#ifndef __AST_CACHE_HPP
+#define __AST_CACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ExprNode;
+class Statement;
+class Statements;
+
+// The AstCache keeps a compact binary image of parsed programs in a cache
+// directory, one file per distinct source text named after its FNV-1a hash.
+// A warm start maps the image and rebuilds the Statements tree straight from
+// the mapping, skipping the Lexer and Parser entirely.
+
+class AstCache {
+
+public:
+    AstCache(std::string directory);
+
+    // Returns nullptr when there is no usable image for this source.
+    std::unique_ptr<Statements> load(const std::string &source);
+    void store(const std::string &source, Statements &stmts);
+
+    static uint64_t hash(const std::string &source);
+
+private:
+    std::string pathFor(const std::string &source);
+
+    // writer
+    void writeStatements(Statements *stmts);
+    void writeStatement(Statement *stmt);
+    void writeExpr(ExprNode *expr);
+    void writeExprList(std::vector<std::unique_ptr<ExprNode>> *exprs);
+    void writeByte(uint8_t b);
+    void writeInt(int32_t v);
+    void writeString(const std::string &str);
+
+    // reader - every read checks bounds and clears _ok on malformed input
+    std::unique_ptr<Statements> readStatements();
+    std::unique_ptr<Statement> readStatement();
+    std::unique_ptr<ExprNode> readExpr();
+    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> readExprList();
+    uint8_t readByte();
+    int32_t readInt();
+    std::string readString();
+
+    std::string _directory;
+
+    std::string _buffer;
+    const char *_pos;
+    const char *_end;
+    bool _ok;
+    int _depth;
+};
+
+#endif
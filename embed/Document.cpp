@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+
+#include "Document.hpp"
+#include "../Debug.hpp"
+
+namespace Interp {
+
+static size_t countLines(const std::string &text) {
+    size_t lines = std::count(text.begin(), text.end(), '\n');
+    return lines + ( !text.empty() && text.back() != '\n' );
+}
+
+// Where line `line` of `text` starts - the end once the text runs out.
+static size_t lineStart(const std::string &text, size_t line) {
+    size_t at = 0;
+    for (; line > 0 && at < text.size(); line--) {
+        size_t newline = text.find('\n', at);
+        at = newline == std::string::npos ? text.size() : newline + 1;
+    }
+    return at;
+}
+
+// A line that starts a top-level statement other than an if's continuation.
+static bool startsBlock(const std::string &text, size_t at) {
+
+    unsigned char c = text[at];
+    if ( isspace(c) || c == '#' )
+        return false;
+
+    size_t end = at;
+    while ( end < text.size() && (isalnum((unsigned char) text[end]) || text[end] == '_') )
+        end++;
+
+    std::string word = text.substr(at, end - at);
+    return word != "elif" && word != "else";
+}
+
+Document::Document(const std::string &source, bool lazyFunctions):
+    _lazyFunctions{lazyFunctions},
+    _reparsed{0}
+{
+    bool inString;
+    for (auto &piece : split(source, inString))
+        _blocks.push_back(parse(std::move(piece)));
+
+    _reparsed = _blocks.size();
+    findErrors();
+}
+
+// Cuts at block starts - quotes and comments are followed the way the Lexer
+// reads them, as ParallelLexer::splitPoints does. `inString` tells whether
+// the text ends inside a string literal.
+std::vector<std::string> Document::split(const std::string &text, bool &inString) {
+
+    std::vector<std::string> pieces;
+    size_t start = 0;
+
+    char quote = '\0';
+    bool comment = false;
+
+    for (size_t i = 0; i < text.size(); i++) {
+        if ( i > start && text[i - 1] == '\n' && quote == '\0' && startsBlock(text, i) ) {
+            pieces.push_back(text.substr(start, i - start));
+            start = i;
+        }
+
+        char c = text[i];
+        if ( quote != '\0' ) {
+            if ( c == quote )
+                quote = '\0';
+        } else if ( comment ) {
+            comment = c != '\n';
+        } else if ( c == '#' ) {
+            comment = true;
+        } else if ( c == '"' || c == '\'' ) {
+            quote = c;
+        }
+    }
+
+    if ( start < text.size() )
+        pieces.push_back(text.substr(start));
+
+    inString = quote != '\0';
+    return pieces;
+}
+
+Document::Block Document::parse(std::string text) {
+
+    std::ostringstream errors;
+
+    Block block;
+    block.lines = countLines(text);
+    block.program = Program::compile(text, errors, _lazyFunctions);
+    block.text = std::move(text);
+    return block;
+}
+
+// Parse errors list every token from the start of the file, so while a
+// block doesn't parse the message comes from compiling the whole source.
+void Document::findErrors() {
+
+    _errors.clear();
+
+    bool broken = std::any_of(_blocks.begin(), _blocks.end(), [] (const Block &block) { return block.program == nullptr; });
+    if ( !broken )
+        return;
+
+    std::ostringstream errors;
+    Program::compile(source(), errors, _lazyFunctions);
+    _errors = errors.str();
+}
+
+void Document::edit(size_t first, size_t count, const std::string &lines) {
+
+    first = std::min(first, lineCount());
+    size_t last = std::min(first + count, lineCount());
+
+    // The block holding `first` - or the one before, when `first` starts a
+    // block, since the edit may turn that line into a continuation.
+    size_t begin = 0, line = 0;
+    while ( begin + 1 < _blocks.size() && line + _blocks[begin].lines <= first )
+        line += _blocks[begin++].lines;
+    if ( begin > 0 && line == first )
+        line -= _blocks[--begin].lines;
+
+    size_t end = begin, endLine = line;
+    while ( end < _blocks.size() && (end == begin || endLine < last) )
+        endLine += _blocks[end++].lines;
+
+    std::string region;
+    for (size_t b = begin; b < end; b++)
+        region += _blocks[b].text;
+
+    size_t from = lineStart(region, first - line);
+    region.replace(from, lineStart(region, last - line) - from, lines);
+
+    // Take in following blocks until the region ends where one used to
+    // start - at a line end outside any string.
+    std::vector<std::string> pieces;
+    for (;;) {
+        bool inString;
+        pieces = split(region, inString);
+
+        bool lineEnded = region.empty() || region.back() == '\n';
+        if ( end == _blocks.size() || (lineEnded && !inString) )
+            break;
+        region += _blocks[end++].text;
+    }
+
+    if (debug)
+        std::cout << "Document::edit - blocks " << begin << ".." << end << " become " << pieces.size() << std::endl;
+
+    std::vector<Block> parsed;
+    for (auto &piece : pieces)
+        parsed.push_back(parse(std::move(piece)));
+
+    _blocks.erase(_blocks.begin() + begin, _blocks.begin() + end);
+    _blocks.insert(_blocks.begin() + begin, std::make_move_iterator(parsed.begin()), std::make_move_iterator(parsed.end()));
+
+    _reparsed = parsed.size();
+    findErrors();
+}
+
+std::string Document::source() const {
+    std::string source;
+    for (auto &block : _blocks)
+        source += block.text;
+    return source;
+}
+
+size_t Document::lineCount() const {
+    size_t lines = 0;
+    for (auto &block : _blocks)
+        lines += block.lines;
+    return lines;
+}
+
+const std::string &Document::errors() const {
+    return _errors;
+}
+
+int Document::run(std::ostream &out) const {
+    Globals globals;
+    return run(globals, out);
+}
+
+int Document::run(Globals &globals, std::ostream &out) const {
+
+    if ( !_errors.empty() ) {
+        out << _errors;
+        out.flush();
+        return 1;
+    }
+
+    for (auto &block : _blocks)
+        if ( int status = block.program->run(globals, out) )
+            return status;
+
+    return 0;
+}
+
+size_t Document::reparsed() const {
+    return _reparsed;
+}
+
+};
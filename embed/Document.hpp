@@ -0,0 +1,69 @@
+#ifndef __DOCUMENT_HPP
+#define __DOCUMENT_HPP
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Interp.hpp"
+
+// A script kept parsed while it is edited - for a REPL or an editor.
+//
+//     Interp::Document document(source);
+//     document.edit(3, 1, "    total = total + 2\n");
+//     int status = document.run(std::cout);
+//
+// The source is held as top-level blocks, each starting at a line that
+// begins a top-level statement: column 0, outside any string literal, and
+// not an `elif` / `else`. The indentation stack is back to its base there,
+// so every block lexes and parses on its own exactly as it would within
+// the whole file. An edit re-lexes and re-parses just the blocks around the
+// changed lines, out to the first unchanged block boundary.
+
+namespace Interp {
+
+    class Document {
+    public:
+        Document(const std::string &source, bool lazyFunctions = false);
+
+        // Replaces `count` lines from line `first` (0-based) with `lines` -
+        // whole lines, each ending in a newline. first == lineCount() appends.
+        void edit(size_t first, size_t count, const std::string &lines);
+
+        std::string source() const;
+        size_t lineCount() const;
+
+        // Empty while the whole source parses, otherwise what
+        // Program::compile() would report for it.
+        const std::string &errors() const;
+
+        // Like Program::run. While there are errors nothing runs - they are
+        // printed and 1 returned, as statement.x would.
+        int run(std::ostream &out) const;
+        int run(Globals &globals, std::ostream &out) const;
+
+        // Blocks the constructor or the last edit parsed.
+        size_t reparsed() const;
+
+    private:
+        struct Block {
+            std::string text;
+            size_t lines;
+            std::shared_ptr<const Program> program;  // nullptr if it doesn't parse
+        };
+
+        static std::vector<std::string> split(const std::string &text, bool &inString);
+
+        Block parse(std::string text);
+        void findErrors();
+
+        bool _lazyFunctions;
+        std::vector<Block> _blocks;
+        std::string _errors;
+        size_t _reparsed;
+    };
+
+};
+
+#endif
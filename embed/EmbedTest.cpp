@@ -0,0 +1,168 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Interp.hpp"
+#include "Document.hpp"
+#include "../parallel/WorkPool.hpp"
+
+// Checks the embedding API - one compiled Program run many ways, and a
+// Document kept parsed through edits.
+//
+//     make embedtest.x && ./embedtest.x
+
+static int failures = 0;
+
+static void expect(bool ok, const std::string &what) {
+    std::cout << (ok ? "passes: " : "FAILED: ") << what << std::endl;
+    failures += !ok;
+}
+
+// Whether the document reports and prints what compiling its source afresh does.
+static bool matchesCompile(const Interp::Document &document) {
+
+    std::ostringstream errors, expected, got;
+    auto program = Interp::Program::compile(document.source(), errors);
+    if ( program == nullptr )
+        return document.errors() == errors.str() && document.run(got) == 1;
+
+    int status = program->run(expected);
+    return document.errors().empty() && document.run(got) == status && got.str() == expected.str();
+}
+
+int main() {
+
+    // prange runs on more than the calling thread.
+    WorkPool::setThreads(4);
+
+    std::ostringstream errors;
+    auto program = Interp::Program::compile(
+        "def twice(n):\n"
+        "    return n * 2\n"
+        "total = 0\n"
+        "for i in range(5):\n"
+        "    total = total + twice(i)\n"
+        "print 'total', total\n", errors);
+
+    expect(program != nullptr && errors.str().empty(), "compiles");
+
+    std::ostringstream first, second;
+    int status = program->run(first) + program->run(second);
+    expect(status == 0 && first.str() == "total 20 \n" && first.str() == second.str(), "runs twice with fresh globals");
+
+    auto scaled = Interp::Program::compile("y = x * scale\nprint name, y\n", errors);
+    Interp::Globals globals;
+    globals.setInt("x", 21);
+    globals.setInt("scale", 2);
+    globals.setString("name", "answer");
+    std::ostringstream out;
+    status = scaled->run(globals, out);
+    expect(status == 0 && out.str() == "answer 42 \n" && globals.toString("y") == "42", "runs with caller globals");
+
+    globals.setInt("scale", 3);
+    out.str("");
+    scaled->run(globals, out);
+    expect(out.str() == "answer 63 \n", "runs again with changed globals");
+
+    globals.setDouble("x", 20.25);
+    globals.setDouble("scale", 0.5);
+    auto summed = Interp::Program::compile("y = x + scale\n", errors);
+    summed->run(globals, out);
+    expect(globals.toString("y") == "20.75", "leaves its variables in the globals");
+
+    auto failing = Interp::Program::compile("print 1\nprint missing\nprint 2\n", errors);
+    out.str("");
+    status = failing->run(out);
+    expect(status == 1 && out.str().find("Use of undefined variable, missing") != std::string::npos
+                        && out.str().find("2 \n") == std::string::npos, "a fatal error ends only the run");
+
+    auto prange = Interp::Program::compile(
+        "z = 0\n"
+        "for i in prange(0, 10):\n"
+        "    print i\n"
+        "    if i == 6:\n"
+        "        print 1 / z\n"
+        "print 'after'\n", errors);
+    std::string serial = "0 \n1 \n2 \n3 \n4 \n5 \n6 \nWarning: Division by zero is undefined\n";
+    bool contained = true;
+    for (int i = 0; i < 20; i++) {
+        out.str("");
+        contained = contained && prange->run(out) == 1 && out.str() == serial;
+    }
+    out.str("");
+    auto summing = Interp::Program::compile("total = 0\nfor i in prange(0, 100):\n    total = total + i\nprint total\n", errors);
+    contained = contained && summing->run(out) == 0 && out.str() == "4950 \n";
+    expect(contained, "a fatal error in a prange body ends only the run");
+
+    std::ostringstream parseErrors;
+    auto broken = Interp::Program::compile("for i in range(3)\n    print i\n", parseErrors);
+    expect(broken == nullptr && !parseErrors.str().empty(), "a parse error returns no program");
+
+    std::vector<std::string> outputs(4);
+    std::vector<std::thread> threads;
+    for (auto &output : outputs)
+        threads.emplace_back([&] {
+            std::ostringstream s;
+            for (int i = 0; i < 50; i++)
+                program->run(s);
+            output = s.str();
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    bool same = true;
+    for (auto &output : outputs)
+        same = same && output == outputs[0] && output.size() == 50 * first.str().size();
+    expect(same, "runs on several threads at once");
+
+    const std::string script =
+        "def scale(n):\n"
+        "    return n * 3\n"
+        "total = 0\n"
+        "for i in range(4):\n"
+        "    if i == 1:\n"
+        "        total = total + 10\n"
+        "    elif i == 2:\n"
+        "        total = total + scale(i)\n"
+        "    else:\n"
+        "        total = total + 1\n"
+        "text = 'two\n"
+        "lines'\n"
+        "print 'total', total\n"
+        "print text\n"
+        "# a comment\n"
+        "values = [1, 2, 3]\n"
+        "print len(values)\n";
+
+    Interp::Document document(script);
+    expect(document.errors().empty() && document.reparsed() == 8 && matchesCompile(document), "a document runs like its compiled source");
+
+    document.edit(5, 1, "        total = total + 20\n");
+    expect(document.reparsed() == 1 && matchesCompile(document), "an edit in a loop body reparses only the loop");
+
+    // Dropping each line in turn breaks indentation, ifs and the two-line string.
+    bool matches = true;
+    for (size_t line = 0; line < document.lineCount(); line++) {
+        std::string source = document.source();
+        size_t from = 0;
+        for (size_t l = 0; l < line; l++)
+            from = source.find('\n', from) + 1;
+        std::string removed = source.substr(from, source.find('\n', from) + 1 - from);
+
+        document.edit(line, 1, "");
+        matches = matches && matchesCompile(document);
+        document.edit(line, 0, removed);
+        matches = matches && matchesCompile(document) && document.source() == source;
+    }
+    expect(matches, "matches a fresh compile after every edit");
+
+    std::string large;
+    for (int i = 0; i < 2000; i++)
+        large += "x" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+    Interp::Document long_(large);
+    long_.edit(1000, 1, "x1000 = 'changed'\n");
+    expect(long_.reparsed() == 2 && long_.lineCount() == 2000 && matchesCompile(long_), "an edit to a large document reparses around it");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <fstream>
+#include <sstream>
+
+#include "Interp.hpp"
+#include "../Parser.hpp"
+#include "../Script.hpp"
+#include "../SymTab.hpp"
+#include "../lex/Lexer.hpp"
+#include "../statements/Statement.hpp"
+
+namespace Interp {
+
+// START "GLOBALS"
+Globals::Globals():
+    _symTab{std::make_unique<SymTab>()}
+{}
+
+Globals::~Globals() = default;
+
+void Globals::setInt(const std::string &name, int64_t value) {
+    _symTab->setValueFor(name, Descriptor::Int::createIntDescriptor(Integer(value)));
+}
+
+void Globals::setDouble(const std::string &name, double value) {
+    _symTab->setValueFor(name, Descriptor::Double::createDoubleDescriptor(value));
+}
+
+void Globals::setString(const std::string &name, const std::string &value) {
+    _symTab->setValueFor(name, Descriptor::String::createStringDescriptor(value));
+}
+
+bool Globals::isDefined(const std::string &name) {
+    return _symTab->isDefined(name);
+}
+
+std::string Globals::toString(const std::string &name) {
+    std::ostringstream value;
+    if ( _symTab->isDefined(name) )
+        Descriptor::printValue(_symTab->getValueFor(name), value);
+    return value.str();
+}
+// END "GLOBALS"
+
+// START "PROGRAM"
+Program::Program(std::unique_ptr<Statements> stmts):
+    _stmts{std::move(stmts)}
+{}
+
+Program::~Program() = default;
+
+std::shared_ptr<const Program> Program::compile(const std::string &source, std::ostream &errors, bool lazyFunctions) {
+
+    Script::Redirect redirect(errors);
+    Script::Job job;
+
+    try {
+        Lexer lex(source);
+        Parser parser(lex, lazyFunctions);
+        return std::shared_ptr<const Program>(new Program(parser.file_input()));
+    } catch (const Script::Exit &) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<const Program> Program::compileFile(const std::string &path, std::ostream &errors, bool lazyFunctions) {
+
+    std::ifstream input(path, std::ios::in);
+    if ( !input.is_open() ) {
+        errors << "Unable to open " << path << std::endl;
+        return nullptr;
+    }
+
+    std::stringstream contents;
+    contents << input.rdbuf();
+    return compile(contents.str(), errors, lazyFunctions);
+}
+
+int Program::run(std::ostream &out) const {
+    Globals globals;
+    return run(globals, out);
+}
+
+int Program::run(Globals &globals, std::ostream &out) const {
+
+    Script::Redirect redirect(out);
+    Script::Job job;
+
+    try {
+        _stmts->evaluate(*globals._symTab);
+    } catch (const Script::Exit &exit) {
+        return exit.status;
+    }
+
+    out.flush();
+    return 0;
+}
+// END "PROGRAM"
+
+};
@@ -0,0 +1,68 @@
+#ifndef __INTERP_HPP
+#define __INTERP_HPP
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+class SymTab;
+class Statements;
+
+// Running scripts from C++ without statement.x - link libinterp.a.
+//
+//     auto program = Interp::Program::compile("print x * 2\n", std::cerr);
+//     Interp::Globals globals;
+//     globals.setInt("x", 21);
+//     int status = program->run(globals, std::cout);
+//
+// A Program is parsed once and never changed by running it, so one Program
+// can be run any number of times, from several threads at once as long as
+// each run has its own Globals.
+
+namespace Interp {
+
+    // The variables a run starts from and leaves behind - functions the
+    // script defines stay too.
+    class Globals {
+    public:
+        Globals();
+        ~Globals();
+
+        void setInt(const std::string &name, int64_t value);
+        void setDouble(const std::string &name, double value);
+        void setString(const std::string &name, const std::string &value);
+
+        bool isDefined(const std::string &name);
+        // The value as print shows it.
+        std::string toString(const std::string &name);
+
+    private:
+        friend class Program;
+
+        std::unique_ptr<SymTab> _symTab;
+    };
+
+    class Program {
+    public:
+        // nullptr when the source doesn't lex or parse - the message goes to `errors`.
+        static std::shared_ptr<const Program> compile(const std::string &source, std::ostream &errors, bool lazyFunctions = false);
+        static std::shared_ptr<const Program> compileFile(const std::string &path, std::ostream &errors, bool lazyFunctions = false);
+
+        ~Program();
+
+        // Prints and error messages go to `out`. Returns 0, or the status a
+        // fatal error ends the script with - the Globals are then left as
+        // the error found them.
+        int run(std::ostream &out) const;
+        int run(Globals &globals, std::ostream &out) const;
+
+    private:
+        Program(std::unique_ptr<Statements> stmts);
+
+        std::unique_ptr<Statements> _stmts;
+    };
+
+};
+
+#endif
@@ -0,0 +1,707 @@
+#include <iostream>
+#include <cstring>
+#include <sys/mman.h>
+
+#include "Jit.hpp"
+#include "../statements/Statement.hpp"
+#include "../Script.hpp"
+
+// Runtime helpers called from native code. They mirror the diagnostics the
+// interpreter prints for the same situations so both tiers fail identically.
+static int64_t jitRangeMode(int64_t start, int64_t end, int64_t step) {
+    // 0 -> no iterations, 1 -> counting down, 2 -> counting up
+    if (start > end && step < 0)
+        return 1;
+    else if (start < end && 1 <= step)
+        return 2;
+    else if (start == end)
+        return 0;
+
+    JitRange::flushRunning();
+    Script::out() << "Invalid For Loop" << std::endl;
+    Script::out() << "Start: " << start << "\t End: " << end << "\t Step: " << step << std::endl;
+    Script::exit(1);
+}
+
+static void jitDivideByZero() {
+    JitRange::flushRunning();
+    Script::out() << "Warning: Division by zero is undefined" << std::endl;
+    Script::exit(1);
+}
+
+// START "JITRANGE"
+thread_local JitRange *JitRange::_running = nullptr;
+
+JitRange::JitRange():
+    _code{nullptr},
+    _codeSize{0},
+    _stmt{nullptr},
+    _out{nullptr},
+    _symTab{nullptr}
+{}
+
+JitRange::~JitRange() {
+    if (_code != nullptr)
+        munmap(_code, _codeSize);
+}
+
+bool JitRange::run(SymTab &symTab) {
+
+    for (auto &name : _loopNames)
+        if ( symTab.isDefined(name) )
+            return false;
+
+    for (auto &global : _globals) {
+        if ( !symTab.isDefined(global.first) )
+            return false;
+
+        TypeDescriptor *desc = symTab.getValueFor(global.first);
+        if ( desc->type() != TypeDescriptor::INTEGER )
+            return false;
+
+        const Integer &value = Descriptor::Int::getIntValue(desc);
+        if ( !value.isSmall() )
+            return false;
+
+        _slots[global.second] = value.small();
+    }
+
+    if (debug)
+        Script::out() << "JitRange::run - entering native code" << std::endl;
+
+    // A print statement that exits the process still owes its buffered output.
+    static bool flushAtExit = atexit(&JitRange::flushRunning) == 0;
+    (void) flushAtExit;
+
+    std::vector<int64_t> entry = _slots;
+    _slots[_pendingSlot] = 0;
+    _checkpoint.clear();
+    _output.str("");
+    _out = &Script::out();
+    _symTab = &symTab;
+    _running = this;
+
+    int overflowed = reinterpret_cast<int (*)(int64_t *, JitRange *)>(_code)(_slots.data(), this);
+
+    _running = nullptr;
+    _symTab = nullptr;
+
+    // Print callouts publish loop variables - the interpreter erases them when a loop ends.
+    for (auto &name : _loopNames)
+        symTab.erase(name);
+
+    if ( !overflowed ) {
+        *_out << _output.str();
+        _output.str("");
+
+        for (auto &name : _assignedGlobals)
+            symTab.setValueFor(name, Descriptor::Int::createIntDescriptor(_slots[_globals[name]]));
+        return true;
+    }
+
+    if (debug)
+        Script::out() << "JitRange::run - integer overflow, back to the interpreter" << std::endl;
+
+    _output.str("");
+
+    if ( _checkpoint.empty() ) {
+        restoreGlobals(symTab, entry);
+        return false;
+    }
+
+    restoreGlobals(symTab, _checkpoint);
+    _stmt->iterate(symTab, _checkpoint[_varSlot], _checkpoint[_endSlot], _checkpoint[_stepSlot], _checkpoint[_modeSlot] == 1);
+    return true;
+}
+
+void JitRange::flushRunning() {
+    if ( _running == nullptr )
+        return;
+
+    *_running->_out << _running->_output.str() << std::flush;
+    _running->_output.str("");
+}
+
+void JitRange::syncGlobals() {
+    for (auto &global : _globals)
+        _symTab->setValueFor(global.first, Descriptor::Int::createIntDescriptor(_slots[global.second]));
+}
+
+void JitRange::restoreGlobals(SymTab &symTab, const std::vector<int64_t> &slots) {
+    for (auto &global : _globals)
+        symTab.setValueFor(global.first, Descriptor::Int::createIntDescriptor(slots[global.second]));
+}
+
+void JitRange::printCallout(JitRange *range, int site) {
+
+    auto &printSite = range->_printSites[site];
+
+    range->syncGlobals();
+    for (auto &loopVar : printSite.loopVars)
+        range->_symTab->setValueFor(loopVar.first, Descriptor::Int::createIntDescriptor(range->_slots[loopVar.second]));
+
+    {
+        Script::Redirect redirect(range->_output);
+        printSite.stmt->evaluate(*range->_symTab);
+    }
+
+    range->_slots[range->_pendingSlot] = 1;
+}
+
+// Called at the top of an outer iteration that printed: the iterations so far
+// can no longer be redone, so their output goes out and the slots are saved.
+void JitRange::commitCallout(JitRange *range) {
+    *range->_out << range->_output.str();
+    range->_output.str("");
+
+    range->_slots[range->_pendingSlot] = 0;
+    range->_checkpoint = range->_slots;
+}
+// END "JITRANGE"
+
+
+// START "JITCOMPILER"
+JitCompiler::JitCompiler():
+    _range{nullptr},
+    _numSlots{0}
+{}
+
+void JitCompiler::attach(Statements &stmts) {
+#if defined(__x86_64__)
+    for (auto &&stmt : stmts._statements)
+        attachStatement(stmt.get());
+#endif
+}
+
+void JitCompiler::attachStatement(Statement *stmt) {
+
+    if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        JitCompiler compiler;
+        auto compiled = compiler.compile(range);
+
+        if (debug)
+            Script::out() << "JitCompiler::attachStatement - RangeStmt " << range->_id
+                      << (compiled ? " compiled" : " left to the interpreter") << std::endl;
+
+        if ( compiled != nullptr )
+            range->_jit = std::move(compiled);
+        else
+            attach(*range->_forBody);
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        attach(*ifStatement->_if->_if.second);
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif)
+                attach(*elif.second);
+        if ( ifStatement->_else != nullptr )
+            attach(*ifStatement->_else->_stmts);
+
+    } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt) ) {
+        // A lazy body is compiled when a call first parses it, if one does.
+        if ( !funcDef->isParsed() )
+            funcDef->_whenParsed = attach;
+        else if ( funcDef->suite() != nullptr )
+            attach(*funcDef->suite());
+    }
+}
+
+void JitCompiler::collectLoopNames(Statements *stmts, std::set<std::string> &names) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            names.insert(range->_id);
+            collectLoopNames(range->_forBody.get(), names);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            collectLoopNames(ifStatement->_if->_if.second.get(), names);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    collectLoopNames(elif.second.get(), names);
+            if ( ifStatement->_else != nullptr )
+                collectLoopNames(ifStatement->_else->_stmts.get(), names);
+        }
+    }
+}
+
+std::unique_ptr<JitRange> JitCompiler::compile(RangeStmt *range) {
+
+    auto jitRange = std::make_unique<JitRange>();
+    _range = jitRange.get();
+
+    _range->_stmt = range;
+    _range->_loopNames.insert(range->_id);
+    collectLoopNames(range->_forBody.get(), _range->_loopNames);
+    _range->_pendingSlot = newSlot();
+
+    // push rbx; push r12; push r13; push r14; mov rbx, rdi; mov r12, rsi; mov r14, rsp
+    emitBytes({ 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4, 0x49, 0x89, 0xE6 });
+
+    if ( !emitRange(range) )
+        return nullptr;
+
+    // xor eax, eax; pop r14; pop r13; pop r12; pop rbx; ret
+    emitBytes({ 0x31, 0xC0, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+
+    // Overflow: unwind whatever is pushed and return 1.
+    for (auto at : _overflowJumps)
+        patchJump(at, _code.size());
+    emitBytes({ 0x4C, 0x89, 0xF4 });                 // mov rsp, r14
+    emitByte(0xB8); emitInt32(1);                    // mov eax, 1
+    emitBytes({ 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+
+    void *mem = mmap(nullptr, _code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( mem == MAP_FAILED )
+        return nullptr;
+
+    memcpy(mem, _code.data(), _code.size());
+    if ( mprotect(mem, _code.size(), PROT_READ | PROT_EXEC) != 0 ) {
+        munmap(mem, _code.size());
+        return nullptr;
+    }
+
+    _range->_code = mem;
+    _range->_codeSize = _code.size();
+    _range->_slots.resize(_numSlots);
+
+    return jitRange;
+}
+
+bool JitCompiler::emitStatements(Statements *stmts) {
+    for (auto &&stmt : stmts->_statements)
+        if ( !emitStatement(stmt.get()) )
+            return false;
+    return true;
+}
+
+bool JitCompiler::emitStatement(Statement *stmt) {
+
+    if ( auto assign = dynamic_cast<AssignStmt *>(stmt) )
+        return emitAssign(assign);
+    else if ( auto print = dynamic_cast<PrintStatement *>(stmt) )
+        return emitPrint(print);
+    else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) )
+        return emitIf(ifStatement);
+    else if ( auto range = dynamic_cast<RangeStmt *>(stmt) )
+        return emitRange(range);
+
+    return false;
+}
+
+bool JitCompiler::emitRange(RangeStmt *range) {
+
+    // for x in <sequence> has no integer bounds to run on.
+    if ( range->_iterable != nullptr )
+        return false;
+
+    // prange's iterations are spread over threads by the interpreter.
+    if ( range->_parallel != nullptr )
+        return false;
+
+    auto &testList = *range->_testList;
+
+    if ( testList.size() < 1 || testList.size() > 3 )
+        return false;
+
+    for (auto &loopVar : _scope)
+        if ( loopVar.first == range->_id )
+            return false;
+
+    bool outermost = _scope.empty();
+    int start = newSlot(), end = newSlot(), step = newSlot(), mode = newSlot(), var = newSlot();
+    int bounds[3] = { start, end, step };
+
+    if ( outermost ) {
+        _range->_varSlot = var;
+        _range->_endSlot = end;
+        _range->_stepSlot = step;
+        _range->_modeSlot = mode;
+    }
+    int first = testList.size() == 1 ? 1 : 0;
+
+    // Defaults first, so an argument that is present always overwrites them.
+    emitLoadImmediate(0); emitSlotOp(0x89, 0, start);
+    emitLoadImmediate(1); emitSlotOp(0x89, 0, step);
+
+    for (size_t i = 0; i < testList.size(); i++) {
+        Kind kind;
+        if ( !emitExpr(testList[i].get(), kind) || kind != INT )
+            return false;
+        emitSlotOp(0x89, 0, bounds[first + i]);
+    }
+
+    // mode = jitRangeMode(start, end, step)
+    emitSlotOp(0x8B, 7, start);
+    emitSlotOp(0x8B, 6, end);
+    emitSlotOp(0x8B, 2, step);
+    emitCall(reinterpret_cast<const void *>(&jitRangeMode));
+    emitSlotOp(0x89, 0, mode);
+
+    emitBytes({ 0x48, 0x85, 0xC0 });                 // test rax, rax
+    size_t skip = emitJump({ 0x0F, 0x84 });          // jz exit
+
+    emitSlotOp(0x8B, 0, start);
+    emitSlotOp(0x89, 0, var);
+
+    size_t header = _code.size();
+    if ( outermost ) {
+        emitSlotOp(0x83, 7, _range->_pendingSlot); emitByte(0);
+        size_t clean = emitJump({ 0x0F, 0x84 });     // jz clean
+        emitBytes({ 0x4C, 0x89, 0xE7 });             // mov rdi, r12
+        emitCall(reinterpret_cast<const void *>(&JitRange::commitCallout));
+        patchJump(clean, _code.size());
+    }
+
+    emitSlotOp(0x83, 7, mode); emitByte(2);          // cmp qword [mode], 2
+    size_t toDown = emitJump({ 0x0F, 0x85 });        // jne down
+    emitSlotOp(0x8B, 0, var);
+    emitSlotOp(0x3B, 0, end);
+    size_t upExit = emitJump({ 0x0F, 0x8D });        // jge exit
+    size_t toBody = emitJump({ 0xE9 });
+
+    patchJump(toDown, _code.size());
+    emitSlotOp(0x8B, 0, var);
+    emitSlotOp(0x3B, 0, end);
+    size_t downExit = emitJump({ 0x0F, 0x8E });      // jle exit
+
+    patchJump(toBody, _code.size());
+    _scope.push_back({ range->_id, var });
+    bool ok = emitStatements(range->_forBody.get());
+    _scope.pop_back();
+
+    if ( !ok )
+        return false;
+
+    emitSlotOp(0x8B, 0, step);
+    emitSlotOp(0x01, 0, var);                        // add [var], rax
+    emitOverflowCheck();
+    patchJump(emitJump({ 0xE9 }), header);
+
+    patchJump(skip, _code.size());
+    patchJump(upExit, _code.size());
+    patchJump(downExit, _code.size());
+
+    return true;
+}
+
+bool JitCompiler::emitIf(IfStatement *ifStatement) {
+
+    std::vector<std::pair<ExprNode *, Statements *>> branches;
+    std::vector<size_t> toEnd;
+
+    branches.push_back({ ifStatement->_if->_if.first.get(), ifStatement->_if->_if.second.get() });
+    if ( ifStatement->_elif != nullptr )
+        for (auto &&elif : ifStatement->_elif->_elif)
+            branches.push_back({ elif.first.get(), elif.second.get() });
+
+    for (auto &branch : branches) {
+        if ( !emitTruth(branch.first) )
+            return false;
+
+        emitBytes({ 0x85, 0xC0 });                   // test eax, eax
+        size_t next = emitJump({ 0x0F, 0x84 });      // jz next
+
+        if ( !emitStatements(branch.second) )
+            return false;
+
+        toEnd.push_back(emitJump({ 0xE9 }));
+        patchJump(next, _code.size());
+    }
+
+    if ( ifStatement->_else != nullptr && !emitStatements(ifStatement->_else->_stmts.get()) )
+        return false;
+
+    for (auto at : toEnd)
+        patchJump(at, _code.size());
+
+    return true;
+}
+
+bool JitCompiler::emitAssign(AssignStmt *assign) {
+
+    Kind kind;
+    int slot;
+
+    if ( !emitExpr(assign->_rhsExpression.get(), kind) || kind != INT )
+        return false;
+
+    if ( !lookupVariable(assign->_lhsVariable, slot) )
+        return false;
+
+    if ( _range->_globals.count(assign->_lhsVariable) )
+        _range->_assignedGlobals.insert(assign->_lhsVariable);
+
+    emitSlotOp(0x89, 0, slot);
+    return true;
+}
+
+bool JitCompiler::emitPrint(PrintStatement *print) {
+
+    for (auto &&item : *print->_testList)
+        if ( !checkPrintExpr(item.get()) )
+            return false;
+
+    int site = _range->_printSites.size();
+    _range->_printSites.push_back({ print, _scope });
+
+    emitBytes({ 0x4C, 0x89, 0xE7 });                 // mov rdi, r12
+    emitByte(0xBE); emitInt32(site);                 // mov esi, site
+    emitCall(reinterpret_cast<const void *>(&JitRange::printCallout));
+
+    return true;
+}
+
+// Print statements are still evaluated by the interpreter, so their operands
+// only need to be side-effect free and visible at this point of the loop.
+bool JitCompiler::checkPrintExpr(ExprNode *expr) {
+
+    if ( expr == nullptr )
+        return true;
+
+    if ( dynamic_cast<Variable *>(expr) ) {
+        std::string name = expr->token()->getName();
+        for (auto &loopVar : _scope)
+            if ( loopVar.first == name )
+                return true;
+        return _range->_loopNames.count(name) == 0;
+    }
+
+    if ( dynamic_cast<WholeNumber *>(expr) || dynamic_cast<Double *>(expr) || dynamic_cast<StringExp *>(expr) )
+        return true;
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) )
+        return checkPrintExpr(infix->_left.get()) && checkPrintExpr(infix->_right.get());
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) )
+        return checkPrintExpr(comparison->_left.get()) && checkPrintExpr(comparison->_right.get());
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) )
+        return checkPrintExpr(boolean->_left.get()) && checkPrintExpr(boolean->_right.get());
+
+    return false;
+}
+
+bool JitCompiler::emitTruth(ExprNode *expr) {
+    // IfStmt::evaluate insists on a BOOL descriptor, anything else is an interpreter error.
+    Kind kind;
+    return emitExpr(expr, kind) && kind == BOOL;
+}
+
+// Leaves the value of expr in eax.
+bool JitCompiler::emitExpr(ExprNode *expr, Kind &kind) {
+
+    auto tok = expr->token();
+
+    if ( dynamic_cast<WholeNumber *>(expr) ) {
+        if ( !tok->getWholeNumber().isSmall() )
+            return false;
+        emitLoadImmediate(tok->getWholeNumber().small());
+        kind = INT;
+        return true;
+    }
+
+    if ( dynamic_cast<Variable *>(expr) ) {
+        int slot;
+        if ( !lookupVariable(tok->getName(), slot) )
+            return false;
+        emitSlotOp(0x8B, 0, slot);
+        kind = INT;
+        return true;
+    }
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        Kind lKind, rKind;
+
+        if ( tok->isSubtractionOperator() && infix->_right == nullptr ) {
+            if ( !emitExpr(infix->_left.get(), lKind) || lKind != INT )
+                return false;
+            emitBytes({ 0x48, 0xF7, 0xD8 });         // neg rax
+            emitOverflowCheck();
+            kind = INT;
+            return true;
+        }
+
+        if ( !emitExpr(infix->_left.get(), lKind) || lKind != INT )
+            return false;
+        emitByte(0x50);                              // push rax
+        if ( !emitExpr(infix->_right.get(), rKind) || rKind != INT )
+            return false;
+        emitBytes({ 0x48, 0x89, 0xC1, 0x58 });       // mov rcx, rax; pop rax
+
+        if ( tok->isAdditionOperator() )
+            emitBytes({ 0x48, 0x01, 0xC8 });
+        else if ( tok->isSubtractionOperator() )
+            emitBytes({ 0x48, 0x29, 0xC8 });
+        else if ( tok->isMultiplicationOperator() )
+            emitBytes({ 0x48, 0x0F, 0xAF, 0xC1 });
+        else if ( tok->isDivisionOperator() || tok->isModuloOperator() ) {
+            emitBytes({ 0x48, 0x85, 0xC9 });         // test rcx, rcx
+            size_t nonZero = emitJump({ 0x0F, 0x85 });
+            emitCall(reinterpret_cast<const void *>(&jitDivideByZero));
+            patchJump(nonZero, _code.size());
+
+            // INT64_MIN / -1 traps in idiv - the interpreter has the answer.
+            emitBytes({ 0x48, 0x83, 0xF9, 0xFF });   // cmp rcx, -1
+            size_t fits = emitJump({ 0x0F, 0x85 });
+            emitBytes({ 0x48, 0xBA });               // mov rdx, INT64_MIN
+            emitInt32(0); emitInt32(INT32_MIN);
+            emitBytes({ 0x48, 0x39, 0xD0 });         // cmp rax, rdx
+            _overflowJumps.push_back(emitJump({ 0x0F, 0x84 }));
+            patchJump(fits, _code.size());
+
+            emitBytes({ 0x48, 0x99, 0x48, 0xF7, 0xF9 }); // cqo; idiv rcx
+            if ( tok->isModuloOperator() )
+                emitBytes({ 0x48, 0x89, 0xD0 });     // mov rax, rdx
+            kind = INT;
+            return true;
+        } else
+            return false;
+
+        emitOverflowCheck();
+
+        kind = INT;
+        return true;
+    }
+
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        Kind lKind, rKind;
+        uint8_t setcc;
+
+        // Bools compare as 1.0 in comparisonDescriptor - keep those in the interpreter.
+        if ( !emitExpr(comparison->_left.get(), lKind) || lKind != INT )
+            return false;
+        emitByte(0x50);
+        if ( !emitExpr(comparison->_right.get(), rKind) || rKind != INT )
+            return false;
+        emitBytes({ 0x48, 0x89, 0xC1, 0x58 });
+
+        if ( tok->isRelGT() )                           setcc = 0x9F;
+        else if ( tok->isRelLT() )                      setcc = 0x9C;
+        else if ( tok->isRelGTE() )                     setcc = 0x9D;
+        else if ( tok->isRelLTE() )                     setcc = 0x9E;
+        else if ( tok->isRelEQ() )                      setcc = 0x94;
+        else if ( tok->isRelNotEQ() || tok->isRelEQML() ) setcc = 0x95;
+        else return false;
+
+        emitBytes({ 0x48, 0x39, 0xC8, 0x0F, setcc, 0xC0, 0x0F, 0xB6, 0xC0 }); // cmp rax, rcx; setcc al; movzx eax, al
+        kind = BOOL;
+        return true;
+    }
+
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        Kind lKind, rKind;
+
+        if ( tok->isNot() ) {
+            if ( !emitExpr(boolean->_left.get(), lKind) )
+                return false;
+            if ( lKind == BOOL )
+                emitBytes({ 0x83, 0xF0, 0x01 });     // xor eax, 1
+            else
+                emitBytes({ 0x48, 0x85, 0xC0, 0x0F, 0x94, 0xC0, 0x0F, 0xB6, 0xC0 }); // eax = (rax == 0)
+            kind = BOOL;
+            return true;
+        }
+
+        if ( !tok->isAnd() && !tok->isOr() )
+            return false;
+
+        // andDescriptor / orDescriptor treat an operand as true when it is > 0.
+        if ( !emitExpr(boolean->_left.get(), lKind) )
+            return false;
+        if ( lKind == INT )
+            emitBytes({ 0x48, 0x85, 0xC0, 0x0F, 0x9F, 0xC0, 0x0F, 0xB6, 0xC0 }); // eax = (rax > 0)
+
+        // Like the interpreter, the right side is skipped once the left decides.
+        emitBytes({ 0x85, 0xC0 });                                                  // test eax, eax
+        size_t decided = emitJump({ 0x0F, (uint8_t) (tok->isAnd() ? 0x84 : 0x85) }); // jz / jnz decided
+        if ( !emitExpr(boolean->_right.get(), rKind) )
+            return false;
+        if ( rKind == INT )
+            emitBytes({ 0x48, 0x85, 0xC0, 0x0F, 0x9F, 0xC0, 0x0F, 0xB6, 0xC0 });
+        patchJump(decided, _code.size());
+
+        kind = BOOL;
+        return true;
+    }
+
+    return false;
+}
+
+bool JitCompiler::lookupVariable(std::string name, int &slot) {
+
+    for (auto it = _scope.rbegin(); it != _scope.rend(); ++it) {
+        if ( it->first == name ) {
+            slot = it->second;
+            return true;
+        }
+    }
+
+    // A loop variable used outside of its loop is an interpreter error (or a
+    // redefinition the interpreter dies on) - leave it to the interpreter.
+    if ( _range->_loopNames.count(name) )
+        return false;
+
+    auto global = _range->_globals.find(name);
+    if ( global == _range->_globals.end() )
+        global = _range->_globals.insert({ name, newSlot() }).first;
+
+    slot = global->second;
+    return true;
+}
+
+void JitCompiler::emitOverflowCheck() {
+    _overflowJumps.push_back(emitJump({ 0x0F, 0x80 })); // jo bailout
+}
+
+int JitCompiler::newSlot() {
+    return _numSlots++;
+}
+
+void JitCompiler::emitByte(uint8_t b) {
+    _code.push_back(b);
+}
+
+void JitCompiler::emitBytes(std::initializer_list<uint8_t> bytes) {
+    _code.insert(_code.end(), bytes);
+}
+
+void JitCompiler::emitInt32(int32_t v) {
+    uint8_t bytes[4];
+    memcpy(bytes, &v, 4);
+    _code.insert(_code.end(), bytes, bytes + 4);
+}
+
+void JitCompiler::emitLoadImmediate(int64_t v) {
+    emitBytes({ 0x48, 0xB8 });                       // mov rax, imm64
+    emitInt32((int32_t) v);
+    emitInt32((int32_t) (v >> 32));
+}
+
+void JitCompiler::emitSlotOp(uint8_t opcode, int reg, int slot) {
+    // opcode reg, qword [rbx + disp32]
+    emitByte(0x48);
+    emitByte(opcode);
+    emitByte(0x83 | (reg << 3));
+    emitInt32(slot * 8);
+}
+
+void JitCompiler::emitCall(const void *fn) {
+    uint64_t address = reinterpret_cast<uint64_t>(fn);
+
+    emitBytes({ 0x49, 0x89, 0xE5 });                 // mov r13, rsp
+    emitBytes({ 0x48, 0x83, 0xE4, 0xF0 });           // and rsp, -16
+    emitBytes({ 0x48, 0xB8 });                       // mov rax, imm64
+    for (int i = 0; i < 8; i++)
+        emitByte((address >> (8 * i)) & 0xFF);
+    emitBytes({ 0xFF, 0xD0 });                       // call rax
+    emitBytes({ 0x4C, 0x89, 0xEC });                 // mov rsp, r13
+}
+
+size_t JitCompiler::emitJump(std::initializer_list<uint8_t> opcode) {
+    emitBytes(opcode);
+    size_t at = _code.size();
+    emitInt32(0);
+    return at;
+}
+
+void JitCompiler::patchJump(size_t at, size_t target) {
+    int32_t rel = (int32_t) (target - (at + 4));
+    memcpy(&_code[at], &rel, 4);
+}
+// END "JITCOMPILER"
@@ -0,0 +1,136 @@
+#ifndef __JIT_HPP
+#define __JIT_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../SymTab.hpp"
+
+class ExprNode;
+class Statement;
+class Statements;
+class RangeStmt;
+class AssignStmt;
+class IfStatement;
+class PrintStatement;
+
+// A JitRange is the native x86-64 translation of one RangeStmt (and everything
+// nested inside it). Every variable the loop touches lives in a 64-bit slot of
+// _slots while the native code runs; the slots are loaded from the SymTab on
+// entry and written back on exit.
+//
+// Integers are unbounded in the interpreter, so the native code speculates
+// that every value fits in 64 bits and bails out on overflow. What the
+// interpreter must not see twice is output: prints are buffered and committed
+// at the top of each outer iteration, together with a checkpoint of the
+// slots. A bailout drops the unfinished iteration and the interpreter resumes
+// the loop from the last checkpoint (or reruns it when there is none).
+
+class JitRange {
+
+public:
+    JitRange();
+    ~JitRange();
+
+    // Returns false when the SymTab does not hold what the code was compiled
+    // for (an undefined, non-integer or too wide variable), or when the code
+    // overflowed before its first checkpoint - the caller interprets instead.
+    bool run(SymTab &symTab);
+
+    // Writes out buffered prints of the range that is running, if any - for
+    // the runtime helpers that exit the process.
+    static void flushRunning();
+
+private:
+    friend class JitCompiler;
+
+    struct PrintSite {
+        PrintStatement *stmt;
+        std::vector<std::pair<std::string, int>> loopVars;
+    };
+
+    static void printCallout(JitRange *range, int site);
+    static void commitCallout(JitRange *range);
+    void syncGlobals();
+    void restoreGlobals(SymTab &symTab, const std::vector<int64_t> &slots);
+
+    static thread_local JitRange *_running;
+
+    void *_code;
+    size_t _codeSize;
+
+    RangeStmt *_stmt;
+    int _varSlot, _endSlot, _stepSlot, _modeSlot;
+    int _pendingSlot;
+
+    std::map<std::string, int> _globals;
+    std::set<std::string> _assignedGlobals;
+    std::set<std::string> _loopNames;
+    std::vector<PrintSite> _printSites;
+
+    std::vector<int64_t> _slots;
+    std::vector<int64_t> _checkpoint;
+    std::stringstream _output;
+    std::ostream *_out;
+    SymTab *_symTab;
+};
+
+// The JitCompiler walks a parsed program and attaches a JitRange to every
+// outermost RangeStmt whose body only does integer arithmetic, comparisons,
+// assignments, ifs, nested ranges and prints. Anything else is left to the
+// interpreter. A lazily parsed function body is walked when a call first
+// parses it, so --lazy still skips the bodies nothing calls.
+
+class JitCompiler {
+
+public:
+    static void attach(Statements &stmts);
+    static void attachStatement(Statement *stmt);
+
+private:
+    enum Kind { INT, BOOL };
+
+    JitCompiler();
+
+    static void collectLoopNames(Statements *stmts, std::set<std::string> &names);
+
+    std::unique_ptr<JitRange> compile(RangeStmt *range);
+
+    bool emitStatements(Statements *stmts);
+    bool emitStatement(Statement *stmt);
+    bool emitRange(RangeStmt *range);
+    bool emitIf(IfStatement *ifStatement);
+    bool emitAssign(AssignStmt *assign);
+    bool emitPrint(PrintStatement *print);
+    bool emitExpr(ExprNode *expr, Kind &kind);
+    bool emitTruth(ExprNode *expr);
+    bool checkPrintExpr(ExprNode *expr);
+
+    bool lookupVariable(std::string name, int &slot);
+    int newSlot();
+
+    void emitOverflowCheck();
+
+    // x86-64 encoding helpers. Slots are addressed as [rbx + 8 * slot].
+    void emitByte(uint8_t b);
+    void emitBytes(std::initializer_list<uint8_t> bytes);
+    void emitInt32(int32_t v);
+    void emitLoadImmediate(int64_t v);
+    void emitSlotOp(uint8_t opcode, int reg, int slot);
+    void emitCall(const void *fn);
+    size_t emitJump(std::initializer_list<uint8_t> opcode);
+    void patchJump(size_t at, size_t target);
+
+    std::vector<uint8_t> _code;
+    std::vector<size_t> _overflowJumps;
+    JitRange *_range;
+    std::vector<std::pair<std::string, int>> _scope;
+    int _numSlots;
+};
+
+#endif
@@ -1,90 +1,139 @@
+#include <charconv>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <functional>
 
 #include "Lexer.hpp"
+#include "../Script.hpp"
+
+static std::string readAll(std::ifstream &stream) {
+    std::stringstream contents;
+    if ( stream.is_open() )
+        contents << stream.rdbuf();
+    return contents.str();
+}
 
 Lexer::Lexer(std::ifstream &stream):
-    inStream{stream},
+    Lexer(readAll(stream), false)
+{}
+
+Lexer::Lexer(std::string source):
+    Lexer(std::move(source), false)
+{}
+
+Lexer::Lexer(std::string source, bool chunk):
     ungottenToken{false},
+    pythonLexSpace({0}),
     tokIdx{0},
+    _source{std::move(source)},
+    _pos{0},
+    _atEnd{false},
+    _scan{scanKernels()},
     startLine{true},
-    _numTabs{0},
     _numSpace{0},
-    pythonLexSpace({0})
+    _chunk{chunk},
+    _fatalAt{0},
+    _deferErrors{chunk}
 {}
 
-static inline bool isEqualityOperator(char c) { return c == '=' || c == '!' || c == '<' || c == '>'; };
-static inline bool isKeyword(std::string s) {
-    return (s == "for" || s == "print" || s == "if" || s == "else" || s == "elif" ||
-            s == "def" || s == "and" || s == "or" || s == "while" || s == "not" || s == "in" ||
-            s == "range" || s == "len" || s == "def" );
+inline bool Lexer::get(char &c) {
+    if ( _pos < _source.size() ) {
+        c = _source[_pos++];
+        return true;
+    }
+    _atEnd = true;
+    return false;
 }
 
-inline int Lexer::spacesConsumedOnLine() {
-    return _numTabs + _numSpace;
+inline void Lexer::putback() {
+    _pos--;
+}
+
+// Replaying lexers have no input - they hand out their queued tokens.
+Lexer::Lexer(std::vector<std::shared_ptr<Token>> tokens, std::optional<std::string> fatal):
+    Lexer(std::string(), false)
+{
+    for (auto &tok : tokens)
+        _tokens.push(tok);
+    _fatal = fatal;
 }
 
-std::string Lexer::readEqualityOperator() {
+void Lexer::fatal(std::string message) {
 
-    char c;
-    inStream.get(c);
+    if ( !_deferErrors ) {
+        Script::out() << message;
+        Script::exit(1);
+    }
 
-    if ( c == '=' ) {
-        inStream.get(c);
+    // Keep the first error and stop reading - the input ends here.
+    if ( !_fatal ) {
+        _fatal = message;
+        _fatalAt = _processedTokens.size();
+    }
+    _pos = _source.size();
+}
 
-        if (c == '>' || c == '<') {
-            std::cout << "Invalid RelOP -> " << c << " <- found... exiting. \n";
-            exit(1);
-        } else if (c == '=') {
-            return "==";
-        } else {
-            inStream.putback(c);
-            return "=";
-        }
-    } else if ( c == '>' ) {
-        inStream.get(c);
-
-        if ( c == '=' ) {    //relGTE
-            return ">=";
-        } else {            //GT
-            inStream.putback(c);
-            return ">";
-        }
-    } else if ( c == '<' ) {
-        inStream.get(c);
-
-        if (c == '=') { // LTE
-            return "<=";
-        } else if (c == '>') {//ML NEQ
-            return "<>";
-        } else { // LT
-            inStream.putback(c);
-            return "<";
+bool Lexer::indentationTokens(std::stack<int> &levels, int spaces, std::vector<std::shared_ptr<Token>> &out) {
+
+    int peekStack = levels.top();
+
+    if (spaces > peekStack) {
+        levels.push(spaces);
+        out.emplace_back(new Token(KW_INDENT));
+
+    } else if (spaces < peekStack) {
+        // DROP BACK DOWN to new scope @@ smaller 
+        while (peekStack != spaces) {
+            out.emplace_back(new Token(KW_DEDENT));
+
+            levels.pop();
+            if (levels.empty())
+                return false;
+            peekStack = levels.top();
         }
-    } else if ( c == '!' ) {
-        inStream.get(c);
+    }
 
-        if (c == '=') {
-            return "!=";
-        } else {
-            std::cout << "Invalid RelOP -> " << c << " <- found.. exiting. \n";
-            exit(1);
+    return true;
+}
+
+static inline bool isEqualityOperator(char c) { return c == '=' || c == '!' || c == '<' || c == '>'; };
+
+inline int Lexer::spacesConsumedOnLine() {
+    return _numSpace;
+}
+
+RelOpKind Lexer::readEqualityOperator() {
+
+    // Maximal munch over relOpTransitions - stops at the first byte with no
+    // transition and accepts if the state ends an operator.
+    int state = S_START;
+    while ( _pos < _source.size() ) {
+        int next = relOpTransitions[state][relOpClass(_source[_pos])];
+        if ( next < 0 )
+            break;
+        state = next;
+        _pos++;
+
+        if ( state == S_INVALID ) {
+            fatal(std::string("Invalid RelOP -> ") + _source[_pos - 1] + " <- found... exiting. \n");
+            return REL_NONE;
         }
     }
 
-    std::cout << "Fatal Error Lexer::readEqualityOperator\n";
-    std::cout << "Dump ->" << c << "<-" << std::endl;
-    exit(1);
+    if ( relOpAccept[state] == REL_NONE ) {
+        fatal(std::string("Invalid RelOP -> ") + (_pos < _source.size() ? _source[_pos] : ' ') + " <- found.. exiting. \n");
+    }
 
-    return "";
+    return relOpAccept[state];
 }
 
 std::string Lexer::readString() {
 
     char c;
-    inStream.get(c);
+    get(c);
 
-    std::string capture = "";
     char escapeOn = '\0';
 
     if (c == '"')
@@ -93,41 +142,43 @@ std::string Lexer::readString() {
         escapeOn = '\'';
 
     if (escapeOn == '\0') {
-        std::cout << "Fatal Error Lexer::readString.. expected {\",'} got ->" << escapeOn << "<-\n";
-        exit(1); 
+        fatal(std::string("Fatal Error Lexer::readString.. expected {\",'} got ->") + escapeOn + "<-\n");
+        return "";
     }
 
-    inStream.get(c);
     // keep it simple to continue 
     // TODO come back later and deal with escape
-    while (c != escapeOn/* && seenEscape == false*/) {
-        capture += c;
-        inStream.get(c);
+    size_t close = _scan.find(_source.data(), _pos, _source.size(), escapeOn);
+    if ( close == _source.size() ) {
+        fatal("Fatal Error Lexer::readString.. unterminated string\n");
+        return "";
     }
 
+    std::string capture = _source.substr(_pos, close - _pos);
+    _pos = close + 1;
     return capture;
 }
 
 void Lexer::consumeLine() {
     
     char c;
-    inStream.get(c);
+    get(c);
 
     if (c != '#') {
-        std::cout << "Fatal Error Lexer::consumeLine.. expected #, got " << c << "\n";
-        exit(1);
+        fatal(std::string("Fatal Error Lexer::consumeLine.. expected #, got ") + c + "\n");
+        return;
     }
 
-    while (c != '\n') {
-            if (inStream.eof()) {
-            auto tok = std::make_shared<Token>();
-            tok->eof() = true;
-            _tokens.push(tok);
-            return;
-        }
-
-        inStream.get(c);
+    size_t newline = _scan.find(_source.data(), _pos, _source.size(), '\n');
+    if ( newline == _source.size() ) {
+        _pos = newline;
+        _atEnd = true;
+        auto tok = std::make_shared<Token>();
+        tok->eof() = true;
+        _tokens.push(tok);
+        return;
     }
+    _pos = newline + 1;
 
     if ( startLine == false ) {
         auto token = std::make_shared<Token>();
@@ -136,7 +187,6 @@ void Lexer::consumeLine() {
     }
 
     startLine = true;
-    _numTabs = 0;
     _numSpace = 0;
 }
 
@@ -148,28 +198,29 @@ bool Lexer::consumeLeadingSpaces() {
         return false;
     }
 
-    char c;
-    inStream.get(c);
+    // Spaces and tabs each count as one column of indentation; any other
+    // whitespace is skipped without being counted.
+    char c = '\0';
+    while (true) {
+        size_t end = _scan.indentEnd(_source.data(), _pos, _source.size());
+        _numSpace += end - _pos;
+        _pos = end;
 
-    while (isspace(c)) {
-        if (c == '\t') 
-            _numTabs += 1;
-        else if (c == ' ') {
-            _numSpace += 1;
-        }
-        else if (c == '\n') {
+        if ( !get(c) )
+            break;
+
+        if (c == '\n') {
             startLine = true;
-            _numTabs = 0;
             _numSpace = 0;
             return true;
         }
 
-        inStream.get(c);
+        if ( !isspace(c) ) {
+            putback();
+            break;
+        }
     }
 
-    if (inStream.good())
-        inStream.putback(c);
-
     if ( c == '#' ) {
         consumeLine();
         return true;
@@ -181,65 +232,51 @@ bool Lexer::consumeLeadingSpaces() {
 
 //https://stackoverflow.com/questions/31171075/what-is-the-best-practice-when-passing-a-shared-pointer-to-a-non-owning-function
 void Lexer::readNumber(const bool isNegative, const std::shared_ptr<Token>& tok) {
-    // int intValue = 0;
-    char c;
-    std::string number = "";
+    size_t start = _pos;
     bool isFloat = false;
-    while( inStream.get(c) && isdigit(c) ) {
-        // intValue = intValue * 10 + c - '0';
-        number += c;
-    }
-    if (c == '.') {
-        number += c;
+
+    _pos = _scan.digitEnd(_source.data(), _pos, _source.size());
+    if ( _pos < _source.size() && _source[_pos] == '.' ) {
         isFloat = true;
-        while( inStream.get(c) && isdigit(c) ) {
-        // intValue = intValue * 10 + c - '0';
-            number += c;
-        }
+        _pos = _scan.digitEnd(_source.data(), _pos + 1, _source.size());
     }
-    if (inStream.good())
-        inStream.putback(c);
 
-    if ( number == "." ) {
-        tok->setKeyword(".");
+    // Converted in place - no copy of the digits is made.
+    const char *first = _source.data() + start;
+    const char *last = _source.data() + _pos;
+
+    if ( last - first == 1 && *first == '.' ) {
+        tok->setKeyword(KW_PERIOD);
     }
 
     else if ( isFloat ) {
-        float floatValue = atof(number.c_str());
+        double doubleValue = 0.;
+        std::from_chars(first, last, doubleValue);
         if (isNegative)
-            floatValue *= -1.;
-        tok->setFloat( floatValue );
+            doubleValue *= -1.;
+        tok->setFloat( doubleValue );
     }
 
     else {
-        int intValue = stoi(number);
+        // Any length - a literal too wide for 64 bits becomes a bignum.
+        int64_t smallValue;
+        Integer intValue = std::from_chars(first, last, smallValue).ec == std::errc()
+            ? Integer(smallValue) : Integer::parse(std::string(first, last));
         if (isNegative)
-            intValue *= -1;
+            intValue = -intValue;
         tok->setWholeNumber( intValue );
     }
-
-
 }
 
 std::string Lexer::readName() {
 
-    std::string name;
-    char c;
-
-    inStream.get(c);
-
-    if ( c == '_' || isalnum(c) ) {
-      name += c;
-    } else {
-      exit(1);
-    }
+    size_t end = _scan.identifierEnd(_source.data(), _pos, _source.size());
 
-    while ( inStream.get(c) && ( c == '_' || isalnum(c) || isdigit(c) )) {
-      name += c;
-    }
+    if ( end == _pos )
+      fatal("");
 
-    if(inStream.good())  // In the loop, we have read one char too many.
-        inStream.putback(c);
+    std::string name = _source.substr(_pos, end - _pos);
+    _pos = end;
     return name;
 }
 
@@ -251,48 +288,121 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
         return lastToken;
     }
 
+    if ( _pipeline )
+        return lastToken = pipelinedToken();
+
+    return lastToken = nextToken();
+}
+
+// START "PIPELINE"
+Lexer::Pipeline::Pipeline():
+    ring(pipelineCapacity),
+    stop{false},
+    consumed{0}
+{}
+
+Lexer::Pipeline::~Pipeline() {
+    stop = true;
+    if ( producer.joinable() )
+        producer.join();
+}
+
+void Lexer::startPipeline() {
+
+    if ( _pipeline || !_tokens.empty() || _source.empty() )
+        return;
+
+    if (debug)
+        Script::out() << "Lexer::startPipeline" << std::endl;
+
+    _deferErrors = true;
+    _pipeline = std::make_unique<Pipeline>();
+    _pipeline->producer = std::thread(&Lexer::produceTokens, this, std::ref(*_pipeline));
+}
+
+// Producer thread - runs until EOF or the first lexical error, which goes
+// through the ring as a null token so it surfaces where the serial Lexer
+// would have exited.
+void Lexer::produceTokens(Pipeline &pipeline) {
+
+    while ( !pipeline.stop ) {
+        auto token = nextToken();
+        bool failed = _fatal.has_value();
+        if ( failed )
+            token = nullptr;
+
+        while ( !pipeline.ring.tryPush(token) ) {
+            if ( pipeline.stop )
+                return;
+            std::this_thread::yield();
+        }
+
+        if ( failed || token->eof() )
+            return;
+    }
+}
+
+std::shared_ptr<Token> Lexer::pipelinedToken() {
+
+    std::shared_ptr<Token> token;
+    while ( !_pipeline->ring.tryPop(token) )
+        std::this_thread::yield();
+    _pipeline->consumed++;
+
+    if ( token == nullptr ) {
+        _pipeline->producer.join();
+        Script::out() << *_fatal;
+        Script::exit(1);
+    }
+
+    // Past EOF the producer has finished; later calls lex on this thread.
+    if ( token->eof() ) {
+        _pipeline.reset();
+        _deferErrors = false;
+    }
+
+    return token;
+}
+// END "PIPELINE"
+
+std::shared_ptr<Token> Lexer::nextToken() {
+
     if (!_tokens.empty()) {
         if (debug)
-            std::cout << "!_tokens.empty()" << std::endl;
+            Script::out() << "!_tokens.empty()" << std::endl;
         auto cachedToken = _tokens.front();
         _processedTokens.push_back(cachedToken);
         _tokens.pop();
-        return lastToken = cachedToken;
+        return cachedToken;
 
     }
 
+    // A replayed stream that ends in a lexical error reports it only now.
+    if ( _fatal && !_deferErrors ) {
+        Script::out() << *_fatal;
+        Script::exit(1);
+    }
+
     if (startLine) {
         //Returns true if we consumed the entire line
         // and need to call getToken();
         if (consumeLeadingSpaces()) {
-            return getToken();
+            return nextToken();
         }
 
         // We just consumed leading spaces - which didn't catch a newline
         startLine = false;
         int spacesConsumed = spacesConsumedOnLine();
 
-        int peekStack = pythonLexSpace.top();
-
-        if (spacesConsumed > peekStack) {
-            pythonLexSpace.push(spacesConsumed);
-            _tokens.emplace(new Token("INDENT"));
-
-        } else if (spacesConsumed < peekStack) {
-            // DROP BACK DOWN to new scope @@ smaller 
-            while (peekStack != spacesConsumed) {
-                _tokens.emplace(new Token("DEDENT"));
-                
-                if (pythonLexSpace.empty()) {
-                    std::cout << "Fatal Error in Lex::getToken()..couldn't parse spaces\n";
-                    exit(1);
-                }
-
-                pythonLexSpace.pop();
-                peekStack = pythonLexSpace.top();
-            }
-
-        } else {;;}
+        if ( _chunk ) {
+            _lineStarts.emplace_back(_processedTokens.size(), spacesConsumed);
+        } else {
+            std::vector<std::shared_ptr<Token>> indentation;
+            if ( !indentationTokens(pythonLexSpace, spacesConsumed, indentation) )
+                fatal("Fatal Error in Lex::getToken()..couldn't parse spaces\n");
+            for (auto &tok : indentation)
+                _tokens.push(tok);
+        }
 
         // If we added tokens to our queue we need to return them.
         if (!_tokens.empty()) {
@@ -304,7 +414,7 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
 
             //Pop off stack
             _tokens.pop();
-            return lastToken = tok;
+            return tok;
         }
     }
 
@@ -315,62 +425,67 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
     auto token = std::make_shared<Token>();
 
     char c;
-    inStream.get(c);
-
-    while (c == ' ' && inStream.get(c));
+    _pos = _scan.spaceEnd(_source.data(), _pos, _source.size());
 
-    if (inStream.eof()) {
+    if ( !get(c) ) {
         token->eof() = true;
     } else if ( isdigit(c) || c == '.') {
-        inStream.putback(c);
+        putback();
         readNumber(false, token);
     } else if ( c == '-' ) {
         token->symbol('-');
     } else if ( isEqualityOperator(c) ) {
-        inStream.putback(c);
+        putback();
         token->relExp( readEqualityOperator() );
     } else if (c == '+' || c == '-' || c == '*' || c == '/' || c == '%' || c == ',' ||
                c == ';' || c == '(' || c == ')' || c == '{' || c == '}' || c == ':' || c == '[' || c == ']') {
         token->symbol(c);
      }
      else if ( c == '#' ) {
-         inStream.putback(c);
+         putback();
          consumeLine();
-         return getToken();
+         return nextToken();
      } else if ( c == '\'' || c == '"') {
-         inStream.putback(c);
+         putback();
          token->setString( readString() );
      } else if ( isalpha(c) || c == '_' ) {
-         inStream.putback(c);
-
-         std::string tokName = readName();
-         if (isKeyword(tokName)) {
-             token->setKeyword( tokName );
-         } else {
-             token->setName( tokName );
-         }
+         putback();
+
+         // Keywords never become a std::string - the kind comes straight from the buffer.
+         size_t end = _scan.identifierEnd(_source.data(), _pos, _source.size());
+         KeywordKind kind = keywordKind(_source.data() + _pos, end - _pos);
+         if ( kind != KW_NONE )
+             token->setKeyword( kind );
+         else
+             token->setName( _source.substr(_pos, end - _pos) );
+         _pos = end;
      } else if ( c == '\n' ) {
          startLine = true;
-         _numTabs = 0;
          _numSpace = 0;
          token->eol() = true;
 
      } else {
-         std::cout << "Unknown character in input. ->" << c << "<-\n";
-         exit(1); 
+         fatal(std::string("Unknown character in input. ->") + c + "<-\n");
      }
 
      _processedTokens.push_back(token);
-     return lastToken = token;
+     return token;
 }
 
 void Lexer::printProcessedTokens() {
-    int i = 0;
-    for (auto &&tok : _processedTokens) {
-        std::cout << i << ": ";
-        tok->print();
-        std::cout << std::endl;
-        i++;
+
+    // A running producer is ahead of the parser - stop it and list only what
+    // the parser has seen.
+    size_t count = _processedTokens.size();
+    if ( _pipeline ) {
+        count = _pipeline->consumed;
+        _pipeline.reset();
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        Script::out() << i << ": ";
+        _processedTokens[i]->print();
+        Script::out() << std::endl;
     }
 }
 
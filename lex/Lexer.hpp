@@ -6,14 +6,24 @@
 #include <memory>
 #include <stack>
 #include <queue>
+#include <optional>
+#include <thread>
+#include <atomic>
 
 #include "../Debug.hpp"
 #include "../Token.hpp"
+#include "Scan.hpp"
+#include "SpscRing.hpp"
 
 class Lexer {
 
 public:
     Lexer(std::ifstream &inStream);
+    explicit Lexer(std::string source);
+    // Replays previously lexed tokens, e.g. a lazily parsed function suite.
+    // A fatal message is printed, and the program exits, once the replay
+    // reaches the end of the tokens - where lexing originally failed.
+    Lexer(std::vector<std::shared_ptr<Token>> tokens, std::optional<std::string> fatal = std::nullopt);
 
     bool consumeLeadingSpaces();
     int spacesConsumedOnLine();
@@ -25,14 +35,32 @@ public:
 
     std::string readString();
 
-    std::string readEqualityOperator();
+    RelOpKind readEqualityOperator();
     std::string readName();
 
     std::shared_ptr<Token> getToken();
 
+    // Moves lexing onto a producer thread that runs ahead of the parser and
+    // hands tokens over through a lock-free ring. getToken() / ungetToken()
+    // keep their one token lookahead, and a lexical error still stops the
+    // program at the token where the serial Lexer would have stopped.
+    void startPipeline();
+
     void printProcessedTokens();
 
 private:
+    friend class ParallelLexer;
+
+    // A chunk lexer records each line's indentation in _lineStarts instead of
+    // producing INDENT/DEDENT, and keeps a lexical error in _fatal rather than
+    // exiting - ParallelLexer decides later whether the error is reached.
+    Lexer(std::string source, bool chunk);
+
+    void fatal(std::string message);
+
+    std::shared_ptr<Token> nextToken();
+
+    static bool indentationTokens(std::stack<int> &levels, int spaces, std::vector<std::shared_ptr<Token>> &out);
 
     std::shared_ptr<Token> lastToken;
     bool ungottenToken;
@@ -40,13 +68,46 @@ private:
     std::stack<int> pythonLexSpace;
     std::queue<std::shared_ptr<Token>> _tokens;
     std::vector<std::shared_ptr<Token>> _processedTokens;
-    std::ifstream &inStream;
     int tokIdx;
 
+    // The whole input, read up front so the scanning kernels can run over it.
+    // get() / putback() behave like the istream calls they replaced.
+    bool get(char &c);
+    void putback();
+
+    std::string _source;
+    size_t _pos;
+    bool _atEnd;
+    const ScanKernels &_scan;
+
     bool startLine;
-    int _numTabs;
     int _numSpace;
 
+    bool _chunk;
+    std::vector<std::pair<size_t, int>> _lineStarts;  // (token index, indentation)
+    std::optional<std::string> _fatal;
+    size_t _fatalAt;
+    bool _deferErrors;
+
+    // START "PIPELINE"
+    static constexpr size_t pipelineCapacity = 4096;
+
+    struct Pipeline {
+        Pipeline();
+        ~Pipeline();
+
+        SpscRing<std::shared_ptr<Token>> ring;  // null marks a lexical error
+        std::thread producer;
+        std::atomic<bool> stop;
+        size_t consumed;  // tokens the parser has taken from the ring
+    };
+
+    void produceTokens(Pipeline &pipeline);
+    std::shared_ptr<Token> pipelinedToken();
+
+    std::unique_ptr<Pipeline> _pipeline;
+    // END "PIPELINE"
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <unistd.h>
+
+#include "Lexer.hpp"
+#include "Scan.hpp"
+#include "ParallelLexer.hpp"
+
+// Lexer throughput benchmark - lexes a file to EOF with each scanning kernel
+// the CPU supports and reports MB/s, next to the MB/s of the kernels alone
+// (the same byte-class runs without building any Tokens). It then times
+// keyword recognition over every identifier in the file: the perfect hash
+// against the string comparison cascade the Lexer used before. Finally it
+// runs the ParallelLexer at increasing thread counts, checking that every
+// stream is token for token the serial one. Without an input file it
+// generates an identifier and indentation heavy program.
+//
+//     make lexbench.x && ./lexbench.x [file] [repetitions]
+
+static std::string generateSource() {
+    std::string src;
+    for (int i = 0; i < 20000; i++) {
+        std::string n = std::to_string(i);
+        src += "def function_number_" + n + "(first_argument, second_argument):\n";
+        src += "    accumulated_total_value = first_argument * 1234567 + second_argument\n";
+        src += "    if accumulated_total_value >= 100000 and second_argument != 0:\n";
+        src += "        print \"a string literal that is fairly long\", accumulated_total_value\n";
+        src += "    # a comment line that the lexer skips entirely\n";
+        src += "    return accumulated_total_value - 3.14159\n\n";
+    }
+    return src;
+}
+
+static size_t lexFile(const char *path) {
+    std::ifstream in(path);
+    Lexer lex(in);
+
+    size_t tokens = 0;
+    while ( !lex.getToken()->eof() )
+        tokens++;
+    return tokens;
+}
+
+// Walks the buffer the way the Lexer does - runs of spaces, names, digits and
+// comments - but only counts the runs.
+static size_t scanOnly(const ScanKernels &scan, const std::string &src) {
+    size_t runs = 0, pos = 0, size = src.size();
+    const char *data = src.data();
+
+    while ( pos < size ) {
+        char c = data[pos];
+        if ( c == ' ' || c == '\t' )
+            pos = scan.indentEnd(data, pos, size);
+        else if ( isalpha(c) || c == '_' )
+            pos = scan.identifierEnd(data, pos, size);
+        else if ( isdigit(c) )
+            pos = scan.digitEnd(data, pos, size);
+        else if ( c == '#' || c == '"' )
+            pos = scan.find(data, pos + 1, size, c == '#' ? '\n' : '"') + 1;
+        else
+            pos++;
+        runs++;
+    }
+    return runs;
+}
+
+// The Lexer's original keyword test, kept as the baseline.
+static bool isKeywordCascade(std::string s) {
+    return (s == "for" || s == "print" || s == "if" || s == "else" || s == "elif" ||
+            s == "def" || s == "and" || s == "or" || s == "while" || s == "not" || s == "in" ||
+            s == "range" || s == "len" || s == "return" );
+}
+
+static void benchKeywords(const std::string &src, int repetitions) {
+
+    std::vector<std::string> identifiers;
+    const ScanKernels &scan = scanKernels();
+    for (size_t pos = 0; pos < src.size(); ) {
+        size_t end = scan.identifierEnd(src.data(), pos, src.size());
+        if ( end > pos && !isdigit(src[pos]) )
+            identifiers.push_back(src.substr(pos, end - pos));
+        pos = end > pos ? end : pos + 1;
+    }
+
+    size_t cascadeHits = 0, hashHits = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (auto &id : identifiers)
+            cascadeHits += isKeywordCascade(id);
+    std::chrono::duration<double> cascade = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (auto &id : identifiers)
+            hashHits += keywordKind(id.data(), id.size()) != KW_NONE;
+    std::chrono::duration<double> hash = std::chrono::steady_clock::now() - start;
+
+    double lookups = (double) identifiers.size() * repetitions;
+    std::cout << "keywords: " << identifiers.size() << " identifiers, "
+              << cascadeHits / repetitions << " / " << hashHits / repetitions << " keywords, "
+              << "cascade " << cascade.count() * 1e9 / lookups << " ns, "
+              << "perfect hash " << hash.count() * 1e9 / lookups << " ns per identifier" << std::endl;
+}
+
+static bool sameToken(const Token &a, const Token &b) {
+    return a.eof() == b.eof() && a.eol() == b.eol() &&
+           a.keywordKind() == b.keywordKind() && a.relOpKind() == b.relOpKind() &&
+           a.symbol() == b.symbol() &&
+           a.getName() == b.getName() && a.getString() == b.getString() &&
+           a.isFloat() == b.isFloat() && a.getFloat() == b.getFloat() &&
+           a.isWholeNumber() == b.isWholeNumber() && a.getWholeNumber() == b.getWholeNumber();
+}
+
+static std::vector<std::shared_ptr<Token>> drain(Lexer &lex) {
+    std::vector<std::shared_ptr<Token>> tokens;
+    do {
+        tokens.push_back(lex.getToken());
+    } while ( !tokens.back()->eof() );
+    return tokens;
+}
+
+static void benchParallel(const std::string &path, const std::string &source, int repetitions) {
+
+    std::ifstream in(path);
+    Lexer serialLexer(in);
+    auto serial = drain(serialLexer);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= std::max(cores, 4u); threads *= 2) {
+        ParallelLexer parallel(threads, 64 * 1024);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) {
+            std::optional<std::string> fatal;
+            parallel.tokenize(source, fatal);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        Lexer replay = parallel.lex(source);
+        auto tokens = drain(replay);
+        bool same = tokens.size() == serial.size();
+        for (size_t i = 0; same && i < tokens.size(); i++)
+            same = sameToken(*tokens[i], *serial[i]);
+
+        std::cout << "parallel " << threads << " threads: "
+                  << source.size() / (1024.0 * 1024.0) * repetitions / elapsed.count() << " MB/s, "
+                  << (same ? "identical to serial" : "DIFFERS FROM SERIAL") << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    std::string path;
+    bool generated = argc < 2;
+
+    if ( generated ) {
+        path = "/tmp/lexbench." + std::to_string(getpid()) + ".txt";
+        std::ofstream out(path);
+        out << generateSource();
+    } else {
+        path = argv[1];
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 5;
+
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    std::string source = contents.str();
+    double megabytes = source.size() / (1024.0 * 1024.0);
+
+    std::cout << "Lexing " << path << " (" << megabytes << " MB) x " << repetitions << std::endl;
+
+    for (auto name : { "scalar", "sse2", "avx2" }) {
+        const ScanKernels *kernels = scanKernelsNamed(name);
+        if ( kernels == nullptr ) {
+            std::cout << name << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+        selectScanKernels(*kernels);
+
+        size_t tokens = lexFile(path.c_str());   // warm up
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++)
+            lexFile(path.c_str());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        size_t runs = 0;
+        for (int i = 0; i < repetitions * 20; i++)
+            runs += scanOnly(*kernels, source);
+        std::chrono::duration<double> scanElapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << name << ": " << tokens << " tokens, "
+                  << megabytes * repetitions / elapsed.count() << " MB/s lexing, "
+                  << megabytes * repetitions * 20 / scanElapsed.count() << " MB/s scanning ("
+                  << runs / (repetitions * 20) << " runs)" << std::endl;
+    }
+
+    selectScanKernels(*scanKernelsNamed("scalar"));
+    benchKeywords(source, repetitions);
+
+    selectScanKernels(scanKernels());
+    benchParallel(path, source, repetitions);
+
+    if ( generated )
+        unlink(path.c_str());
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <iostream>
+#include <stack>
+#include <thread>
+
+#include "ParallelLexer.hpp"
+
+ParallelLexer::ParallelLexer(unsigned threads, size_t minChunkBytes):
+    _threads{threads == 0 ? 1 : threads},
+    _minChunkBytes{minChunkBytes == 0 ? 1 : minChunkBytes}
+{}
+
+Lexer ParallelLexer::lex(const std::string &source) {
+    std::optional<std::string> fatal;
+    auto tokens = tokenize(source, fatal);
+    return Lexer(std::move(tokens), fatal);
+}
+
+// Safe cut points follow a newline that is neither inside a string literal
+// nor ends one - the same quote / comment rules the Lexer applies.
+std::vector<size_t> ParallelLexer::splitPoints(const std::string &source) {
+
+    size_t chunkBytes = std::max(_minChunkBytes, source.size() / (_threads * 4) + 1);
+    std::vector<size_t> points = { 0 };
+
+    char quote = '\0';
+    bool comment = false;
+
+    for (size_t i = 0; i < source.size(); i++) {
+        char c = source[i];
+
+        if ( quote != '\0' ) {
+            if ( c == quote )
+                quote = '\0';
+        } else if ( comment ) {
+            comment = c != '\n';
+        } else if ( c == '#' ) {
+            comment = true;
+        } else if ( c == '"' || c == '\'' ) {
+            quote = c;
+        }
+
+        if ( c == '\n' && quote == '\0' && i + 1 - points.back() >= chunkBytes && i + 1 < source.size() )
+            points.push_back(i + 1);
+    }
+
+    points.push_back(source.size());
+    return points;
+}
+
+void ParallelLexer::lexChunk(const std::string &source, Chunk &chunk, bool last) {
+
+    Lexer lexer(source.substr(chunk.begin, chunk.end - chunk.begin), true);
+
+    while ( !lexer._fatal && !lexer.getToken()->eof() )
+        ;
+
+    chunk.tokens = std::move(lexer._processedTokens);
+    chunk.lineStarts = std::move(lexer._lineStarts);
+    chunk.fatal = lexer._fatal;
+
+    if ( chunk.fatal ) {
+        chunk.tokens.resize(lexer._fatalAt);
+    } else if ( !last ) {
+        // Every chunk but the last stops at the start of a line - drop that
+        // line start and the EOF the chunk's end produced.
+        chunk.tokens.pop_back();
+        while ( !chunk.lineStarts.empty() && chunk.lineStarts.back().first >= chunk.tokens.size() )
+            chunk.lineStarts.pop_back();
+    }
+}
+
+std::vector<std::shared_ptr<Token>> ParallelLexer::tokenize(const std::string &source, std::optional<std::string> &fatal) {
+
+    auto points = splitPoints(source);
+
+    std::vector<Chunk> chunks(points.size() - 1);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunks[i].begin = points[i];
+        chunks[i].end = points[i + 1];
+    }
+
+    if (debug)
+        std::cout << "ParallelLexer::tokenize - " << chunks.size() << " chunks" << std::endl;
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] () {
+        for (size_t i = next++; i < chunks.size(); i = next++)
+            lexChunk(source, chunks[i], i + 1 == chunks.size());
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < std::min<size_t>(_threads, chunks.size()); t++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &thread : pool)
+        thread.join();
+
+    // Fix-up: stitch the chunks, running the indentation stack at every line
+    // start exactly where the serial Lexer would.
+    std::vector<std::shared_ptr<Token>> tokens;
+    std::stack<int> levels({0});
+
+    for (auto &chunk : chunks) {
+        size_t line = 0;
+
+        for (size_t i = 0; i <= chunk.tokens.size(); i++) {
+            for (; line < chunk.lineStarts.size() && chunk.lineStarts[line].first == i; line++) {
+                size_t before = tokens.size();
+                if ( !Lexer::indentationTokens(levels, chunk.lineStarts[line].second, tokens) ) {
+                    tokens.resize(before);
+                    fatal = "Fatal Error in Lex::getToken()..couldn't parse spaces\n";
+                    return tokens;
+                }
+            }
+
+            if ( i < chunk.tokens.size() )
+                tokens.push_back(std::move(chunk.tokens[i]));
+        }
+
+        if ( chunk.fatal ) {
+            fatal = chunk.fatal;
+            return tokens;
+        }
+    }
+
+    return tokens;
+}
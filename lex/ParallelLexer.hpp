@@ -0,0 +1,44 @@
+#ifndef __PARALLEL_LEXER_HPP
+#define __PARALLEL_LEXER_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Lexer.hpp"
+
+// Lexes a large source concurrently. The buffer is cut into chunks at line
+// ends that are outside string literals and comments, each chunk is lexed by
+// a chunk Lexer on a small pool of threads, and a serial fix-up pass runs the
+// indentation stack over the recorded line starts to insert INDENT / DEDENT -
+// the only state that crosses lines. The result is token for token what the
+// serial Lexer produces, including where a lexical error is reported.
+
+class ParallelLexer {
+
+public:
+    // Chunks are at least minChunkBytes long, so small sources use one chunk.
+    ParallelLexer(unsigned threads, size_t minChunkBytes = 256 * 1024);
+
+    // A replaying Lexer over the stitched token stream.
+    Lexer lex(const std::string &source);
+
+    std::vector<std::shared_ptr<Token>> tokenize(const std::string &source, std::optional<std::string> &fatal);
+
+private:
+    struct Chunk {
+        size_t begin, end;
+        std::vector<std::shared_ptr<Token>> tokens;
+        std::vector<std::pair<size_t, int>> lineStarts;
+        std::optional<std::string> fatal;
+    };
+
+    std::vector<size_t> splitPoints(const std::string &source);
+    void lexChunk(const std::string &source, Chunk &chunk, bool last);
+
+    unsigned _threads;
+    size_t _minChunkBytes;
+};
+
+#endif
@@ -0,0 +1,238 @@
+#include <atomic>
+
+#include "Scan.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
+
+// START "SCALAR"
+static inline bool isIdentifierByte(unsigned char c) {
+    return c == '_' || (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z');
+}
+
+static size_t scalarSpaceEnd(const char *src, size_t pos, size_t size) {
+    while ( pos < size && src[pos] == ' ' )
+        pos++;
+    return pos;
+}
+
+static size_t scalarIndentEnd(const char *src, size_t pos, size_t size) {
+    while ( pos < size && (src[pos] == ' ' || src[pos] == '\t') )
+        pos++;
+    return pos;
+}
+
+static size_t scalarIdentifierEnd(const char *src, size_t pos, size_t size) {
+    while ( pos < size && isIdentifierByte(src[pos]) )
+        pos++;
+    return pos;
+}
+
+static size_t scalarDigitEnd(const char *src, size_t pos, size_t size) {
+    while ( pos < size && src[pos] >= '0' && src[pos] <= '9' )
+        pos++;
+    return pos;
+}
+
+static size_t scalarFind(const char *src, size_t pos, size_t size, char c) {
+    while ( pos < size && src[pos] != c )
+        pos++;
+    return pos;
+}
+// END "SCALAR"
+
+#ifdef SCAN_X86
+
+// Each vector kernel builds a byte mask of the bytes that continue the run;
+// the first zero bit of the movemask is the end of the run.
+
+// START "SSE2"
+static inline __m128i rangeMask128(__m128i v, char low, char count) {
+    __m128i d = _mm_sub_epi8(v, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(count)), d);
+}
+
+static inline __m128i spaceMask128(__m128i v) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+}
+
+static inline __m128i indentMask128(__m128i v) {
+    return _mm_or_si128(spaceMask128(v), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+}
+
+static inline __m128i digitMask128(__m128i v) {
+    return rangeMask128(v, '0', 9);
+}
+
+static inline __m128i identifierMask128(__m128i v) {
+    __m128i letters = rangeMask128(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 25);
+    __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(letters, digitMask128(v)), underscore);
+}
+
+#define SSE2_RUN_END(maskFn, scalarFn)                                           \
+    while ( pos + 16 <= size ) {                                                 \
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pos)); \
+        unsigned stop = ~_mm_movemask_epi8(maskFn(v)) & 0xFFFF;                  \
+        if ( stop )                                                              \
+            return pos + __builtin_ctz(stop);                                    \
+        pos += 16;                                                               \
+    }                                                                            \
+    return scalarFn(src, pos, size);
+
+static size_t sse2SpaceEnd(const char *src, size_t pos, size_t size) {
+    SSE2_RUN_END(spaceMask128, scalarSpaceEnd)
+}
+
+static size_t sse2IndentEnd(const char *src, size_t pos, size_t size) {
+    SSE2_RUN_END(indentMask128, scalarIndentEnd)
+}
+
+static size_t sse2IdentifierEnd(const char *src, size_t pos, size_t size) {
+    SSE2_RUN_END(identifierMask128, scalarIdentifierEnd)
+}
+
+static size_t sse2DigitEnd(const char *src, size_t pos, size_t size) {
+    SSE2_RUN_END(digitMask128, scalarDigitEnd)
+}
+
+static size_t sse2Find(const char *src, size_t pos, size_t size, char c) {
+    __m128i needle = _mm_set1_epi8(c);
+    while ( pos + 16 <= size ) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pos));
+        unsigned hit = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if ( hit )
+            return pos + __builtin_ctz(hit);
+        pos += 16;
+    }
+    return scalarFind(src, pos, size, c);
+}
+// END "SSE2"
+
+// START "AVX2"
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static inline __m256i rangeMask256(__m256i v, char low, char count) {
+    __m256i d = _mm256_sub_epi8(v, _mm256_set1_epi8(low));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(count)), d);
+}
+
+AVX2 static inline __m256i spaceMask256(__m256i v) {
+    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+}
+
+AVX2 static inline __m256i indentMask256(__m256i v) {
+    return _mm256_or_si256(spaceMask256(v), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+}
+
+AVX2 static inline __m256i digitMask256(__m256i v) {
+    return rangeMask256(v, '0', 9);
+}
+
+AVX2 static inline __m256i identifierMask256(__m256i v) {
+    __m256i letters = rangeMask256(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 25);
+    __m256i underscore = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+    return _mm256_or_si256(_mm256_or_si256(letters, digitMask256(v)), underscore);
+}
+
+#define AVX2_RUN_END(maskFn, sse2Fn)                                                 \
+    while ( pos + 32 <= size ) {                                                     \
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + pos)); \
+        unsigned stop = ~(unsigned) _mm256_movemask_epi8(maskFn(v));                 \
+        if ( stop )                                                                  \
+            return pos + __builtin_ctz(stop);                                        \
+        pos += 32;                                                                   \
+    }                                                                                \
+    return sse2Fn(src, pos, size);
+
+AVX2 static size_t avx2SpaceEnd(const char *src, size_t pos, size_t size) {
+    AVX2_RUN_END(spaceMask256, sse2SpaceEnd)
+}
+
+AVX2 static size_t avx2IndentEnd(const char *src, size_t pos, size_t size) {
+    AVX2_RUN_END(indentMask256, sse2IndentEnd)
+}
+
+AVX2 static size_t avx2IdentifierEnd(const char *src, size_t pos, size_t size) {
+    AVX2_RUN_END(identifierMask256, sse2IdentifierEnd)
+}
+
+AVX2 static size_t avx2DigitEnd(const char *src, size_t pos, size_t size) {
+    AVX2_RUN_END(digitMask256, sse2DigitEnd)
+}
+
+AVX2 static size_t avx2Find(const char *src, size_t pos, size_t size, char c) {
+    __m256i needle = _mm256_set1_epi8(c);
+    while ( pos + 32 <= size ) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + pos));
+        unsigned hit = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if ( hit )
+            return pos + __builtin_ctz(hit);
+        pos += 32;
+    }
+    return sse2Find(src, pos, size, c);
+}
+// END "AVX2"
+
+#endif
+
+static const ScanKernels scalarKernels = {
+    "scalar", scalarSpaceEnd, scalarIndentEnd, scalarIdentifierEnd, scalarDigitEnd, scalarFind
+};
+
+#ifdef SCAN_X86
+static const ScanKernels sse2Kernels = {
+    "sse2", sse2SpaceEnd, sse2IndentEnd, sse2IdentifierEnd, sse2DigitEnd, sse2Find
+};
+
+static const ScanKernels avx2Kernels = {
+    "avx2", avx2SpaceEnd, avx2IndentEnd, avx2IdentifierEnd, avx2DigitEnd, avx2Find
+};
+#endif
+
+const ScanKernels *scanKernelsNamed(std::string name) {
+
+    if ( name == "scalar" )
+        return &scalarKernels;
+
+#ifdef SCAN_X86
+    // SSE2 is part of the x86-64 baseline; AVX2 needs the CPUID bit (and OS
+    // support for the ymm state, which __builtin_cpu_supports also checks).
+    if ( name == "sse2" )
+        return &sse2Kernels;
+
+    __builtin_cpu_init();
+    if ( name == "avx2" && __builtin_cpu_supports("avx2") )
+        return &avx2Kernels;
+#endif
+
+    return nullptr;
+}
+
+static const ScanKernels *bestKernels() {
+    for (auto name : { "avx2", "sse2" }) {
+        if ( auto kernels = scanKernelsNamed(name) )
+            return kernels;
+    }
+    return &scalarKernels;
+}
+
+// Lexers on several threads may ask at once. The first to find nothing
+// selected installs the best kernels, unless --simd got there first.
+static std::atomic<const ScanKernels *> selectedKernels{nullptr};
+
+const ScanKernels &scanKernels() {
+    auto kernels = selectedKernels.load(std::memory_order_acquire);
+    if ( kernels == nullptr ) {
+        auto best = bestKernels();
+        if ( selectedKernels.compare_exchange_strong(kernels, best, std::memory_order_acq_rel) )
+            kernels = best;
+    }
+    return *kernels;
+}
+
+void selectScanKernels(const ScanKernels &kernels) {
+    selectedKernels.store(&kernels, std::memory_order_release);
+}
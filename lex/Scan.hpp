@@ -0,0 +1,33 @@
+#ifndef __SCAN_HPP
+#define __SCAN_HPP
+
+#include <cstddef>
+#include <string>
+
+// Byte-class scanning kernels used by the Lexer once the source sits in one
+// contiguous buffer. Every kernel looks at src[pos, size) and returns the
+// index of the first byte that ends the run - or size if the run reaches the
+// end of the buffer.
+//
+// There is a scalar, an SSE2 (16 bytes at a time) and an AVX2 (32 bytes at a
+// time) implementation; the best one the CPU supports is picked at start up.
+
+struct ScanKernels {
+    const char *name;
+
+    size_t (*spaceEnd)(const char *src, size_t pos, size_t size);      // ' '
+    size_t (*indentEnd)(const char *src, size_t pos, size_t size);     // ' ' '\t'
+    size_t (*identifierEnd)(const char *src, size_t pos, size_t size); // [A-Za-z0-9_]
+    size_t (*digitEnd)(const char *src, size_t pos, size_t size);      // [0-9]
+    size_t (*find)(const char *src, size_t pos, size_t size, char c);  // first c
+};
+
+// The kernels the Lexer uses.
+const ScanKernels &scanKernels();
+
+// Returns the named kernels ("scalar", "sse2" or "avx2") or nullptr if this
+// CPU can't run them. Used by the benchmark to compare implementations.
+const ScanKernels *scanKernelsNamed(std::string name);
+void selectScanKernels(const ScanKernels &kernels);
+
+#endif
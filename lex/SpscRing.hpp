@@ -0,0 +1,51 @@
+#ifndef __SPSC_RING_HPP
+#define __SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free single producer / single consumer ring buffer. The producer only
+// writes _head and the consumer only writes _tail; each reads the other's
+// index with acquire ordering, so a slot is published before its index moves.
+// Capacity must be a power of two.
+
+template <typename T>
+class SpscRing {
+
+public:
+    SpscRing(size_t capacity):
+        _slots(capacity),
+        _mask{capacity - 1}
+    {}
+
+    bool tryPush(const T &value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if ( head - _tail.load(std::memory_order_acquire) == _slots.size() )
+            return false;
+
+        _slots[head & _mask] = value;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if ( tail == _head.load(std::memory_order_acquire) )
+            return false;
+
+        value = std::move(_slots[tail & _mask]);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> _slots;
+    size_t _mask;
+
+    // Kept on separate cache lines so the two threads don't false share.
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef __TOKEN_KINDS_HPP
+#define __TOKEN_KINDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Integer kinds for keywords and relational operators. Tokens still carry the
+// spelling for printing, but every is*() test compares these kinds.
+//
+// Keywords are recognized with a perfect hash over (length, first byte, last
+// byte) whose multipliers are searched for at compile time; relational
+// operators by a table-driven maximal-munch DFA.
+
+enum KeywordKind : uint8_t {
+    KW_NONE = 0,
+    KW_FOR, KW_PRINT, KW_IF, KW_ELSE, KW_ELIF, KW_DEF, KW_AND, KW_OR,
+    KW_WHILE, KW_NOT, KW_IN, KW_RANGE, KW_LEN, KW_RETURN,
+
+    // Produced by the Lexer itself, never by keywordKind().
+    KW_INDENT, KW_DEDENT, KW_PERIOD,
+
+    KW_COUNT
+};
+
+constexpr const char *keywordNames[KW_COUNT] = {
+    "",
+    "for", "print", "if", "else", "elif", "def", "and", "or",
+    "while", "not", "in", "range", "len", "return",
+    "INDENT", "DEDENT", "."
+};
+
+enum RelOpKind : uint8_t {
+    REL_NONE = 0,
+    REL_ASSIGN, REL_EQ, REL_LT, REL_LTE, REL_EQML, REL_GT, REL_GTE, REL_NOT_EQ,
+
+    REL_COUNT
+};
+
+constexpr const char *relOpNames[REL_COUNT] = {
+    "", "=", "==", "<", "<=", "<>", ">", ">=", "!="
+};
+
+// START "KEYWORD HASH"
+constexpr size_t keywordMinLength = 2;
+constexpr size_t keywordMaxLength = 6;
+constexpr unsigned keywordSlots = 32;
+
+constexpr size_t constLength(const char *s) {
+    size_t n = 0;
+    while ( s[n] != '\0' )
+        n++;
+    return n;
+}
+
+constexpr unsigned keywordHash(const char *s, size_t n, unsigned a, unsigned b) {
+    return (n + (unsigned char) s[0] * a + (unsigned char) s[n - 1] * b) & (keywordSlots - 1);
+}
+
+struct KeywordTable {
+    unsigned a, b;
+    uint8_t slot[keywordSlots];
+};
+
+constexpr KeywordTable buildKeywordTable() {
+    for (unsigned a = 1; a < 64; a++) {
+        for (unsigned b = 1; b < 64; b++) {
+            KeywordTable table{ a, b, {} };
+            bool perfect = true;
+
+            for (int k = KW_FOR; k <= KW_RETURN && perfect; k++) {
+                unsigned h = keywordHash(keywordNames[k], constLength(keywordNames[k]), a, b);
+                if ( table.slot[h] != KW_NONE )
+                    perfect = false;
+                table.slot[h] = k;
+            }
+
+            if ( perfect )
+                return table;
+        }
+    }
+    return KeywordTable{ 0, 0, {} };
+}
+
+constexpr KeywordTable keywordTable = buildKeywordTable();
+static_assert(keywordTable.a != 0, "no collision free keyword hash - widen the search or keywordSlots");
+
+// One table probe and at most one comparison per identifier.
+inline KeywordKind keywordKind(const char *s, size_t n) {
+    if ( n < keywordMinLength || n > keywordMaxLength )
+        return KW_NONE;
+
+    auto kind = static_cast<KeywordKind>(keywordTable.slot[keywordHash(s, n, keywordTable.a, keywordTable.b)]);
+    const char *name = keywordNames[kind];
+
+    for (size_t i = 0; i < n; i++) {
+        if ( name[i] != s[i] )
+            return KW_NONE;
+    }
+    return name[n] == '\0' ? kind : KW_NONE;
+}
+// END "KEYWORD HASH"
+
+// START "RELOP DFA"
+// Input classes: 0 other, 1 '=', 2 '<', 3 '>', 4 '!'
+constexpr int relOpClass(char c) {
+    return c == '=' ? 1 : c == '<' ? 2 : c == '>' ? 3 : c == '!' ? 4 : 0;
+}
+
+enum RelOpState { S_START, S_EQ, S_EQEQ, S_LT, S_LTE, S_LTGT, S_GT, S_GTE, S_BANG, S_BANGEQ, S_INVALID, S_COUNT };
+
+// -1 stops the munch; S_INVALID is "=<" / "=>", which the language rejects.
+constexpr int relOpTransitions[S_COUNT][5] = {
+    /* S_START   */ { -1, S_EQ,  S_LT,      S_GT,      S_BANG },
+    /* S_EQ      */ { -1, S_EQEQ, S_INVALID, S_INVALID, -1 },
+    /* S_EQEQ    */ { -1, -1,    -1,        -1,        -1 },
+    /* S_LT      */ { -1, S_LTE, -1,        S_LTGT,    -1 },
+    /* S_LTE     */ { -1, -1,    -1,        -1,        -1 },
+    /* S_LTGT    */ { -1, -1,    -1,        -1,        -1 },
+    /* S_GT      */ { -1, S_GTE, -1,        -1,        -1 },
+    /* S_GTE     */ { -1, -1,    -1,        -1,        -1 },
+    /* S_BANG    */ { -1, S_BANGEQ, -1,     -1,        -1 },
+    /* S_BANGEQ  */ { -1, -1,    -1,        -1,        -1 },
+    /* S_INVALID */ { -1, -1,    -1,        -1,        -1 },
+};
+
+// REL_NONE for states that may not end an operator.
+constexpr RelOpKind relOpAccept[S_COUNT] = {
+    REL_NONE, REL_ASSIGN, REL_EQ, REL_LT, REL_LTE, REL_EQML, REL_GT, REL_GTE, REL_NONE, REL_NOT_EQ, REL_NONE
+};
+// END "RELOP DFA"
+
+#endif
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <sstream>
 #include <sys/time.h>
 #include <sys/resource.h>
 
@@ -8,7 +9,20 @@
 #include "Debug.hpp"
 
 #include "./lex/Lexer.hpp"
+#include "./lex/ParallelLexer.hpp"
 #include "./statements/Statement.hpp"
+#include "./jit/Jit.hpp"
+#include "./aot/Transpiler.hpp"
+#include "./cache/AstCache.hpp"
+#include "./opt/LoopHoister.hpp"
+#include "./opt/DeadCode.hpp"
+#include "./opt/ValueNumbering.hpp"
+#include "./builtins/Kernels.hpp"
+#include "./parallel/WorkPool.hpp"
+#include "./parallel/Batch.hpp"
+#include "./serve/Server.hpp"
+#include "./serve/ForkServer.hpp"
+#include "./serve/Client.hpp"
 
 long getMemoryUsage() 
 {
@@ -19,18 +33,140 @@ long getMemoryUsage()
     return 0;
 }
 
+void usage(char *program) {
+    std::cout << "usage: " << program << " [--jit] [--opt | --opt-debug] [--lazy | --cache directory] [--aot executable] [--parallel-lex threads [--lex-chunk bytes]] [--pipeline-lex] [--stream] [--simd scalar|sse2|avx2] [--threads N] nameOfAnInputFile\n";
+    std::cout << "       " << program << " --batch [--lazy] [--simd scalar|sse2|avx2] [--threads N] [--out directory] script|directory...\n";
+    std::cout << "       " << program << " --serve socket [--prelude file] [--lazy] [--simd scalar|sse2|avx2] [--threads N]\n";
+    std::cout << "       " << program << " --client socket nameOfAnInputFile\n";
+    exit(1);
+}
+
 int main(int argc, char *argv[]) {
 
-    if( argc != 2) {
-        std::cout << "usage: " << argv[0] << " nameOfAnInputFile\n";
-        exit(1);
+    bool useJit = false;
+    bool lazyFunctions = false;
+    char *aotExecutable = nullptr;
+    char *cacheDirectory = nullptr;
+    unsigned lexThreads = 0;
+    size_t lexChunkBytes = 256 * 1024;
+    bool pipelineLex = false;
+    bool streamStatements = false;
+    char *inputFile = nullptr;
+    bool batch = false;
+    char *outputDirectory = nullptr;
+    std::vector<std::string> batchPaths;
+    unsigned threads = 0;
+    char *serveSocket = nullptr;
+    char *clientSocket = nullptr;
+    char *preludeFile = nullptr;
+    bool optimize = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if ( arg == "--jit" )
+            useJit = true;
+        else if ( arg == "--opt" )
+            optimize = true;
+        else if ( arg == "--opt-debug" )
+            optimize = optDebug = true;
+        else if ( arg == "--lazy" )
+            lazyFunctions = true;
+        else if ( arg == "--aot" && i + 1 < argc )
+            aotExecutable = argv[++i];
+        else if ( arg == "--cache" && i + 1 < argc )
+            cacheDirectory = argv[++i];
+        else if ( arg == "--parallel-lex" && i + 1 < argc )
+            lexThreads = atoi(argv[++i]);
+        else if ( arg == "--lex-chunk" && i + 1 < argc )
+            lexChunkBytes = atol(argv[++i]);
+        else if ( arg == "--pipeline-lex" )
+            pipelineLex = true;
+        else if ( arg == "--stream" )
+            streamStatements = true;
+        else if ( arg == "--simd" && i + 1 < argc ) {
+            // Caps the reduction kernels - the best the CPU has is the default.
+            std::string level = argv[++i];
+            if ( level == "scalar" )
+                Kernels::setLevel(Kernels::SCALAR);
+            else if ( level == "sse2" )
+                Kernels::setLevel(Kernels::SSE2);
+            else if ( level == "avx2" )
+                Kernels::setLevel(Kernels::AVX2);
+            else
+                usage(argv[0]);
+        }
+        else if ( arg == "--threads" && i + 1 < argc ) {
+            // prange workers, or --serve's - one per core by default.
+            threads = atoi(argv[++i]);
+            WorkPool::setThreads(threads);
+        }
+        else if ( arg == "--serve" && i + 1 < argc )
+            serveSocket = argv[++i];
+        else if ( arg == "--prelude" && i + 1 < argc )
+            preludeFile = argv[++i];
+        else if ( arg == "--client" && i + 1 < argc )
+            clientSocket = argv[++i];
+        else if ( arg == "--batch" )
+            batch = true;
+        else if ( arg == "--out" && i + 1 < argc )
+            outputDirectory = argv[++i];
+        else if ( batch )
+            batchPaths.push_back(argv[i]);
+        else if ( inputFile == nullptr )
+            inputFile = argv[i];
+        else
+            usage(argv[0]);
+    }
+
+    // Batch jobs and served scripts end by unwinding on a fatal error, which
+    // native code from the JIT can't do; the other modes need a whole
+    // process to themselves, and --opt rewrites only the tree parsed here.
+    bool processModes = useJit || aotExecutable != nullptr || cacheDirectory != nullptr || lexThreads > 0 || pipelineLex || streamStatements || optimize;
+
+    if ( serveSocket != nullptr ) {
+        if ( processModes || batch || clientSocket != nullptr || inputFile != nullptr || outputDirectory != nullptr )
+            usage(argv[0]);
+        if ( preludeFile != nullptr )
+            return ForkServer(serveSocket, preludeFile, lazyFunctions).serve();
+        return Server(serveSocket, threads, lazyFunctions).serve();
+    }
+
+    if ( preludeFile != nullptr )
+        usage(argv[0]);
+
+    // The cache stores whole function bodies, which --lazy leaves unparsed.
+    if ( lazyFunctions && cacheDirectory != nullptr )
+        usage(argv[0]);
+
+    if ( clientSocket != nullptr ) {
+        if ( processModes || batch || inputFile == nullptr || outputDirectory != nullptr )
+            usage(argv[0]);
+        return Client::submit(clientSocket, inputFile);
     }
 
+    if ( batch ) {
+        if ( batchPaths.empty() || inputFile != nullptr || processModes )
+            usage(argv[0]);
+
+        Batch runner(lazyFunctions);
+        for (auto &path : batchPaths)
+            runner.add(path);
+
+        size_t failed = runner.run(outputDirectory);
+        if ( failed > 0 )
+            std::cerr << failed << " of the scripts failed" << std::endl;
+        return failed > 0 ? 1 : 0;
+    }
+
+    if( inputFile == nullptr || outputDirectory != nullptr )
+        usage(argv[0]);
+
     std::ifstream inputStream;
 
-    inputStream.open(argv[1], std::ios::in);
+    inputStream.open(inputFile, std::ios::in);
     if( ! inputStream.is_open() ) {
-        std::cout << "Unable top open " << argv[1] << ". Terminating...";
+        std::cout << "Unable top open " << inputFile << ". Terminating...";
         perror("Error when attempting to open the input file.");
         exit(2);
     }
@@ -38,24 +174,101 @@ int main(int argc, char *argv[]) {
 
 
 
+    // With a cache directory, a warm start rebuilds the tree from the cached
+    // image and never touches the Lexer or Parser.
+    std::string source;
+    std::unique_ptr<Statements> stmts;
+    bool haveSource = cacheDirectory != nullptr || lexThreads > 0;
+    if ( haveSource ) {
+        std::stringstream contents;
+        contents << inputStream.rdbuf();
+        source = contents.str();
+    }
+
+    if ( cacheDirectory != nullptr )
+        stmts = AstCache(cacheDirectory).load(source);
+
     SymTab symTab;
-    Lexer lex = Lexer(inputStream);
 
-    // auto tok = lex.getToken();
+    if ( stmts == nullptr ) {
+        // The file is read only once - a source already in hand is lexed as is.
+        Lexer lex = lexThreads > 0 ? ParallelLexer(lexThreads, lexChunkBytes).lex(source)
+                  : haveSource ? Lexer(source) : Lexer(inputStream);
+
+        // auto tok = lex.getToken();
+
+        // while ( !tok->eof() ) {
+        //   tok->print();
+        //   tok = lex.getToken();
+        //   std::cout << std::endl;
+        // }
+
+        // The lexer thread runs ahead while the parser builds the tree.
+        if ( pipelineLex )
+            lex.startPipeline();
+
+        Parser parser(lex, lazyFunctions);
+
+        // Streaming runs each top-level statement as soon as it is parsed and
+        // frees it afterwards - only defs are kept, for the debug dump. The
+        // cache and the transpiler need the whole tree, so they don't stream.
+        if ( streamStatements && cacheDirectory == nullptr && aotExecutable == nullptr ) {
+            stmts = std::make_unique<Statements>();
+
+            while ( auto stmt = parser.next_stmt() ) {
+                if (useJit)
+                    JitCompiler::attachStatement(stmt.get());
+                // DeadCode needs the rest of the program, so only the
+                // statement itself is optimized here.
+                if (optimize) {
+                    LoopHoister::attachStatement(stmt.get());
+                    ValueNumbering::attachStatement(stmt.get());
+                }
+
+                stmt->evaluate(symTab);
+
+                if ( dynamic_cast<FunctionDefinition *>(stmt.get()) != nullptr )
+                    stmts->addStatement(std::move(stmt));
+            }
 
-    // while ( !tok->eof() ) {
-    //   tok->print();
-    //   tok = lex.getToken();
-    //   std::cout << std::endl;
-    // }
-    Parser parser(lex);
-    // std::unique_ptr<GroupedStatements> stmts =  parser.file_input();
-    auto stmts = parser.file_input();
+            if (debug)
+                stmts->dumpAST("");
+            return 0;
+        }
+
+        // std::unique_ptr<GroupedStatements> stmts =  parser.file_input();
+        stmts = parser.file_input();
+
+        // Stored as parsed - the optimizer's and the JIT's nodes have no
+        // cached form.
+        if ( cacheDirectory != nullptr )
+            AstCache(cacheDirectory).store(source, *stmts);
+    }
+
+    if ( aotExecutable != nullptr ) {
+        Transpiler transpiler;
+        return transpiler.compile(*stmts, aotExecutable) == 0 ? 0 : 1;
+    }
+
+    // Before the JIT, which then sees the pruned tree.
+    if (optimize)
+        DeadCode::attach(*stmts);
+
+    if (useJit)
+        JitCompiler::attach(*stmts);
+
+    // After the JIT - the loops it compiled are left as they are.
+    // Then what is left repeated within a block.
+    if (optimize) {
+        LoopHoister::attach(*stmts);
+        ValueNumbering::attach(*stmts);
+    }
 
     stmts->evaluate(symTab);
     // std::cout << "Evaluate Done - Dumping Tree" << std::endl;
 //    std::cout << getMemoryUsage() << std::endl;
-   stmts->dumpAST("");
+    if (debug)
+        stmts->dumpAST("");
 
     return 0;
 }
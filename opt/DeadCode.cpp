@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "DeadCode.hpp"
+#include "../ArithExpr.hpp"
+#include "../Debug.hpp"
+#include "../Script.hpp"
+#include "../SymTab.hpp"
+#include "../statements/Statement.hpp"
+
+void DeadCode::attach(Statements &stmts) {
+    pruneBranches(&stmts, false);
+    eliminate(&stmts, {});
+}
+
+// START "BRANCHES"
+// `inFunction` - a return there ends the function, and so the block.
+void DeadCode::pruneBranches(Statements *stmts, bool inFunction) {
+
+    std::vector<std::unique_ptr<Statement>> kept;
+
+    for (auto &&stmt : stmts->_statements) {
+        auto ifStatement = dynamic_cast<IfStatement *>(stmt.get());
+
+        if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            pruneBranches(range->_forBody.get(), inFunction);
+        } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt.get()) ) {
+            if ( funcDef->_SUITE_NOT_FUNC_SUITE_FIX != nullptr )
+                pruneBranches(funcDef->_SUITE_NOT_FUNC_SUITE_FIX.get(), true);
+        }
+
+        if ( ifStatement == nullptr ) {
+            kept.push_back(std::move(stmt));
+            continue;
+        }
+
+        std::vector<std::pair<std::unique_ptr<ExprNode>, std::unique_ptr<Statements>>> branches;
+        branches.push_back(std::move(ifStatement->_if->_if));
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif)
+                branches.push_back(std::move(elif));
+        std::unique_ptr<Statements> otherwise = ifStatement->_else != nullptr ? std::move(ifStatement->_else->_stmts) : nullptr;
+
+        // Branches that may run, in order - one that always runs ends the
+        // chain as its else.
+        std::vector<std::pair<std::unique_ptr<ExprNode>, std::unique_ptr<Statements>>> taken;
+        bool changed = false;
+
+        for (size_t b = 0; b < branches.size(); b++) {
+            auto truth = constantTruth(branches[b].first.get());
+
+            if ( truth == false ) {
+                if (optDebug)
+                    Script::out() << "DeadCode - removed a branch that is never taken" << std::endl;
+                changed = true;
+                continue;
+            }
+
+            if ( truth == true ) {
+                if ( (b + 1 < branches.size() || otherwise != nullptr) && optDebug )
+                    Script::out() << "DeadCode - removed the branches after one that is always taken" << std::endl;
+                otherwise = std::move(branches[b].second);
+                changed = true;
+                break;
+            }
+
+            pruneBranches(branches[b].second.get(), inFunction);
+            taken.push_back(std::move(branches[b]));
+        }
+
+        if ( otherwise != nullptr )
+            pruneBranches(otherwise.get(), inFunction);
+
+        if ( taken.empty() ) {
+            if (optDebug)
+                Script::out() << "DeadCode - replaced an if by " << (otherwise != nullptr ? "the branch it always takes" : "nothing") << std::endl;
+            if ( otherwise != nullptr )
+                for (auto &&taken : otherwise->_statements)
+                    kept.push_back(std::move(taken));
+            continue;
+        }
+
+        if ( !changed ) {
+            ifStatement->_if->_if = std::move(taken[0]);
+            for (size_t b = 1; b < taken.size(); b++)
+                ifStatement->_elif->_elif[b - 1] = std::move(taken[b]);
+            if ( otherwise != nullptr )
+                ifStatement->_else->_stmts = std::move(otherwise);
+            kept.push_back(std::move(stmt));
+            continue;
+        }
+
+        auto rebuilt = std::make_unique<IfStatement>();
+        rebuilt->addIfStmt(std::make_unique<IfStmt>(std::move(taken[0].first), std::move(taken[0].second)));
+        if ( taken.size() > 1 ) {
+            auto elif = std::make_unique<ElifStmt>();
+            for (size_t b = 1; b < taken.size(); b++)
+                elif->addStatement(std::move(taken[b].first), std::move(taken[b].second));
+            rebuilt->addElifStmt(std::move(elif));
+        }
+        if ( otherwise != nullptr )
+            rebuilt->addElseStmt(std::make_unique<ElseStmt>(std::move(otherwise)));
+
+        kept.push_back(std::move(rebuilt));
+    }
+
+    // Nothing after a return runs - an always-taken branch's return counts
+    // too, now that its statements are in the block.
+    if ( inFunction ) {
+        auto returns = std::find_if(kept.begin(), kept.end(), [] (auto &stmt) { return dynamic_cast<ReturnStatement *>(stmt.get()) != nullptr; });
+        if ( returns != kept.end() && std::next(returns) != kept.end() ) {
+            if (optDebug)
+                Script::out() << "DeadCode - removed the statements after a return" << std::endl;
+            kept.erase(std::next(returns), kept.end());
+        }
+    }
+
+    stmts->_statements = std::move(kept);
+}
+
+// The condition's value when it is built from constants and evaluates to a
+// bool - one that would end the script with an error is left to do so.
+std::optional<bool> DeadCode::constantTruth(ExprNode *expr) {
+
+    if ( !operatorsOverConstants(expr) )
+        return std::nullopt;
+
+    std::ostringstream discarded;
+    Script::Redirect redirect(discarded);
+    Script::Job job;
+
+    try {
+        SymTab symTab;
+        return expr->condition(symTab);
+    } catch (const Script::Exit &) {
+        return std::nullopt;
+    }
+}
+// END "BRANCHES"
+
+// START "LIVENESS"
+// `parameters` are bound as the scope starts.
+void DeadCode::eliminate(Statements *stmts, const Names &parameters) {
+
+    Names bound = parameters;
+    assigned(stmts, bound);
+
+    live(stmts, {}, bound, true);
+    eliminateInFunctions(stmts);
+}
+
+void DeadCode::eliminateInFunctions(Statements *stmts) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt.get()) ) {
+            if ( funcDef->_SUITE_NOT_FUNC_SUITE_FIX != nullptr )
+                eliminate(funcDef->_SUITE_NOT_FUNC_SUITE_FIX.get(), Names(funcDef->_paramList.begin(), funcDef->_paramList.end()));
+        } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            eliminateInFunctions(range->_forBody.get());
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            eliminateInFunctions(ifStatement->_if->_if.second.get());
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    eliminateInFunctions(elif.second.get());
+            if ( ifStatement->_else != nullptr )
+                eliminateInFunctions(ifStatement->_else->_stmts.get());
+        }
+    }
+}
+
+// The names live before the statements, given those live after them.
+// `bound` holds the names that may be bound when a loop starts.
+DeadCode::Names DeadCode::live(Statements *stmts, Names liveOut, const Names &bound, bool remove) {
+
+    auto &statements = stmts->_statements;
+    std::vector<bool> dead(statements.size(), false);
+
+    for (size_t s = statements.size(); s-- > 0; ) {
+        bool isDead = false;
+        liveOut = live(statements[s].get(), liveOut, bound, remove, isDead);
+        dead[s] = isDead;
+    }
+
+    if ( remove ) {
+        size_t s = 0;
+        statements.erase(std::remove_if(statements.begin(), statements.end(), [&] (auto &) { return dead[s++]; }), statements.end());
+    }
+
+    return liveOut;
+}
+
+DeadCode::Names DeadCode::live(Statement *stmt, const Names &liveOut, const Names &bound, bool remove, bool &dead) {
+
+    Names in = liveOut;
+
+    if ( auto assign = dynamic_cast<AssignStmt *>(stmt) ) {
+        if ( liveOut.count(assign->_lhsVariable) == 0 && constant(assign->_rhsExpression.get()) ) {
+            if ( remove && optDebug )
+                Script::out() << "DeadCode - removed the dead store to " << assign->_lhsVariable << std::endl;
+            dead = remove;
+            return liveOut;
+        }
+        in.erase(assign->_lhsVariable);
+        reads(assign->_rhsExpression.get(), in);
+
+    } else if ( auto print = dynamic_cast<PrintStatement *>(stmt) ) {
+        for (auto &&expr : *print->_testList)
+            reads(expr.get(), in);
+
+    } else if ( auto ret = dynamic_cast<ReturnStatement *>(stmt) ) {
+        reads(ret->_returnExpr.get(), in);
+
+    } else if ( auto call = dynamic_cast<FunctionCallStatement *>(stmt) ) {
+        reads(call->_exprNodeCall.get(), in);
+
+    } else if ( auto append = dynamic_cast<AppendStatement *>(stmt) ) {
+        in.insert(append->_listName);
+        reads(append->_value.get(), in);
+
+    } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(stmt) ) {
+        in.insert(store->_listName);
+        reads(store->_index.get(), in);
+        reads(store->_rhsExpression.get(), in);
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        // Without an else, no branch may run.
+        if ( ifStatement->_else != nullptr )
+            in = live(ifStatement->_else->_stmts.get(), liveOut, bound, remove);
+
+        auto branch = live(ifStatement->_if->_if.second.get(), liveOut, bound, remove);
+        in.insert(branch.begin(), branch.end());
+        reads(ifStatement->_if->_if.first.get(), in);
+
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif) {
+                branch = live(elif.second.get(), liveOut, bound, remove);
+                in.insert(branch.begin(), branch.end());
+                reads(elif.first.get(), in);
+            }
+
+    } else if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        Names inner = bound;
+        inner.insert(range->_id);
+
+        // What the next iteration reads is live at the end of the body - the
+        // loop variable too, which the loop increments.
+        Names bodyOut = liveOut;
+        bodyOut.insert(range->_id);
+        for (;;) {
+            Names next = bodyOut;
+            auto bodyIn = live(range->_forBody.get(), bodyOut, inner, false);
+            next.insert(bodyIn.begin(), bodyIn.end());
+            if ( next == bodyOut )
+                break;
+            bodyOut = next;
+        }
+
+        // prange bodies are left as Prange analysed them.
+        auto bodyIn = live(range->_forBody.get(), bodyOut, inner, remove && range->_parallel == nullptr);
+
+        if ( remove && range->_forBody->_statements.empty() && removableLoop(range, bound) ) {
+            if (optDebug)
+                Script::out() << "DeadCode - removed the empty loop over " << range->_id << std::endl;
+            dead = true;
+            return liveOut;
+        }
+
+        in.insert(bodyIn.begin(), bodyIn.end());
+        in.insert(range->_id);
+        reads(range->_iterable.get(), in);
+        if ( range->_testList != nullptr )
+            for (auto &&expr : *range->_testList)
+                reads(expr.get(), in);
+    }
+
+    return in;
+}
+
+// A serial loop over a range of constants that RangeStmt accepts, whose
+// variable nothing can have bound - running it has no effect.
+bool DeadCode::removableLoop(RangeStmt *range, const Names &bound) {
+
+    if ( range->_parallel != nullptr || range->_iterable != nullptr || bound.count(range->_id) != 0 )
+        return false;
+
+    auto &bounds = *range->_testList;
+    if ( bounds.empty() || bounds.size() > 3 )
+        return false;
+
+    std::vector<int64_t> values;
+    for (auto &&expr : bounds) {
+        auto number = dynamic_cast<WholeNumber *>(expr.get());
+        if ( number == nullptr || !number->token()->getWholeNumber().isSmall() )
+            return false;
+        values.push_back(number->token()->getWholeNumber().small());
+    }
+
+    int64_t start = values.size() > 1 ? values[0] : 0;
+    int64_t end = values.size() > 1 ? values[1] : values[0];
+    int64_t step = values.size() > 2 ? values[2] : 1;
+
+    return (start > end && step < 0) || (start < end && 1 <= step) || start == end;
+}
+// END "LIVENESS"
+
+// Values that can't fail to evaluate and have no effect.
+bool DeadCode::constant(ExprNode *expr) {
+
+    if ( dynamic_cast<WholeNumber *>(expr) || dynamic_cast<Double *>(expr) || dynamic_cast<StringExp *>(expr) )
+        return true;
+
+    if ( auto list = dynamic_cast<ListExp *>(expr) )
+        return std::all_of(list->_elements->begin(), list->_elements->end(), [] (auto &element) { return constant(element.get()); });
+
+    // A list can't be a key.
+    if ( auto dict = dynamic_cast<DictExp *>(expr) )
+        return std::all_of(dict->_keys->begin(), dict->_keys->end(), [] (auto &key) { return constant(key.get()) && dynamic_cast<ListExp *>(key.get()) == nullptr && dynamic_cast<DictExp *>(key.get()) == nullptr; })
+            && std::all_of(dict->_values->begin(), dict->_values->end(), [] (auto &value) { return constant(value.get()); });
+
+    return false;
+}
+
+bool DeadCode::operatorsOverConstants(ExprNode *expr) {
+
+    if ( expr == nullptr )
+        return true;
+
+    if ( dynamic_cast<WholeNumber *>(expr) || dynamic_cast<Double *>(expr) || dynamic_cast<StringExp *>(expr) )
+        return true;
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) )
+        return operatorsOverConstants(infix->_left.get()) && operatorsOverConstants(infix->_right.get());
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) )
+        return operatorsOverConstants(comparison->_left.get()) && operatorsOverConstants(comparison->_right.get());
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) )
+        return operatorsOverConstants(boolean->_left.get()) && operatorsOverConstants(boolean->_right.get());
+
+    return false;
+}
+
+void DeadCode::reads(ExprNode *expr, Names &names) {
+
+    if ( expr == nullptr )
+        return;
+
+    if ( dynamic_cast<Variable *>(expr) ) {
+        names.insert(expr->token()->getName());
+    } else if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        reads(infix->_left.get(), names);
+        reads(infix->_right.get(), names);
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        reads(comparison->_left.get(), names);
+        reads(comparison->_right.get(), names);
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        reads(boolean->_left.get(), names);
+        reads(boolean->_right.get(), names);
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr) ) {
+        reads(membership->_left.get(), names);
+        reads(membership->_right.get(), names);
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr) ) {
+        for (auto &&argument : *call->_testList)
+            reads(argument.get(), names);
+    } else if ( auto list = dynamic_cast<ListExp *>(expr) ) {
+        for (auto &&element : *list->_elements)
+            reads(element.get(), names);
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr) ) {
+        for (auto &&key : *dict->_keys)
+            reads(key.get(), names);
+        for (auto &&value : *dict->_values)
+            reads(value.get(), names);
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr) ) {
+        reads(subscript->_sequence.get(), names);
+        reads(subscript->_index.get(), names);
+    } else if ( auto len = dynamic_cast<LenExp *>(expr) ) {
+        reads(len->_sequence.get(), names);
+    } else if ( auto hoisted = dynamic_cast<HoistedExpr *>(expr) ) {
+        reads(hoisted->_expr.get(), names);
+    }
+}
+
+// Every name the statements assign, in this scope.
+void DeadCode::assigned(Statements *stmts, Names &names) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto assign = dynamic_cast<AssignStmt *>(stmt.get()) ) {
+            names.insert(assign->_lhsVariable);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            assigned(range->_forBody.get(), names);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            assigned(ifStatement->_if->_if.second.get(), names);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    assigned(elif.second.get(), names);
+            if ( ifStatement->_else != nullptr )
+                assigned(ifStatement->_else->_stmts.get(), names);
+        }
+    }
+}
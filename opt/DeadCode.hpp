@@ -0,0 +1,57 @@
+#ifndef __DEAD_CODE_HPP
+#define __DEAD_CODE_HPP
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+
+class ExprNode;
+class Statement;
+class Statements;
+class RangeStmt;
+
+// Dead-code elimination for --opt, over the whole program before it runs.
+//
+// Unreachable branches go first: an if / elif condition built only from
+// constants is evaluated here, a branch whose condition is false is
+// dropped, and one whose condition is true becomes the else - an if left
+// with only that branch is replaced by its statements. In a function, the
+// statements after a return in the same block are dropped too; outside one
+// a return ends nothing.
+//
+// Then a backward liveness pass over each scope - the program, and each
+// function body, which sees only its parameters - drops assignments whose
+// value is never read. Only constant values are dropped; anything else
+// could end the script with an error. A for loop reads its variable, since
+// it refuses to run while the name is bound. A loop over range(constants)
+// left with an empty body is dropped too, when nothing can have bound its
+// variable.
+//
+// With optDebug, what was removed is listed.
+
+class DeadCode {
+
+public:
+    static void attach(Statements &stmts);
+
+private:
+    typedef std::set<std::string> Names;
+
+    static void pruneBranches(Statements *stmts, bool inFunction);
+    static std::optional<bool> constantTruth(ExprNode *expr);
+
+    static void eliminate(Statements *stmts, const Names &parameters);
+    static void eliminateInFunctions(Statements *stmts);
+    static Names live(Statements *stmts, Names liveOut, const Names &bound, bool remove);
+    static Names live(Statement *stmt, const Names &liveOut, const Names &bound, bool remove, bool &dead);
+
+    static bool removableLoop(RangeStmt *range, const Names &bound);
+
+    static bool constant(ExprNode *expr);
+    static bool operatorsOverConstants(ExprNode *expr);
+    static void reads(ExprNode *expr, Names &names);
+    static void assigned(Statements *stmts, Names &names);
+};
+
+#endif
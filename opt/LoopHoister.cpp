@@ -0,0 +1,194 @@
+#include <atomic>
+
+#include "LoopHoister.hpp"
+#include "../ArithExpr.hpp"
+#include "../Debug.hpp"
+#include "../Script.hpp"
+#include "../statements/Statement.hpp"
+
+// Temporaries are named past what the Lexer reads as a name, so no script
+// variable can collide with one.
+static std::atomic<size_t> temporaries{0};
+
+void LoopHoister::attach(Statements &stmts) {
+    for (auto &&stmt : stmts._statements)
+        attachStatement(stmt.get());
+}
+
+void LoopHoister::attachStatement(Statement *stmt) {
+
+    if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        if ( range->_parallel != nullptr || range->_jit != nullptr )
+            return;
+
+        // Outer loops first - what they take out of an inner loop runs once
+        // per outer loop instead of once per inner loop.
+        hoistLoop(range);
+        attach(*range->_forBody);
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        attach(*ifStatement->_if->_if.second);
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif)
+                attach(*elif.second);
+        if ( ifStatement->_else != nullptr )
+            attach(*ifStatement->_else->_stmts);
+
+    } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt) ) {
+        if ( funcDef->_SUITE_NOT_FUNC_SUITE_FIX != nullptr )
+            attach(*funcDef->_SUITE_NOT_FUNC_SUITE_FIX);
+    }
+}
+
+void LoopHoister::hoistLoop(RangeStmt *range) {
+
+    Names writes = { range->_id };
+    collectWrites(range->_forBody.get(), writes);
+
+    hoistIn(range->_forBody.get(), writes, range);
+}
+
+void LoopHoister::collectWrites(Statements *stmts, Names &writes) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto assign = dynamic_cast<AssignStmt *>(stmt.get()) ) {
+            writes.insert(assign->_lhsVariable);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(stmt.get()) ) {
+            writes.insert(append->_listName);
+        } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(stmt.get()) ) {
+            writes.insert(store->_listName);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            writes.insert(range->_id);
+            collectWrites(range->_forBody.get(), writes);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            collectWrites(ifStatement->_if->_if.second.get(), writes);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    collectWrites(elif.second.get(), writes);
+            if ( ifStatement->_else != nullptr )
+                collectWrites(ifStatement->_else->_stmts.get(), writes);
+        }
+    }
+}
+
+// Every expression in the statements, nested loops included - but not the
+// bodies of functions defined here, which run in their own scope.
+void LoopHoister::hoistIn(Statements *stmts, const Names &writes, RangeStmt *range) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto assign = dynamic_cast<AssignStmt *>(stmt.get()) ) {
+            hoistIn(assign->_rhsExpression, writes, range);
+        } else if ( auto print = dynamic_cast<PrintStatement *>(stmt.get()) ) {
+            for (auto &&expr : *print->_testList)
+                hoistIn(expr, writes, range);
+        } else if ( auto ret = dynamic_cast<ReturnStatement *>(stmt.get()) ) {
+            if ( ret->_returnExpr != nullptr )
+                hoistIn(ret->_returnExpr, writes, range);
+        } else if ( auto call = dynamic_cast<FunctionCallStatement *>(stmt.get()) ) {
+            hoistIn(call->_exprNodeCall, writes, range);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(stmt.get()) ) {
+            hoistIn(append->_value, writes, range);
+        } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(stmt.get()) ) {
+            hoistIn(store->_index, writes, range);
+            hoistIn(store->_rhsExpression, writes, range);
+        } else if ( auto inner = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            if ( inner->_parallel != nullptr || inner->_jit != nullptr )
+                continue;
+            if ( inner->_iterable != nullptr )
+                hoistIn(inner->_iterable, writes, range);
+            if ( inner->_testList != nullptr )
+                for (auto &&expr : *inner->_testList)
+                    hoistIn(expr, writes, range);
+            hoistIn(inner->_forBody.get(), writes, range);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            hoistIn(ifStatement->_if->_if.first, writes, range);
+            hoistIn(ifStatement->_if->_if.second.get(), writes, range);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif) {
+                    hoistIn(elif.first, writes, range);
+                    hoistIn(elif.second.get(), writes, range);
+                }
+            if ( ifStatement->_else != nullptr )
+                hoistIn(ifStatement->_else->_stmts.get(), writes, range);
+        }
+    }
+}
+
+void LoopHoister::hoistIn(std::unique_ptr<ExprNode> &expr, const Names &writes, RangeStmt *range) {
+
+    if ( expr == nullptr )
+        return;
+
+    // Only an operator is worth a temporary - a lone name or constant is
+    // already as cheap to evaluate as the lookup would be.
+    bool isOperator = dynamic_cast<InfixExprNode *>(expr.get()) || dynamic_cast<ComparisonExprNode *>(expr.get())
+                   || dynamic_cast<BooleanExprNode *>(expr.get());
+
+    std::vector<std::string> reads;
+    if ( isOperator && invariant(expr.get(), writes, reads) ) {
+        std::string name = "$hoist" + std::to_string(temporaries++);
+
+        if (optDebug) {
+            Script::out() << "LoopHoister - " << name << " out of the loop over " << range->_id << std::endl;
+            expr->dumpAST("\t");
+        }
+
+        range->_hoisted.push_back(name);
+        expr = std::make_unique<HoistedExpr>(name, std::move(expr), std::move(reads));
+        return;
+    }
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr.get()) ) {
+        hoistIn(infix->_left, writes, range);
+        hoistIn(infix->_right, writes, range);
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr.get()) ) {
+        hoistIn(comparison->_left, writes, range);
+        hoistIn(comparison->_right, writes, range);
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr.get()) ) {
+        hoistIn(boolean->_left, writes, range);
+        hoistIn(boolean->_right, writes, range);
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr.get()) ) {
+        hoistIn(membership->_left, writes, range);
+        hoistIn(membership->_right, writes, range);
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr.get()) ) {
+        for (auto &&argument : *call->_testList)
+            hoistIn(argument, writes, range);
+    } else if ( auto list = dynamic_cast<ListExp *>(expr.get()) ) {
+        for (auto &&element : *list->_elements)
+            hoistIn(element, writes, range);
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr.get()) ) {
+        for (auto &&key : *dict->_keys)
+            hoistIn(key, writes, range);
+        for (auto &&value : *dict->_values)
+            hoistIn(value, writes, range);
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr.get()) ) {
+        hoistIn(subscript->_sequence, writes, range);
+        hoistIn(subscript->_index, writes, range);
+    } else if ( auto len = dynamic_cast<LenExp *>(expr.get()) ) {
+        hoistIn(len->_sequence, writes, range);
+    }
+}
+
+bool LoopHoister::invariant(ExprNode *expr, const Names &writes, std::vector<std::string> &reads) {
+
+    if ( expr == nullptr )
+        return true;
+
+    if ( dynamic_cast<WholeNumber *>(expr) || dynamic_cast<Double *>(expr) || dynamic_cast<StringExp *>(expr) )
+        return true;
+
+    if ( dynamic_cast<Variable *>(expr) ) {
+        std::string name = expr->token()->getName();
+        reads.push_back(name);
+        return writes.count(name) == 0;
+    }
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) )
+        return invariant(infix->_left.get(), writes, reads) && invariant(infix->_right.get(), writes, reads);
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) )
+        return invariant(comparison->_left.get(), writes, reads) && invariant(comparison->_right.get(), writes, reads);
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) )
+        return invariant(boolean->_left.get(), writes, reads) && invariant(boolean->_right.get(), writes, reads);
+
+    return false;
+}
@@ -0,0 +1,43 @@
+#ifndef __LOOP_HOISTER_HPP
+#define __LOOP_HOISTER_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class ExprNode;
+class Statement;
+class Statements;
+class RangeStmt;
+
+// Loop-invariant code motion for --opt. For each RangeStmt the write set is
+// every name its body binds - assignments, nested loop variables, lists
+// appended to or stored into - plus the loop variable. A subtree of
+// arithmetic, comparisons and and / or / not over constants and names
+// outside the write set has the same value on every iteration, so the
+// largest such subtrees become HoistedExprs, computed once per run of the
+// loop. A subtree invariant in an outer loop is hoisted to that loop.
+//
+// Calls, subscripts, len() and `in` are left in place - what they read can
+// change without a name being bound. prange bodies and loops the JIT
+// compiled are left alone, as are lazily parsed function bodies.
+
+class LoopHoister {
+
+public:
+    static void attach(Statements &stmts);
+    static void attachStatement(Statement *stmt);
+
+private:
+    typedef std::set<std::string> Names;
+
+    static void hoistLoop(RangeStmt *range);
+    static void hoistIn(Statements *stmts, const Names &writes, RangeStmt *range);
+    static void hoistIn(std::unique_ptr<ExprNode> &expr, const Names &writes, RangeStmt *range);
+
+    static void collectWrites(Statements *stmts, Names &writes);
+    static bool invariant(ExprNode *expr, const Names &writes, std::vector<std::string> &reads);
+};
+
+#endif
@@ -0,0 +1,263 @@
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+#include "ValueNumbering.hpp"
+#include "../ArithExpr.hpp"
+#include "../Debug.hpp"
+#include "../Script.hpp"
+#include "../statements/Statement.hpp"
+
+// Named past what the Lexer reads as a name, like LoopHoister's.
+static std::atomic<size_t> temporaries{0};
+
+void ValueNumbering::attach(Statements &stmts) {
+    numberBlock(&stmts);
+}
+
+// Streaming hands over one top-level statement at a time, so only the
+// blocks nested in it are numbered.
+void ValueNumbering::attachStatement(Statement *stmt) {
+    nestedBlocks(stmt);
+}
+
+void ValueNumbering::numberBlock(Statements *stmts) {
+
+    Block block;
+
+    for (auto &&stmt : stmts->_statements) {
+        Names writes;
+
+        if ( auto assign = dynamic_cast<AssignStmt *>(stmt.get()) ) {
+            block.number(assign->_rhsExpression, true);
+            writes.insert(assign->_lhsVariable);
+        } else if ( auto print = dynamic_cast<PrintStatement *>(stmt.get()) ) {
+            for (auto &&expr : *print->_testList)
+                block.number(expr, true);
+        } else if ( auto ret = dynamic_cast<ReturnStatement *>(stmt.get()) ) {
+            block.number(ret->_returnExpr, true);
+        } else if ( auto call = dynamic_cast<FunctionCallStatement *>(stmt.get()) ) {
+            block.number(call->_exprNodeCall, true);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(stmt.get()) ) {
+            block.number(append->_value, true);
+            writes.insert(append->_listName);
+        } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(stmt.get()) ) {
+            block.number(store->_index, true);
+            block.number(store->_rhsExpression, true);
+            writes.insert(store->_listName);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            if ( range->_parallel == nullptr && range->_jit == nullptr ) {
+                block.number(range->_iterable, true);
+                if ( range->_testList != nullptr )
+                    for (auto &&expr : *range->_testList)
+                        block.number(expr, true);
+            }
+            writes.insert(range->_id);
+            collectWrites(range->_forBody.get(), writes);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            // The if's condition always runs, and before any elif's.
+            block.number(ifStatement->_if->_if.first, true);
+            block.endStatement();
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    block.number(elif.first, false);
+
+            collectWrites(ifStatement->_if->_if.second.get(), writes);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    collectWrites(elif.second.get(), writes);
+            if ( ifStatement->_else != nullptr )
+                collectWrites(ifStatement->_else->_stmts.get(), writes);
+        }
+
+        block.endStatement();
+        block.bind(writes);
+
+        nestedBlocks(stmt.get());
+    }
+}
+
+void ValueNumbering::nestedBlocks(Statement *stmt) {
+
+    if ( auto range = dynamic_cast<RangeStmt *>(stmt) ) {
+        if ( range->_parallel == nullptr && range->_jit == nullptr )
+            numberBlock(range->_forBody.get());
+
+    } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt) ) {
+        numberBlock(ifStatement->_if->_if.second.get());
+        if ( ifStatement->_elif != nullptr )
+            for (auto &&elif : ifStatement->_elif->_elif)
+                numberBlock(elif.second.get());
+        if ( ifStatement->_else != nullptr )
+            numberBlock(ifStatement->_else->_stmts.get());
+
+    } else if ( auto funcDef = dynamic_cast<FunctionDefinition *>(stmt) ) {
+        if ( funcDef->_SUITE_NOT_FUNC_SUITE_FIX != nullptr )
+            numberBlock(funcDef->_SUITE_NOT_FUNC_SUITE_FIX.get());
+    }
+}
+
+void ValueNumbering::collectWrites(Statements *stmts, Names &writes) {
+
+    for (auto &&stmt : stmts->_statements) {
+        if ( auto assign = dynamic_cast<AssignStmt *>(stmt.get()) ) {
+            writes.insert(assign->_lhsVariable);
+        } else if ( auto append = dynamic_cast<AppendStatement *>(stmt.get()) ) {
+            writes.insert(append->_listName);
+        } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(stmt.get()) ) {
+            writes.insert(store->_listName);
+        } else if ( auto range = dynamic_cast<RangeStmt *>(stmt.get()) ) {
+            writes.insert(range->_id);
+            collectWrites(range->_forBody.get(), writes);
+        } else if ( auto ifStatement = dynamic_cast<IfStatement *>(stmt.get()) ) {
+            collectWrites(ifStatement->_if->_if.second.get(), writes);
+            if ( ifStatement->_elif != nullptr )
+                for (auto &&elif : ifStatement->_elif->_elif)
+                    collectWrites(elif.second.get(), writes);
+            if ( ifStatement->_else != nullptr )
+                collectWrites(ifStatement->_else->_stmts.get(), writes);
+        }
+    }
+}
+
+// START "BLOCK"
+// `defines` tells whether every run of the statement evaluates `expr`.
+void ValueNumbering::Block::number(std::unique_ptr<ExprNode> &expr, bool defines) {
+
+    if ( expr == nullptr )
+        return;
+
+    // Only an operator is worth a temporary, as in LoopHoister.
+    bool isOperator = dynamic_cast<InfixExprNode *>(expr.get()) || dynamic_cast<ComparisonExprNode *>(expr.get())
+                   || dynamic_cast<BooleanExprNode *>(expr.get());
+
+    std::string key;
+    std::vector<std::string> reads;
+
+    if ( isOperator && numbered(expr.get(), key, reads) ) {
+        auto found = _available.find(key);
+
+        if ( found != _available.end() ) {
+            auto &available = found->second;
+            if ( available.name.empty() ) {
+                available.name = "$cse" + std::to_string(temporaries++);
+                *available.first = std::make_unique<CommonExpr>(available.name, std::move(*available.first), available.reads, true);
+            }
+
+            if (optDebug) {
+                Script::out() << "ValueNumbering - " << available.name << " reused" << std::endl;
+                expr->dumpAST("\t");
+            }
+
+            expr = std::make_unique<CommonExpr>(available.name, std::move(expr), std::move(reads), false);
+            return;
+        }
+
+        bool pending = false;
+        for (auto &entry : _pending)
+            pending = pending || entry.first == key;
+        if ( defines && !pending )
+            _pending.push_back({key, Available{&expr, "", reads}});
+    }
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr.get()) ) {
+        number(infix->_left, defines);
+        number(infix->_right, defines);
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr.get()) ) {
+        number(comparison->_left, defines);
+        number(comparison->_right, defines);
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr.get()) ) {
+        // The right side of and / or may be skipped.
+        number(boolean->_left, defines);
+        number(boolean->_right, false);
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr.get()) ) {
+        number(membership->_left, defines);
+        number(membership->_right, defines);
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr.get()) ) {
+        for (auto &&argument : *call->_testList)
+            number(argument, defines);
+    } else if ( auto list = dynamic_cast<ListExp *>(expr.get()) ) {
+        for (auto &&element : *list->_elements)
+            number(element, defines);
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr.get()) ) {
+        for (auto &&key : *dict->_keys)
+            number(key, defines);
+        for (auto &&value : *dict->_values)
+            number(value, defines);
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr.get()) ) {
+        number(subscript->_sequence, defines);
+        number(subscript->_index, defines);
+    } else if ( auto len = dynamic_cast<LenExp *>(expr.get()) ) {
+        number(len->_sequence, defines);
+    } else if ( auto hoisted = dynamic_cast<HoistedExpr *>(expr.get()) ) {
+        // Evaluated once per run of its loop.
+        number(hoisted->_expr, false);
+    }
+}
+
+// What a statement evaluated becomes available to the statements after it.
+void ValueNumbering::Block::endStatement() {
+
+    for (auto &entry : _pending)
+        _available.insert(std::move(entry));
+    _pending.clear();
+}
+
+void ValueNumbering::Block::bind(const Names &writes) {
+
+    for (auto it = _available.begin(); it != _available.end(); ) {
+        bool stale = false;
+        for (auto &name : it->second.reads)
+            stale = stale || writes.count(name) != 0;
+        it = stale ? _available.erase(it) : std::next(it);
+    }
+}
+// END "BLOCK"
+
+// The subtree's number - a key equal for subtrees of the same shape - and
+// the names it reads, when it is built only from operators, constants and
+// names.
+bool ValueNumbering::numbered(ExprNode *expr, std::string &key, std::vector<std::string> &reads) {
+
+    if ( expr == nullptr ) {
+        key += '_';
+        return true;
+    }
+
+    auto &token = *expr->token();
+
+    if ( dynamic_cast<WholeNumber *>(expr) ) {
+        key += "#" + token.getWholeNumber().toString() + ";";
+        return true;
+    }
+    if ( dynamic_cast<Double *>(expr) ) {
+        std::ostringstream bits;
+        bits << std::hexfloat << token.getFloat();
+        key += "." + bits.str() + ";";
+        return true;
+    }
+    if ( dynamic_cast<StringExp *>(expr) ) {
+        key += "'" + std::to_string(token.getString().size()) + ":" + token.getString();
+        return true;
+    }
+    if ( dynamic_cast<Variable *>(expr) ) {
+        key += "$" + token.getName() + ";";
+        reads.push_back(token.getName());
+        return true;
+    }
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        key += std::string("(") + token.symbol();
+        return numbered(infix->_left.get(), key, reads) && numbered(infix->_right.get(), key, reads);
+    }
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        key += "(" + token.getRelOp() + ";";
+        return numbered(comparison->_left.get(), key, reads) && numbered(comparison->_right.get(), key, reads);
+    }
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        key += std::string("(") + (token.isNot() ? 'n' : token.isAnd() ? 'a' : 'o');
+        return numbered(boolean->_left.get(), key, reads) && numbered(boolean->_right.get(), key, reads);
+    }
+
+    return false;
+}
@@ -0,0 +1,62 @@
+#ifndef __VALUE_NUMBERING_HPP
+#define __VALUE_NUMBERING_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class ExprNode;
+class Statement;
+class Statements;
+
+// Common-subexpression elimination for --opt, one block of statements at a
+// time. Each subtree of arithmetic, comparisons and and / or / not over
+// constants and names is numbered by its shape, so `b % 10` in two
+// statements gets the same number. Once a statement has evaluated a
+// numbered subtree, a later statement of the block - or an elif condition
+// after the if's - reuses its value through a CommonExpr, until something
+// in the block binds a name the subtree reads: an assignment, a loop, or
+// an if whose branches assign.
+//
+// Only a subtree every run of the statement evaluates can define a value,
+// so the right side of and / or only ever reuses one. Nested blocks are
+// numbered on their own, after LoopHoister - prange bodies and loops the
+// JIT compiled are left alone, as are lazily parsed function bodies.
+
+class ValueNumbering {
+
+public:
+    static void attach(Statements &stmts);
+    static void attachStatement(Statement *stmt);
+
+private:
+    typedef std::set<std::string> Names;
+
+    // A numbered subtree the block has evaluated, and where it first was.
+    struct Available {
+        std::unique_ptr<ExprNode> *first;
+        std::string name;
+        std::vector<std::string> reads;
+    };
+
+    class Block {
+    public:
+        void number(std::unique_ptr<ExprNode> &expr, bool defines);
+        void endStatement();
+        void bind(const Names &writes);
+
+    private:
+        std::map<std::string, Available> _available;
+        std::vector<std::pair<std::string, Available>> _pending;
+    };
+
+    static void numberBlock(Statements *stmts);
+    static void nestedBlocks(Statement *stmt);
+    static void collectWrites(Statements *stmts, Names &writes);
+
+    static bool numbered(ExprNode *expr, std::string &key, std::vector<std::string> &reads);
+};
+
+#endif
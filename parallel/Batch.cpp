@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include "Batch.hpp"
+#include "WorkPool.hpp"
+#include "../Debug.hpp"
+#include "../Parser.hpp"
+#include "../Script.hpp"
+#include "../SymTab.hpp"
+#include "../lex/Lexer.hpp"
+#include "../statements/Statement.hpp"
+
+Batch::Batch(bool lazyFunctions):
+    _lazyFunctions{lazyFunctions}
+{}
+
+void Batch::add(const std::string &path) {
+
+    if ( !std::filesystem::is_directory(path) ) {
+        _jobs.emplace_back(path);
+        return;
+    }
+
+    std::vector<std::string> files;
+    for (auto &entry : std::filesystem::directory_iterator(path))
+        if ( entry.is_regular_file() )
+            files.push_back(entry.path().string());
+
+    std::sort(files.begin(), files.end());
+    for (auto &file : files)
+        _jobs.emplace_back(file);
+}
+
+size_t Batch::run(const char *outputDirectory) {
+
+    if (debug)
+        std::cout << "Batch::run - " << _jobs.size() << " scripts" << std::endl;
+
+    std::vector<std::string> outputNames;
+    if ( outputDirectory != nullptr ) {
+        if ( !std::filesystem::is_directory(outputDirectory) ) {
+            std::cout << "Batch::run - " << outputDirectory << " is not a directory" << std::endl;
+            return _jobs.size();
+        }
+        outputNames = uniqueOutputNames();
+    }
+
+    // Without an output directory, a finished job is written out once every
+    // job before it has been.
+    std::mutex outputLock;
+    std::vector<bool> finished(_jobs.size(), false);
+    size_t written = 0;
+    size_t failed = 0;
+
+    WorkPool::shared().run(_jobs.size(), [&](size_t i, unsigned) {
+
+        Job &job = _jobs[i];
+
+        if ( outputDirectory != nullptr ) {
+            auto name = std::filesystem::path(outputDirectory) / outputNames[i];
+            std::ofstream file(name);
+
+            if ( file.is_open() ) {
+                runJob(job);
+                file << job.output;
+                file.close();
+            }
+            if ( !file ) {
+                job.status = 2;
+                std::lock_guard<std::mutex> guard(outputLock);
+                std::cout << "Batch::run - Unable to write " << name.string() << std::endl;
+            }
+            job.output.clear();
+        } else {
+            runJob(job);
+        }
+
+        std::lock_guard<std::mutex> guard(outputLock);
+        failed += job.status != 0;
+        finished[i] = true;
+
+        for (; outputDirectory == nullptr && written < _jobs.size() && finished[written]; written++) {
+            std::cout << "==> " << _jobs[written].path << " <==" << std::endl;
+            std::cout << _jobs[written].output << std::flush;
+            _jobs[written].output.clear();
+        }
+    });
+
+    return failed;
+}
+
+// <file name>.out, or <file name>.<n>.out for the later scripts sharing a
+// file name - decided before anything runs, so the same batch always
+// writes the same names.
+std::vector<std::string> Batch::uniqueOutputNames() const {
+
+    std::set<std::string> used;
+    std::vector<std::string> names;
+
+    for (auto &job : _jobs) {
+        std::string file = std::filesystem::path(job.path).filename().string();
+        std::string name = file + ".out";
+        for (size_t n = 1; !used.insert(name).second; n++)
+            name = file + "." + std::to_string(n) + ".out";
+        names.push_back(name);
+    }
+
+    return names;
+}
+
+void Batch::runJob(Job &job) {
+
+    std::ostringstream output;
+    Script::Redirect redirect(output);
+    Script::Job scriptJob;
+
+    try {
+        std::ifstream input(job.path, std::ios::in);
+        if ( !input.is_open() ) {
+            output << "Unable to open " << job.path << std::endl;
+            job.status = 2;
+        } else {
+            Lexer lex(input);
+            Parser parser(lex, _lazyFunctions);
+            std::unique_ptr<Statements> stmts = parser.file_input();
+
+            SymTab symTab;
+            stmts->evaluate(symTab);
+        }
+    } catch (const Script::Exit &exit) {
+        job.status = exit.status;
+    }
+
+    job.output = output.str();
+}
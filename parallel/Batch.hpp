@@ -0,0 +1,43 @@
+#ifndef __BATCH_HPP
+#define __BATCH_HPP
+
+#include <string>
+#include <vector>
+
+// Runs many scripts in one process. Every script is a job on the shared
+// WorkPool with its own Lexer, Parser and SymTab; what it prints, and the
+// error that ends it if one does, is kept in that job's buffer. A prange
+// inside a job runs on the job's thread.
+
+class Batch {
+
+public:
+    Batch(bool lazyFunctions);
+
+    // A script, or every file in a directory, by name.
+    void add(const std::string &path);
+
+    // Runs all the scripts and returns how many failed. With an output
+    // directory each one's output goes to <directory>/<file name>.out - a
+    // later script with the same file name gets <file name>.<n>.out - and a
+    // script whose output file can't be written fails; otherwise to stdout
+    // in the order they were added, each after a "==> path <==" line.
+    size_t run(const char *outputDirectory);
+
+private:
+    struct Job {
+        Job(std::string path): path{std::move(path)} {}
+
+        std::string path;
+        std::string output;
+        int status = 0;
+    };
+
+    void runJob(Job &job);
+    std::vector<std::string> uniqueOutputNames() const;
+
+    bool _lazyFunctions;
+    std::vector<Job> _jobs;
+};
+
+#endif
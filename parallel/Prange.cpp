@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+#include "Prange.hpp"
+#include "WorkPool.hpp"
+#include "../ArithExpr.hpp"
+#include "../Debug.hpp"
+#include "../Script.hpp"
+#include "../statements/Statement.hpp"
+
+static thread_local bool runningChunk = false;
+
+static std::mutex containersLock;
+
+std::unique_lock<std::mutex> Prange::lockContainers() {
+    if ( !inBody() )
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(containersLock);
+}
+
+bool Prange::inBody() {
+    return runningChunk;
+}
+
+Prange::Prange(RangeStmt *stmt):
+    _stmt{stmt}
+{
+    collect(_stmt->_forBody.get());
+
+    for (auto &update : _updates) {
+        if ( _assigned.count(update.first) == 0 && update.second != nullptr )
+            _reductions.push_back({ update.first, update.second });
+        else
+            _assigned.insert(update.first);
+    }
+
+    for (auto &name : _assigned)
+        if ( name != _stmt->_id )
+            _privates.push_back(name);
+
+    carried(_stmt->_forBody.get(), { _stmt->_id });
+
+    if (debug)
+        Script::out() << "Prange::Prange - " << _reductions.size() << " reductions, "
+                  << _privates.size() << " privates" << std::endl;
+}
+
+// Sorts every name the body assigns into _updates or _assigned. A name
+// updated with both + and * is recorded with a null operator.
+void Prange::collect(Statements *stmts) {
+
+    for (auto &statement : stmts->_statements) {
+
+        if ( auto assign = dynamic_cast<AssignStmt *>(statement.get()) ) {
+            auto infix = dynamic_cast<InfixExprNode *>(assign->_rhsExpression.get());
+            auto left = infix != nullptr ? dynamic_cast<Variable *>(infix->_left.get()) : nullptr;
+            bool reduction = left != nullptr && infix->_right != nullptr
+                          && left->token()->getName() == assign->_lhsVariable
+                          && (infix->token()->isAdditionOperator() || infix->token()->isMultiplicationOperator());
+
+            if ( !reduction ) {
+                _assigned.insert(assign->_lhsVariable);
+                continue;
+            }
+
+            auto seen = _updates.find(assign->_lhsVariable);
+            if ( seen == _updates.end() )
+                _updates[assign->_lhsVariable] = infix->token();
+            else if ( seen->second != nullptr && seen->second->symbol() != infix->token()->symbol() )
+                seen->second = nullptr;
+
+        } else if ( auto ifs = dynamic_cast<IfStatement *>(statement.get()) ) {
+            collect(ifs->_if->_if.second.get());
+            if ( ifs->_elif != nullptr )
+                for (auto &branch : ifs->_elif->_elif)
+                    collect(branch.second.get());
+            if ( ifs->_else != nullptr )
+                collect(ifs->_else->_stmts.get());
+
+        } else if ( auto range = dynamic_cast<RangeStmt *>(statement.get()) ) {
+            collect(range->_forBody.get());
+
+        } else if ( dynamic_cast<ReturnStatement *>(statement.get()) ) {
+            _serial = true;
+        }
+    }
+}
+
+// Looks for a value one iteration leaves for the next, given the names an
+// iteration has surely assigned so far, and returns those after the
+// statements.
+Prange::Names Prange::carried(Statements *stmts, Names assigned) {
+
+    for (auto &statement : stmts->_statements) {
+        Names names;
+
+        if ( auto assign = dynamic_cast<AssignStmt *>(statement.get()) ) {
+            // A reduction's update reads only its operand.
+            if ( _updates.count(assign->_lhsVariable) != 0 && _assigned.count(assign->_lhsVariable) == 0 )
+                reads(static_cast<InfixExprNode *>(assign->_rhsExpression.get())->_right.get(), names);
+            else
+                reads(assign->_rhsExpression.get(), names);
+            carried(names, assigned);
+            assigned.insert(assign->_lhsVariable);
+
+        } else if ( auto print = dynamic_cast<PrintStatement *>(statement.get()) ) {
+            for (auto &expr : *print->_testList)
+                reads(expr.get(), names);
+            carried(names, assigned);
+
+        } else if ( auto call = dynamic_cast<FunctionCallStatement *>(statement.get()) ) {
+            reads(call->_exprNodeCall.get(), names);
+            carried(names, assigned);
+
+        } else if ( auto append = dynamic_cast<AppendStatement *>(statement.get()) ) {
+            names.insert(append->_listName);
+            reads(append->_value.get(), names);
+            carried(names, assigned);
+
+        } else if ( auto store = dynamic_cast<SubscriptAssignStmt *>(statement.get()) ) {
+            names.insert(store->_listName);
+            reads(store->_index.get(), names);
+            reads(store->_rhsExpression.get(), names);
+            carried(names, assigned);
+
+        } else if ( auto ifs = dynamic_cast<IfStatement *>(statement.get()) ) {
+            reads(ifs->_if->_if.first.get(), names);
+            if ( ifs->_elif != nullptr )
+                for (auto &branch : ifs->_elif->_elif)
+                    reads(branch.first.get(), names);
+            carried(names, assigned);
+
+            // What every branch assigns is assigned after the if - with no
+            // else, no branch may run.
+            Names after = carried(ifs->_if->_if.second.get(), assigned);
+            if ( ifs->_elif != nullptr )
+                for (auto &branch : ifs->_elif->_elif) {
+                    Names taken = carried(branch.second.get(), assigned);
+                    for (auto it = after.begin(); it != after.end(); )
+                        it = taken.count(*it) != 0 ? std::next(it) : after.erase(it);
+                }
+            if ( ifs->_else != nullptr ) {
+                Names taken = carried(ifs->_else->_stmts.get(), assigned);
+                for (auto it = after.begin(); it != after.end(); )
+                    it = taken.count(*it) != 0 ? std::next(it) : after.erase(it);
+                assigned = after;
+            }
+
+        } else if ( auto range = dynamic_cast<RangeStmt *>(statement.get()) ) {
+            reads(range->_iterable.get(), names);
+            if ( range->_testList != nullptr )
+                for (auto &expr : *range->_testList)
+                    reads(expr.get(), names);
+            carried(names, assigned);
+
+            // The body may not run, and its first run reads what the
+            // iteration left before the loop.
+            Names inner = assigned;
+            inner.insert(range->_id);
+            carried(range->_forBody.get(), inner);
+        }
+    }
+
+    return assigned;
+}
+
+void Prange::carried(const Names &reads, const Names &assigned) {
+
+    for (auto &name : reads) {
+        bool reduction = false;
+        for (auto &r : _reductions)
+            reduction = reduction || r.name == name;
+
+        if ( reduction || (_assigned.count(name) != 0 && assigned.count(name) == 0) ) {
+            if (debug)
+                Script::out() << "Prange::carried - " << name << " passes from one iteration to the next" << std::endl;
+            _serial = true;
+        }
+    }
+}
+
+void Prange::reads(ExprNode *expr, Names &names) {
+
+    if ( expr == nullptr )
+        return;
+
+    if ( dynamic_cast<Variable *>(expr) ) {
+        names.insert(expr->token()->getName());
+    } else if ( auto infix = dynamic_cast<InfixExprNode *>(expr) ) {
+        reads(infix->_left.get(), names);
+        reads(infix->_right.get(), names);
+    } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(expr) ) {
+        reads(comparison->_left.get(), names);
+        reads(comparison->_right.get(), names);
+    } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(expr) ) {
+        reads(boolean->_left.get(), names);
+        reads(boolean->_right.get(), names);
+    } else if ( auto membership = dynamic_cast<MembershipExprNode *>(expr) ) {
+        reads(membership->_left.get(), names);
+        reads(membership->_right.get(), names);
+    } else if ( auto call = dynamic_cast<FunctionCall *>(expr) ) {
+        for (auto &argument : *call->_testList)
+            reads(argument.get(), names);
+    } else if ( auto list = dynamic_cast<ListExp *>(expr) ) {
+        for (auto &element : *list->_elements)
+            reads(element.get(), names);
+    } else if ( auto dict = dynamic_cast<DictExp *>(expr) ) {
+        for (auto &key : *dict->_keys)
+            reads(key.get(), names);
+        for (auto &value : *dict->_values)
+            reads(value.get(), names);
+    } else if ( auto subscript = dynamic_cast<Subscript *>(expr) ) {
+        reads(subscript->_sequence.get(), names);
+        reads(subscript->_index.get(), names);
+    } else if ( auto len = dynamic_cast<LenExp *>(expr) ) {
+        reads(len->_sequence.get(), names);
+    }
+}
+
+void Prange::run(SymTab &symTab, int64_t start, int64_t end, int64_t step, bool countDown) {
+
+    // A prange inside a prange body runs on the worker that reached it, a
+    // body that may return stops at the iteration that does, and iterations
+    // that pass values on run in order.
+    if ( WorkPool::inWorker() || _serial ) {
+        _stmt->iterate(symTab, start, end, step, countDown);
+        return;
+    }
+
+    std::vector<std::shared_ptr<TypeDescriptor>> identities;
+    for (auto &reduction : _reductions) {
+        if ( !symTab.isDefined(reduction.name) ) {
+            Script::out() << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
+            Script::out() << "Use of undefined variable, " << reduction.name << std::endl;
+            Script::exit(1);
+        }
+
+        auto type = symTab.getValueFor(reduction.name)->type();
+        bool add = reduction.op->isAdditionOperator();
+
+        if ( type == TypeDescriptor::INTEGER )
+            identities.push_back(Descriptor::Int::createIntDescriptor(Integer((int64_t) (add ? 0 : 1))));
+        else if ( type == TypeDescriptor::DOUBLE )
+            identities.push_back(Descriptor::Double::createDoubleDescriptor(add ? 0.0 : 1.0));
+        else if ( type == TypeDescriptor::STRING && add )
+            identities.push_back(Descriptor::String::createStringDescriptor(""));
+        else {
+            // No identity to start a chunk from - keep Python's order.
+            _stmt->iterate(symTab, start, end, step, countDown);
+            return;
+        }
+    }
+
+    // Every chunk starts from the values before the loop.
+    std::vector<std::shared_ptr<TypeDescriptor>> before;
+    for (auto &name : _privates)
+        before.push_back(symTab.isDefined(name) ? Descriptor::copyReferencePtr(symTab.getValueFor(name)) : nullptr);
+
+    uint64_t span = countDown ? (uint64_t) start - (uint64_t) end : (uint64_t) end - (uint64_t) start;
+    uint64_t stride = countDown ? 0 - (uint64_t) step : (uint64_t) step;
+    uint64_t iterations = span / stride + (span % stride != 0);
+    size_t chunks = (size_t) std::min<uint64_t>(iterations, maxChunks);
+    // The first `longer` chunks take one iteration more than `size`.
+    uint64_t size = iterations / chunks, longer = iterations % chunks;
+
+    WorkPool &pool = WorkPool::shared();
+    std::vector<std::unique_ptr<SymTab>> tables(pool.threads());
+    std::vector<std::vector<std::shared_ptr<TypeDescriptor>>> partials(chunks);
+    // Each private as the last chunk that assigned it left it.
+    std::vector<std::shared_ptr<TypeDescriptor>> last(_privates.size());
+    std::vector<size_t> lastChunk(_privates.size());
+
+    std::vector<std::string> outputs(chunks);
+    std::vector<bool> finished(chunks, false);
+    size_t flushed = 0;
+    std::mutex outputLock;
+    std::ostream &out = Script::out();
+
+    // The first chunk a fatal error ended, and its status. The loop stops
+    // there as the serial one would - what the chunks before it printed is
+    // written out, and nothing after it.
+    std::atomic<size_t> failed{chunks};
+    int status = 0;
+
+    if (debug)
+        Script::out() << "Prange::run - " << iterations << " iterations in " << chunks << " chunks" << std::endl;
+
+    pool.run(chunks, [&](size_t chunk, unsigned worker) {
+
+        if ( chunk > failed )
+            return;
+
+        if ( tables[worker] == nullptr )
+            tables[worker] = std::make_unique<SymTab>(symTab.snapshot());
+        SymTab &table = *tables[worker];
+
+        for (size_t r = 0; r < _reductions.size(); r++)
+            table.setValueFor(_reductions[r].name, Descriptor::copyReferencePtr(identities[r].get()));
+
+        // An assignment always binds a new descriptor, so the one the chunk
+        // started from - held here, so its address can't be reused - still
+        // bound at the end means the chunk left the private alone.
+        std::vector<std::shared_ptr<TypeDescriptor>> initial(_privates.size());
+        for (size_t p = 0; p < _privates.size(); p++) {
+            if ( before[p] != nullptr ) {
+                initial[p] = Descriptor::copyReferencePtr(before[p].get());
+                table.setValueFor(_privates[p], initial[p]);
+            } else
+                table.erase(_privates[p]);
+        }
+
+        std::ostringstream buffer;
+        std::optional<int> exitStatus;
+        {
+            Script::Redirect redirect(buffer);
+            // Script::exit() throws on any thread, for the chunk to catch.
+            Script::Job job;
+            runningChunk = true;
+
+            try {
+                uint64_t first = chunk * size + std::min<uint64_t>(chunk, longer);
+                uint64_t stop = first + size + (chunk < longer);
+                for (uint64_t k = first; k < stop; k++) {
+                    table.setValueFor(_stmt->_id, Descriptor::Int::createIntDescriptor((int64_t) ((uint64_t) start + k * (uint64_t) step)));
+                    _stmt->_forBody->evaluate(table);
+                }
+                table.erase(_stmt->_id);
+            } catch (const Script::Exit &exit) {
+                exitStatus = exit.status;
+            }
+
+            runningChunk = false;
+        }
+
+        std::vector<std::shared_ptr<TypeDescriptor>> assigned(_privates.size());
+        if ( exitStatus ) {
+            // It may have stopped inside a function's scope.
+            tables[worker].reset();
+        } else {
+            for (auto &reduction : _reductions)
+                partials[chunk].push_back(Descriptor::copyReferencePtr(table.getValueFor(reduction.name)));
+
+            for (size_t p = 0; p < _privates.size(); p++)
+                if ( table.isDefined(_privates[p]) && table.getValueFor(_privates[p]) != initial[p].get() )
+                    assigned[p] = Descriptor::copyReferencePtr(table.getValueFor(_privates[p]));
+        }
+
+        // Write out every finished chunk that nothing unfinished precedes.
+        std::lock_guard<std::mutex> guard(outputLock);
+        for (size_t p = 0; p < _privates.size(); p++)
+            if ( assigned[p] != nullptr && (last[p] == nullptr || chunk > lastChunk[p]) ) {
+                last[p] = std::move(assigned[p]);
+                lastChunk[p] = chunk;
+            }
+        if ( exitStatus && chunk < failed ) {
+            failed = chunk;
+            status = *exitStatus;
+        }
+        outputs[chunk] = buffer.str();
+        finished[chunk] = true;
+        for (; flushed <= std::min(failed.load(), chunks - 1) && finished[flushed]; flushed++) {
+            out << outputs[flushed];
+            outputs[flushed].clear();
+        }
+    });
+
+    out.flush();
+
+    if ( failed < chunks )
+        Script::exit(status);
+
+    for (size_t r = 0; r < _reductions.size(); r++) {
+        std::shared_ptr<TypeDescriptor> value = Descriptor::copyReferencePtr(symTab.getValueFor(_reductions[r].name));
+        for (size_t chunk = 0; chunk < chunks; chunk++)
+            value = Descriptor::relOperatorDescriptor(value.get(), partials[chunk][r].get(), _reductions[r].op);
+        symTab.setValueFor(_reductions[r].name, value);
+    }
+
+    for (size_t p = 0; p < _privates.size(); p++)
+        if ( last[p] != nullptr )
+            symTab.setValueFor(_privates[p], last[p]);
+}
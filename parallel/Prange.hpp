@@ -0,0 +1,81 @@
+#ifndef __PRANGE_HPP
+#define __PRANGE_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class ExprNode;
+class RangeStmt;
+class Statements;
+class SymTab;
+class Token;
+
+// for x in prange(start, end[, step]): - a range loop whose iterations run on
+// the shared WorkPool.
+//
+// The iterations are cut into at most maxChunks chunks of consecutive
+// iterations - how many depends only on the loop, never on the number of
+// threads. Every chunk starts from the variables' values before the loop,
+// with its own loop variable. A name the body only ever updates as
+//
+//     name = name + <expr>      or      name = name * <expr>
+//
+// where nothing else in the body reads it, <expr> included, is a reduction:
+// each chunk accumulates from 0, 1 or '' of the name's type, and the
+// partial results are folded into the value from before the loop in
+// iteration order. Any other name the body assigns is private to the
+// chunk; after the loop it has the value the last chunk to assign it left.
+// Print output is kept per chunk and written out in iteration order. A
+// fatal error stops the loop at its chunk: the output up to it is written,
+// then the error ends the script from the thread that ran the loop.
+//
+// A body whose iterations pass values on runs serially - one that reads a
+// reduction outside its update, or a private before each iteration assigns
+// it - and so does a body that may return.
+//
+// Lists and dicts are shared. Appending and storing items are serialized,
+// but reading a container that other iterations are changing is a race.
+
+class Prange {
+
+public:
+    Prange(RangeStmt *);
+
+    void run(SymTab &symTab, int64_t start, int64_t end, int64_t step, bool countDown);
+
+    // Locked while a prange body changes a list or dict; unlocked elsewhere.
+    static std::unique_lock<std::mutex> lockContainers();
+    // True while running a prange body.
+    static bool inBody();
+
+private:
+    struct Reduction {
+        std::string name;
+        std::shared_ptr<Token> op;
+    };
+
+    typedef std::set<std::string> Names;
+
+    void collect(Statements *stmts);
+    Names carried(Statements *stmts, Names assigned);
+    void carried(const Names &reads, const Names &assigned);
+    static void reads(ExprNode *expr, Names &names);
+
+    static constexpr size_t maxChunks = 256;
+
+    RangeStmt *_stmt;
+    std::vector<Reduction> _reductions;
+    std::vector<std::string> _privates;
+
+    // Filled by collect() - updates of the reduction form, and everything else.
+    std::map<std::string, std::shared_ptr<Token>> _updates;
+    std::set<std::string> _assigned;
+    // Set when the iterations can't run apart - see carried().
+    bool _serial = false;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "WorkPool.hpp"
+#include "../Debug.hpp"
+
+unsigned WorkPool::_requested = 0;
+
+static thread_local bool insideTask = false;
+static thread_local unsigned currentWorker = 0;
+
+WorkPool &WorkPool::shared() {
+    static WorkPool *pool = new WorkPool(_requested != 0 ? _requested : std::max(1u, std::thread::hardware_concurrency()));
+    return *pool;
+}
+
+void WorkPool::setThreads(unsigned threads) {
+    _requested = threads;
+}
+
+bool WorkPool::inWorker() {
+    return insideTask;
+}
+
+WorkPool::WorkPool(unsigned threads):
+    _threads{threads},
+    _blocks{std::make_unique<Block[]>(threads)},
+    _task{nullptr},
+    _generation{0},
+    _busy{0}
+{
+    if (debug)
+        std::cout << "WorkPool::WorkPool - " << _threads << " threads" << std::endl;
+
+    for (unsigned w = 1; w < _threads; w++) {
+        _workers.emplace_back(&WorkPool::wait, this, w);
+        _workers.back().detach();
+    }
+}
+
+void WorkPool::run(size_t tasks, const std::function<void(size_t, unsigned)> &task) {
+
+    // One run at a time - a thread that finds the pool busy does its own tasks.
+    std::unique_lock<std::mutex> running(_running, std::defer_lock);
+
+    if ( insideTask || _threads == 1 || tasks <= 1 || !running.try_lock() ) {
+        bool outer = insideTask;
+        insideTask = true;
+        try {
+            for (size_t i = 0; i < tasks; i++)
+                task(i, currentWorker);
+        } catch (...) {
+            insideTask = outer;
+            throw;
+        }
+        insideTask = outer;
+        return;
+    }
+
+    for (unsigned w = 0; w < _threads; w++) {
+        std::lock_guard<std::mutex> guard(_blocks[w].lock);
+        _blocks[w].next = tasks * w / _threads;
+        _blocks[w].end = tasks * (w + 1) / _threads;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _task = &task;
+        _busy = _threads - 1;
+        _generation++;
+    }
+    _wake.notify_all();
+
+    insideTask = true;
+    work(0);
+    insideTask = false;
+
+    // No worker may still be calling the task when it goes out of scope.
+    std::unique_lock<std::mutex> guard(_lock);
+    _done.wait(guard, [this] { return _busy == 0; });
+    _task = nullptr;
+
+    if ( _failure != nullptr )
+        std::rethrow_exception(std::exchange(_failure, nullptr));
+}
+
+void WorkPool::wait(unsigned worker) {
+
+    currentWorker = worker;
+    insideTask = true;
+
+    for (uint64_t seen = 0; ; ) {
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _wake.wait(guard, [&] { return _generation != seen; });
+            seen = _generation;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> guard(_lock);
+        if ( --_busy == 0 )
+            _done.notify_one();
+    }
+}
+
+void WorkPool::work(unsigned worker) {
+    size_t task;
+    while ( take(worker, task) ) {
+        try {
+            (*_task)(task, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(_lock);
+            if ( _failure == nullptr )
+                _failure = std::current_exception();
+        }
+    }
+}
+
+bool WorkPool::take(unsigned worker, size_t &task) {
+
+    {
+        Block &own = _blocks[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if ( own.next < own.end ) {
+            task = own.next++;
+            return true;
+        }
+    }
+
+    // Steal from the back of whichever block has the most left.
+    for (;;) {
+        unsigned victim = worker;
+        size_t most = 0;
+        for (unsigned w = 0; w < _threads; w++) {
+            std::lock_guard<std::mutex> guard(_blocks[w].lock);
+            if ( _blocks[w].end - _blocks[w].next > most ) {
+                most = _blocks[w].end - _blocks[w].next;
+                victim = w;
+            }
+        }
+
+        if ( most == 0 )
+            return false;
+
+        std::lock_guard<std::mutex> guard(_blocks[victim].lock);
+        if ( _blocks[victim].next < _blocks[victim].end ) {
+            task = --_blocks[victim].end;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef __WORK_POOL_HPP
+#define __WORK_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that share out numbered tasks. run() deals each
+// worker a contiguous block of the tasks; a worker takes its own from the
+// front and, once they are gone, steals single tasks from the back of the
+// fullest remaining block. The calling thread works too, as worker 0.
+
+class WorkPool {
+
+public:
+    // The process-wide pool - started on first use and never torn down, so a
+    // worker that calls exit() is not left waiting to join itself.
+    static WorkPool &shared();
+    // Size of the shared pool, 0 for one thread per core. Only before first use.
+    static void setThreads(unsigned threads);
+
+    unsigned threads() const { return _threads; }
+
+    // Runs task(i, worker) for every i in [0, tasks) and returns once all of
+    // them are done. From inside a task, or while another thread's run() has
+    // the pool, it runs them inline on the calling thread. A task that throws
+    // doesn't stop the others; once every worker is done, the first exception
+    // is rethrown on the calling thread.
+    void run(size_t tasks, const std::function<void(size_t, unsigned)> &task);
+
+    // True on a thread that is running one of run()'s tasks.
+    static bool inWorker();
+
+private:
+    WorkPool(unsigned threads);
+
+    void wait(unsigned worker);
+    void work(unsigned worker);
+    bool take(unsigned worker, size_t &task);
+
+    // Kept on separate cache lines - the owner and the thieves all lock them.
+    struct alignas(64) Block {
+        std::mutex lock;
+        size_t next = 0, end = 0;
+    };
+
+    unsigned _threads;
+    std::unique_ptr<Block[]> _blocks;
+    std::vector<std::thread> _workers;
+
+    std::mutex _running;
+    std::mutex _lock;
+    std::condition_variable _wake, _done;
+    const std::function<void(size_t, unsigned)> *_task;
+    uint64_t _generation;
+    unsigned _busy;
+    std::exception_ptr _failure;
+
+    static unsigned _requested;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Client.hpp"
+#include "Protocol.hpp"
+
+namespace Client {
+
+int submit(const std::string &socketPath, const std::string &script) {
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if ( socketPath.size() >= sizeof(address.sun_path) ) {
+        std::cout << "Client::submit - socket path " << socketPath << " is too long" << std::endl;
+        return 2;
+    }
+    socketPath.copy(address.sun_path, socketPath.size());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( server < 0 || connect(server, (sockaddr *) &address, sizeof(address)) != 0 ) {
+        std::cout << "Unable to reach a server on " << socketPath << ". Terminating...";
+        perror("");
+        return 2;
+    }
+
+    // The server has its own working directory.
+    char absolute[PATH_MAX];
+    std::string request = (realpath(script.c_str(), absolute) != nullptr ? absolute : script) + "\n";
+    if ( write(server, request.data(), request.size()) != (ssize_t) request.size() ) {
+        close(server);
+        return 2;
+    }
+
+    char type;
+    std::string data;
+    while ( Protocol::readFrame(server, type, data) ) {
+        if ( type == Protocol::OUTPUT ) {
+            std::cout << data << std::flush;
+        } else if ( type == Protocol::EXIT ) {
+            close(server);
+            return atoi(data.c_str());
+        }
+    }
+
+    close(server);
+    std::cout << "Client::submit - the server closed the connection" << std::endl;
+    return 2;
+}
+
+};
@@ -0,0 +1,16 @@
+#ifndef __CLIENT_HPP
+#define __CLIENT_HPP
+
+#include <string>
+
+// --client: has a --serve process run a script, printing its output as it
+// arrives. Returns the script's exit status, or 2 when the server can't be
+// reached.
+
+namespace Client {
+
+    int submit(const std::string &socketPath, const std::string &script);
+
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ForkServer.hpp"
+#include "Protocol.hpp"
+#include "../Debug.hpp"
+#include "../parallel/WorkPool.hpp"
+
+ForkServer::ForkServer(std::string socketPath, std::string preludePath, bool lazyFunctions):
+    _socketPath{socketPath},
+    _preludePath{preludePath},
+    _lazyFunctions{lazyFunctions},
+    _listener{-1}
+{}
+
+int ForkServer::serve() {
+
+    // Pool threads would not survive into the children.
+    WorkPool::setThreads(1);
+
+    auto prelude = Interp::Program::compileFile(_preludePath, std::cout, _lazyFunctions);
+    if ( prelude == nullptr || prelude->run(_globals, std::cout) != 0 )
+        return 1;
+
+    _listener = Protocol::listenOn(_socketPath);
+    if ( _listener < 0 )
+        return 2;
+
+    if (debug)
+        std::cout << "ForkServer::serve - " << _socketPath << " after " << _preludePath << std::endl;
+
+    // Children are reaped by the kernel.
+    signal(SIGCHLD, SIG_IGN);
+    std::cout.flush();
+
+    for (;;) {
+        int client = accept(_listener, nullptr, nullptr);
+        if ( client < 0 )
+            continue;
+
+        pid_t child = fork();
+        if ( child == 0 ) {
+            close(_listener);
+            handle(client);
+            _exit(0);
+        }
+
+        if ( child < 0 ) {
+            std::string message = "ForkServer::serve - fork failed\n", status = "2";
+            Protocol::writeFrame(client, Protocol::OUTPUT, message.data(), message.size());
+            Protocol::writeFrame(client, Protocol::EXIT, status.data(), status.size());
+        }
+        close(client);
+    }
+}
+
+// In the child - parses the script and runs it on the prelude's globals.
+void ForkServer::handle(int client) {
+
+    std::string path;
+    if ( !Protocol::readLine(client, path) )
+        return;
+
+    int status;
+    std::ostringstream errors;
+
+    if ( access(path.c_str(), R_OK) != 0 ) {
+        std::string message = "Unable to open " + path + "\n";
+        Protocol::writeFrame(client, Protocol::OUTPUT, message.data(), message.size());
+        status = 2;
+    } else if ( auto program = Interp::Program::compileFile(path, errors, _lazyFunctions) ) {
+        Protocol::OutputFrames frames(client);
+        std::ostream out(&frames);
+        status = program->run(_globals, out);
+        out.flush();
+    } else {
+        std::string message = errors.str();
+        Protocol::writeFrame(client, Protocol::OUTPUT, message.data(), message.size());
+        status = 1;
+    }
+
+    std::string exit = std::to_string(status);
+    Protocol::writeFrame(client, Protocol::EXIT, exit.data(), exit.size());
+}
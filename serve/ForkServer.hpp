@@ -0,0 +1,35 @@
+#ifndef __FORK_SERVER_HPP
+#define __FORK_SERVER_HPP
+
+#include <string>
+
+#include "../embed/Interp.hpp"
+
+// --serve with --prelude: runs the prelude once, then answers every --client
+// request from a fork() of that process. The child inherits the prelude's
+// functions and variables copy-on-write, parses just the requested script,
+// runs it on top of them and exits; the parent only accepts and forks.
+//
+// The parent forks with no other threads running, so prange loops run
+// serially here - the forked jobs are what run side by side.
+
+class ForkServer {
+
+public:
+    ForkServer(std::string socketPath, std::string preludePath, bool lazyFunctions);
+
+    // Returns only when the prelude fails or the socket can't be set up.
+    int serve();
+
+private:
+    void handle(int client);
+
+    std::string _socketPath;
+    std::string _preludePath;
+    bool _lazyFunctions;
+    int _listener;
+
+    Interp::Globals _globals;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Protocol.hpp"
+
+namespace Protocol {
+
+static bool writeAll(int fd, const char *data, size_t length) {
+    while ( length > 0 ) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if ( sent <= 0 )
+            return false;
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+static bool readAll(int fd, char *data, size_t length) {
+    while ( length > 0 ) {
+        ssize_t got = read(fd, data, length);
+        if ( got <= 0 )
+            return false;
+        data += got;
+        length -= got;
+    }
+    return true;
+}
+
+int listenOn(const std::string &path) {
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if ( path.size() >= sizeof(address.sun_path) ) {
+        std::cout << "Protocol::listenOn - socket path " << path << " is too long" << std::endl;
+        return -1;
+    }
+    path.copy(address.sun_path, path.size());
+
+    // A socket file left by a server that is gone would fail the bind.
+    unlink(path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( listener < 0 || bind(listener, (sockaddr *) &address, sizeof(address)) != 0 || listen(listener, 64) != 0 ) {
+        std::cout << "Unable to serve on " << path << ". Terminating...";
+        perror("");
+        return -1;
+    }
+    return listener;
+}
+
+bool writeFrame(int fd, char type, const char *data, uint32_t length) {
+    char header[5] = { type, (char) length, (char) (length >> 8), (char) (length >> 16), (char) (length >> 24) };
+    return writeAll(fd, header, sizeof(header)) && writeAll(fd, data, length);
+}
+
+bool readFrame(int fd, char &type, std::string &data) {
+    unsigned char header[5];
+    if ( !readAll(fd, (char *) header, sizeof(header)) )
+        return false;
+
+    type = header[0];
+    uint32_t length = header[1] | header[2] << 8 | header[3] << 16 | (uint32_t) header[4] << 24;
+    data.resize(length);
+    return readAll(fd, data.data(), length);
+}
+
+bool readLine(int fd, std::string &line) {
+    line.clear();
+    for (char c; ; ) {
+        if ( read(fd, &c, 1) != 1 )
+            return false;
+        if ( c == '\n' )
+            return true;
+        line += c;
+    }
+}
+
+// START "OUTPUTFRAMES"
+OutputFrames::OutputFrames(int fd):
+    _fd{fd},
+    _buffer(4096)
+{
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+OutputFrames::~OutputFrames() {
+    sync();
+}
+
+OutputFrames::int_type OutputFrames::overflow(int_type c) {
+    if ( sync() != 0 )
+        return traits_type::eof();
+
+    if ( !traits_type::eq_int_type(c, traits_type::eof()) ) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+// A client that hung up just stops receiving - the script still runs to the end.
+int OutputFrames::sync() {
+    if ( pptr() > pbase() )
+        writeFrame(_fd, OUTPUT, pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    return 0;
+}
+// END "OUTPUTFRAMES"
+
+};
@@ -0,0 +1,50 @@
+#ifndef __PROTOCOL_HPP
+#define __PROTOCOL_HPP
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// What --serve and --client say over the Unix socket. The client sends the
+// script's absolute path and a newline; the server answers with frames - a
+// type byte, a 4-byte little-endian length, then that many bytes:
+//
+//     'o'  output, as the script prints it
+//     'x'  the exit status as text - the last frame
+
+namespace Protocol {
+
+    const char OUTPUT = 'o';
+    const char EXIT = 'x';
+
+    // A listening socket at `path`, replacing a stale socket file - or -1,
+    // with the reason printed.
+    int listenOn(const std::string &path);
+
+    // False once the peer has gone.
+    bool writeFrame(int fd, char type, const char *data, uint32_t length);
+    bool readFrame(int fd, char &type, std::string &data);
+
+    // Reads up to a newline, without it.
+    bool readLine(int fd, std::string &line);
+
+    // Sends what is written to it as output frames - whenever the buffer
+    // fills and at every flush, so a script's lines arrive as it prints them.
+    class OutputFrames : public std::streambuf {
+    public:
+        OutputFrames(int fd);
+        ~OutputFrames();
+
+    protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+
+    private:
+        int _fd;
+        std::vector<char> _buffer;
+    };
+
+};
+
+#endif
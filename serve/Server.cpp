@@ -0,0 +1,103 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Server.hpp"
+#include "Protocol.hpp"
+#include "../Debug.hpp"
+
+Server::Server(std::string socketPath, unsigned threads, bool lazyFunctions):
+    _socketPath{socketPath},
+    _threads{threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())},
+    _lazyFunctions{lazyFunctions},
+    _listener{-1}
+{}
+
+int Server::serve() {
+
+    _listener = Protocol::listenOn(_socketPath);
+    if ( _listener < 0 )
+        return 2;
+
+    if (debug)
+        std::cout << "Server::serve - " << _socketPath << " with " << _threads << " workers" << std::endl;
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 1; w < _threads; w++)
+        workers.emplace_back(&Server::work, this);
+    work();
+
+    return 0;
+}
+
+void Server::work() {
+    for (;;) {
+        int client = accept(_listener, nullptr, nullptr);
+        if ( client < 0 )
+            continue;
+
+        handle(client);
+        close(client);
+    }
+}
+
+void Server::handle(int client) {
+
+    std::string path;
+    if ( !Protocol::readLine(client, path) )
+        return;
+
+    if (debug)
+        std::cout << "Server::handle - " << path << std::endl;
+
+    int status;
+    struct stat info;
+
+    if ( stat(path.c_str(), &info) != 0 ) {
+        std::string message = "Unable to open " + path + "\n";
+        Protocol::writeFrame(client, Protocol::OUTPUT, message.data(), message.size());
+        status = 2;
+    } else if ( auto entry = compiled(path, info); entry->program == nullptr ) {
+        Protocol::writeFrame(client, Protocol::OUTPUT, entry->errors.data(), entry->errors.size());
+        status = 1;
+    } else {
+        Protocol::OutputFrames frames(client);
+        std::ostream out(&frames);
+        status = entry->program->run(out);
+        out.flush();
+    }
+
+    std::string exit = std::to_string(status);
+    Protocol::writeFrame(client, Protocol::EXIT, exit.data(), exit.size());
+}
+
+// The cached program while the file is unchanged, otherwise a fresh compile.
+std::shared_ptr<const Server::Compiled> Server::compiled(const std::string &path, const struct stat &info) {
+
+    {
+        std::lock_guard<std::mutex> guard(_cacheLock);
+        auto cached = _cache.find(path);
+        if ( cached != _cache.end() && cached->second->size == info.st_size
+             && cached->second->mtime.tv_sec == info.st_mtim.tv_sec && cached->second->mtime.tv_nsec == info.st_mtim.tv_nsec )
+            return cached->second;
+    }
+
+    if (debug)
+        std::cout << "Server::compiled - compiling " << path << std::endl;
+
+    // Compiled outside the lock - two requests may both compile a new file.
+    auto entry = std::make_shared<Compiled>();
+    entry->mtime = info.st_mtim;
+    entry->size = info.st_size;
+
+    std::ostringstream errors;
+    entry->program = Interp::Program::compileFile(path, errors, _lazyFunctions);
+    entry->errors = errors.str();
+
+    std::lock_guard<std::mutex> guard(_cacheLock);
+    _cache[path] = entry;
+    return entry;
+}
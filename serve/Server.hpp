@@ -0,0 +1,47 @@
+#ifndef __SERVER_HPP
+#define __SERVER_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+
+#include "../embed/Interp.hpp"
+
+// --serve: a process that stays up and runs scripts for --client over a
+// Unix socket. A script is compiled on its first request and kept, keyed by
+// its path and modification time, so later requests skip lexing and parsing.
+// Each of the worker threads accepts a connection, runs its script with
+// fresh globals while streaming the output back, and accepts the next.
+
+class Server {
+
+public:
+    Server(std::string socketPath, unsigned threads, bool lazyFunctions);
+
+    // Returns only when the socket can't be set up.
+    int serve();
+
+private:
+    struct Compiled {
+        timespec mtime;
+        off_t size;
+        std::shared_ptr<const Interp::Program> program;
+        std::string errors;
+    };
+
+    void work();
+    void handle(int client);
+    std::shared_ptr<const Compiled> compiled(const std::string &path, const struct stat &info);
+
+    std::string _socketPath;
+    unsigned _threads;
+    bool _lazyFunctions;
+    int _listener;
+
+    std::mutex _cacheLock;
+    std::map<std::string, std::shared_ptr<const Compiled>> _cache;
+};
+
+#endif
@@ -4,6 +4,10 @@
 #include <algorithm>
 
 #include "Statement.hpp"
+#include "../jit/Jit.hpp"
+#include "../parallel/Prange.hpp"
+#include "../Parser.hpp"
+#include "../Script.hpp"
 
 // START "STATEMENT"
 Statement::Statement() {}
@@ -17,7 +21,7 @@ AssignStmt::AssignStmt(std::string lhsVar, std::unique_ptr<ExprNode> rhsExpr):
 
 AssignStmt::~AssignStmt() {
     if (destructor)
-        std::cout << "~AssignStmt()" << std::endl;
+        Script::out() << "~AssignStmt()" << std::endl;
 }
 
 
@@ -26,18 +30,18 @@ AssignStmt::~AssignStmt() {
 void AssignStmt::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "void AssignStmt::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "void AssignStmt::evaluate(SymTab &symTab)" << std::endl;
 
     auto rhs = _rhsExpression->evaluate(symTab);
     symTab.setValueFor(_lhsVariable, std::move(rhs));
 }
 
 void AssignStmt::dumpAST(std::string spaces) {
-    std::cout << spaces << "AssignStmt  ";
-    std::cout << this << '\t';
-    std::cout  << _lhsVariable << " = ";
+    Script::out() << spaces << "AssignStmt  ";
+    Script::out() << this << '\t';
+    Script::out()  << _lhsVariable << " = ";
     _rhsExpression->print();
-    std::cout << std::endl;
+    Script::out() << std::endl;
     _rhsExpression->dumpAST(spaces + '\t');
 
 }
@@ -52,7 +56,7 @@ IfStatement::IfStatement() :
 
 IfStatement::~IfStatement() {
     if (destructor)
-        std::cout << "~IfStatement()" << std::endl;
+        Script::out() << "~IfStatement()" << std::endl;
 }
 
 void IfStatement::addIfStmt(std::unique_ptr<IfStmt> ifStmt) {
@@ -70,11 +74,11 @@ void IfStatement::addElseStmt(std::unique_ptr<ElseStmt> elseStmt) {
 void IfStatement::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "void IfStatement::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "void IfStatement::evaluate(SymTab &symTab)" << std::endl;
 
     if ( _if == nullptr ) {
-        std::cout << "IfStatement::evaluate(SymTab &symTab) cannot evaluate nullptr _if" << std::endl;
-        exit(1);
+        Script::out() << "IfStatement::evaluate(SymTab &symTab) cannot evaluate nullptr _if" << std::endl;
+        Script::exit(1);
     }
 
     if ( _if->evaluate(symTab) )
@@ -88,9 +92,9 @@ void IfStatement::evaluate(SymTab &symTab) {
 }
 
 void IfStatement::dumpAST(std::string spaces) {
-    std::cout << spaces << "IfStatement  ";
-    std::cout << this << '\t';
-    std::cout << std::endl;
+    Script::out() << spaces << "IfStatement  ";
+    Script::out() << this << '\t';
+    Script::out() << std::endl;
     if ( _if != nullptr )
         _if->dumpAST(spaces + '\t');
     if ( _elif != nullptr )
@@ -108,24 +112,26 @@ PrintStatement::PrintStatement(std::unique_ptr<std::vector<std::unique_ptr<ExprN
 
 PrintStatement::~PrintStatement() {
     if (destructor)
-        std::cout << "~PrintStatement()" << std::endl;
+        Script::out() << "~PrintStatement()" << std::endl;
 }
 
 void PrintStatement::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "void PrintStatement::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "void PrintStatement::evaluate(SymTab &symTab)" << std::endl;
+
+    std::ostream &out = Script::out();
 
     for_each(_testList->begin(), _testList->end(), [&](auto &&item) {
-        Descriptor::printValue( item->evaluate(symTab).get() );
-        std::cout << " ";
+        Descriptor::printValue( item->evaluate(symTab).get(), out );
+        out << " ";
     });
-    std::cout << std::endl;
+    out << std::endl;
 }
 
 void PrintStatement::dumpAST(std::string spaces) {
     
-    std::cout << spaces << "AST_PrintStatement " << this << std::endl;
+    Script::out() << spaces << "AST_PrintStatement " << this << std::endl;
     for_each(_testList->begin(), _testList->end(), [&](auto &&item) {
         item->dumpAST(spaces + '\t');
     });
@@ -139,98 +145,153 @@ RangeStmt::RangeStmt(std::string id):
 
 RangeStmt::~RangeStmt() {
     if (destructor)
-        std::cout << "~RangeStmt" << std::endl;
+        Script::out() << "~RangeStmt" << std::endl;
 }
 
 void RangeStmt::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "void RangeStmt::Evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "void RangeStmt::Evaluate(SymTab &symTab)" << std::endl;
 
-    parseTestList(symTab);
+    for (auto &name : _hoisted)
+        symTab.erase(name);
 
-    if ( symTab.isDefined( _id ) ) {
-        std::cout << "Variable " << _id << " is defined - dying (( FIX )) " << std::endl;
-        exit(1);
-    }
+    // Compiled loops keep per-loop state - prange bodies stay interpreted.
+    if ( _jit != nullptr && !Prange::inBody() && _jit->run(symTab) )
+        return;
 
-    int start, end, step;
+    if ( _iterable != nullptr ) {
+        iterateSequence(symTab);
+        return;
+    }
 
-    start = _start.value_or(0);
+    int64_t start, end, step;
+    parseTestList(symTab, start, end, step);
 
-    //End is required...lets not fall back on the optional
-    if ( !_end.has_value() ) {
-        std::cout << "No value in range statement for end. FATAL ERROR" << std::endl;
-        exit(1);
+    if ( symTab.isDefined( _id ) ) {
+        Script::out() << "Variable " << _id << " is defined - dying (( FIX )) " << std::endl;
+        Script::exit(1);
     }
 
-    end = _end.value(); //THIS IS AN ERR WE MUST HAVE A VALUE FOR END
-    step = _step.value_or(1); 
-      
-    symTab.createEntryFor(_id, start);
- 
     if (start > end && step < 0) {
+        if ( _parallel != nullptr )
+            _parallel->run(symTab, start, end, step, true);
+        else
+            iterate(symTab, start, end, step, true);
+    } else if (start < end && 1 <= step) {
+        if ( _parallel != nullptr )
+            _parallel->run(symTab, start, end, step, false);
+        else
+            iterate(symTab, start, end, step, false);
+    } else if (start == end) {
+        return;
+    } else {
+        Script::out() << "Invalid For Loop" << std::endl;
+        Script::out() << "Start: " << start << "\t End: " << end << "\t Step: " << step << std::endl;
+        Script::exit(1);
+    }
+}
+
+void RangeStmt::iterate(SymTab &symTab, Integer from, int64_t end, int64_t step, bool countDown) {
 
+    symTab.createEntryFor(_id, std::move(from));
+
+    if (countDown) {
         for (; Descriptor::Int::getIntValue(symTab.getValueFor(_id)) > end; Descriptor::Int::incrementByN(step, symTab.getValueFor(_id))) {
             _forBody->evaluate(symTab);
+            if ( symTab.isReturning() )
+                break;
+        }
+    } else {
+        for (; Descriptor::Int::getIntValue(symTab.getValueFor(_id)) < end; Descriptor::Int::incrementByN(step, symTab.getValueFor(_id))) {
+            _forBody->evaluate(symTab);
+            if ( symTab.isReturning() )
+                break;
         }
+    }
 
+    symTab.erase(_id);
+}
+ 
+// The sequence is evaluated once; a list that grows inside the loop is
+// walked to its new end, as in Python.
+void RangeStmt::iterateSequence(SymTab &symTab) {
 
-    } else if (start < end && 1 <= step) {
+    auto sequence = _iterable->evaluate(symTab);
 
-        for (; Descriptor::Int::getIntValue(symTab.getValueFor(_id)) < end; Descriptor::Int::incrementByN(step, symTab.getValueFor(_id))) {
+    auto type = sequence->type();
+    if ( type != TypeDescriptor::LIST && type != TypeDescriptor::STRING && type != TypeDescriptor::DICT ) {
+        Script::out() << "RangeStmt::evaluate - Fatal Error - type " << sequence->type() << " is not iterable" << std::endl;
+        Script::exit(1);
+    }
+
+    if ( symTab.isDefined( _id ) ) {
+        Script::out() << "Variable " << _id << " is defined - dying (( FIX )) " << std::endl;
+        Script::exit(1);
+    }
+
+    if ( sequence->type() == TypeDescriptor::STRING ) {
+        std::string str = Descriptor::String::getStringValue(sequence.get());
+        for (char c : str) {
+            symTab.setValueFor(_id, Descriptor::String::createStringDescriptor(std::string(1, c)));
             _forBody->evaluate(symTab);
+            if ( symTab.isReturning() )
+                break;
+        }
+    } else if ( sequence->type() == TypeDescriptor::DICT ) {
+        // Keys in insertion order, including any the body adds.
+        for (size_t i = 0; i < Descriptor::Dict::length(sequence.get()); i++) {
+            symTab.setValueFor(_id, Descriptor::Dict::keyAt(sequence.get(), i));
+            _forBody->evaluate(symTab);
+            if ( symTab.isReturning() )
+                break;
         }
-
-    } else if (start == end) {
-        symTab.erase(_id);  
-        return;
     } else {
-        std::cout << "Invalid For Loop" << std::endl;
-        std::cout << "Start: " << start << "\t End: " << end << "\t Step: " << step << std::endl;
-        exit(1);
+        for (size_t i = 0; i < Descriptor::List::length(sequence.get()); i++) {
+            symTab.setValueFor(_id, Descriptor::List::getItem(sequence.get(), i));
+            _forBody->evaluate(symTab);
+            if ( symTab.isReturning() )
+                break;
+        }
     }
 
-    symTab.erase(_id);    
-
+    symTab.erase(_id);
 }
- 
+
 void RangeStmt::dumpAST(std::string space) {
     
-    std::cout << space;
-    std::cout << std::setw(15) << std::left << "AST_RangeStmt " << this;
-    std::cout << std::endl;
+    Script::out() << space;
+    Script::out() << std::setw(15) << std::left << "AST_RangeStmt " << this;
+    Script::out() << std::endl;
 
+    if ( _iterable != nullptr )
+        _iterable->dumpAST(space + '\t');
     _forBody->dumpAST(space + '\t');
 }
 
-void RangeStmt::parseTestList(SymTab &symTab) {
+void RangeStmt::parseTestList(SymTab &symTab, int64_t &start, int64_t &end, int64_t &step) {
 
     if ( _testList->size() > 3 ) {
-        std::cout << "Too many nodes!" << std::endl;
-        exit(1);
+        Script::out() << "Too many nodes!" << std::endl;
+        Script::exit(1);
     }
 
-    int i = 0;
-    for_each(_testList->begin(), _testList->end(), [&, this](auto &item) {
+    //End is required
+    if ( _testList->empty() ) {
+        Script::out() << "No value in range statement for end. FATAL ERROR" << std::endl;
+        Script::exit(1);
+    }
 
+    std::vector<int64_t> values;
+    for_each(_testList->begin(), _testList->end(), [&](auto &item) {
         auto desc = item->evaluate(symTab);
-        int intVal = Descriptor::Int::getIntValue(desc.get());
-
-        editOptionals(i, std::optional<int>{ intVal });
-
-        i++;
-
+        values.push_back(Descriptor::Int::getSmallIntValue(desc.get()));
     });
 
-    for (; i < 3; i++)
-        editOptionals(i, std::optional<int>{ std::nullopt });
-
-    // Adjust
-    if ( !_end.has_value() && !_step.has_value() ) {
-        _end = _start;
-        _start = std::optional<int>{};
-    }
+    // range(end), range(start, end) or range(start, end, step)
+    start = values.size() > 1 ? values[0] : 0;
+    end = values.size() > 1 ? values[1] : values[0];
+    step = values.size() > 2 ? values[2] : 1;
 }
 
 // void RangeStmt::addStatements(std::unique_ptr<GroupedStatements> gs) {
@@ -244,16 +305,12 @@ void RangeStmt::addTestList(std::unique_ptr<std::vector<std::unique_ptr<ExprNode
     _testList = std::move(testList);
 }
 
-void RangeStmt::editOptionals(int which, std::optional<int> opt) {
-
-    if ( which == 0 )
-        _start = opt;
-
-    if ( which == 1 )
-        _end = opt;
+void RangeStmt::addIterable(std::unique_ptr<ExprNode> iterable) {
+    _iterable = std::move(iterable);
+}
 
-    if ( which == 2 )
-        _step = opt;
+void RangeStmt::makeParallel() {
+    _parallel = std::make_unique<Prange>(this);
 }
 // END "RangeSTMT"
 
@@ -270,10 +327,28 @@ FunctionDefinition::FunctionDefinition(
     _hasBeenAddedToSymTab{hasBeenAddedToSymTab}
 {}
 
+FunctionDefinition::FunctionDefinition(
+    std::string funcName,
+    std::vector<std::string> paramList,
+    std::vector<std::shared_ptr<Token>> lazySuite):
+    _funcName{funcName},
+    _paramList{paramList},
+    _SUITE_NOT_FUNC_SUITE_FIX{nullptr},
+    _hasBeenAddedToSymTab{false},
+    _lazySuite{std::move(lazySuite)}
+{}
+
 void FunctionDefinition::evaluate(SymTab &symTab) {
     if ( !_hasBeenAddedToSymTab ) {
-        symTab.setFunction(_funcName, std::make_shared<FunctionDefinition>
-            (_funcName, _paramList, std::move(_SUITE_NOT_FUNC_SUITE_FIX), true));
+        // The body moves out once; evaluating the def again, e.g. in a
+        // Program that runs many times, registers the same function.
+        std::call_once(_registered, [this] {
+            _function = std::make_shared<FunctionDefinition>
+                (_funcName, _paramList, std::move(_SUITE_NOT_FUNC_SUITE_FIX), true);
+            _function->_lazySuite = std::move(_lazySuite);
+            _function->_whenParsed = _whenParsed;
+        });
+        symTab.setFunction(_funcName, _function);
      return;
     }
 
@@ -281,20 +356,62 @@ void FunctionDefinition::evaluate(SymTab &symTab) {
 }
 
 void FunctionDefinition::dumpAST(std::string spaces) {
-    std::cout << spaces << "FunctionDef: " << _funcName << " " << this << " ( ";
-    for_each(_paramList.begin(), _paramList.end(), [](auto &str) { std::cout << str << " "; });
-    std::cout << ")" << std::endl;
-
-    if (_SUITE_NOT_FUNC_SUITE_FIX == nullptr ) {
-        std::cout << spaces << "Function std::move() reference removed and moved to function map -- cannot dump" << std::endl;
+    Script::out() << spaces << "FunctionDef: " << _funcName << " " << this << " ( ";
+    for_each(_paramList.begin(), _paramList.end(), [](auto &str) { Script::out() << str << " "; });
+    Script::out() << ")" << std::endl;
+
+    if ( _SUITE_NOT_FUNC_SUITE_FIX == nullptr && !_lazySuite.empty() ) {
+        Script::out() << spaces << "\tNot parsed yet -- " << _lazySuite.size() << " tokens" << std::endl;
+    } else if (_SUITE_NOT_FUNC_SUITE_FIX == nullptr ) {
+        Script::out() << spaces << "Function std::move() reference removed and moved to function map -- cannot dump" << std::endl;
     } else {
         _SUITE_NOT_FUNC_SUITE_FIX->dumpAST(spaces + '\t');
     }
 }
 
+Statements *FunctionDefinition::suite() {
+
+    // Once only, even when prange workers call the function together.
+    std::call_once(_parsed, [this] {
+        if ( _SUITE_NOT_FUNC_SUITE_FIX != nullptr || _lazySuite.empty() )
+            return;
+
+        if (debug)
+            Script::out() << "FunctionDefinition::suite - parsing " << _funcName << std::endl;
+
+        Lexer replay(std::move(_lazySuite));
+        _lazySuite.clear();
+        Parser parser(replay);
+        _SUITE_NOT_FUNC_SUITE_FIX = parser.func_suite();
+        if ( _whenParsed != nullptr )
+            _whenParsed(*_SUITE_NOT_FUNC_SUITE_FIX);
+    });
+
+    return _SUITE_NOT_FUNC_SUITE_FIX.get();
+}
 
 //END FunctionDefinition
 
+//START ReturnStatement
+ReturnStatement::ReturnStatement(std::unique_ptr<ExprNode> returnExpr):
+    _returnExpr{std::move(returnExpr)}
+{}
+
+void ReturnStatement::evaluate(SymTab &symTab) {
+
+    if (debug)
+        Script::out() << "void ReturnStatement::evaluate(SymTab &symTab)" << std::endl;
+
+    symTab.setReturnValue(_returnExpr->evaluate(symTab));
+    symTab.setReturning(true);
+}
+
+void ReturnStatement::dumpAST(std::string spaces) {
+    Script::out() << spaces << "ReturnStatement " << this << std::endl;
+    _returnExpr->dumpAST(spaces + "\t");
+}
+//END ReturnStatement
+
 //START FUNCTIONCALL
 FunctionCallStatement::FunctionCallStatement(std::unique_ptr<ExprNode> exprNodeCall):
     _exprNodeCall{std::move(exprNodeCall)}
@@ -305,19 +422,83 @@ void FunctionCallStatement::evaluate(SymTab &symTab) {
 }
 
 void FunctionCallStatement::dumpAST(std::string spaces) {
-    std::cout << spaces << "Function Wrapper: " << this << std::endl;
+    Script::out() << spaces << "Function Wrapper: " << this << std::endl;
     _exprNodeCall->dumpAST(spaces + "\t");
 }
 
 
 //END FUNCTIONCALL
 
+// START "LISTSTATEMENTS"
+static TypeDescriptor *listNamed(SymTab &symTab, const std::string &name) {
+
+    if ( !symTab.isDefined(name) ) {
+        Script::out() << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
+        Script::out() << "Use of undefined variable, " << name << std::endl;
+        Script::exit(1);
+    }
+    return symTab.getValueFor(name);
+}
+
+AppendStatement::AppendStatement(std::string listName, std::unique_ptr<ExprNode> value):
+    _listName{listName},
+    _value{std::move(value)}
+{}
+
+void AppendStatement::evaluate(SymTab &symTab) {
+
+    if (debug)
+        Script::out() << "void AppendStatement::evaluate(SymTab &symTab)" << std::endl;
+
+    auto value = _value->evaluate(symTab);
+    auto guard = Prange::lockContainers();
+    Descriptor::List::append(listNamed(symTab, _listName), std::move(value));
+}
+
+void AppendStatement::dumpAST(std::string spaces) {
+    Script::out() << spaces << "AppendStatement " << this << '\t' << _listName << std::endl;
+    _value->dumpAST(spaces + "\t");
+}
+
+SubscriptAssignStmt::SubscriptAssignStmt(std::string listName, std::unique_ptr<ExprNode> index, std::unique_ptr<ExprNode> rhsExpr):
+    _listName{listName},
+    _index{std::move(index)},
+    _rhsExpression{std::move(rhsExpr)}
+{}
+
+void SubscriptAssignStmt::evaluate(SymTab &symTab) {
+
+    if (debug)
+        Script::out() << "void SubscriptAssignStmt::evaluate(SymTab &symTab)" << std::endl;
+
+    auto index = _index->evaluate(symTab);
+    auto rhs = _rhsExpression->evaluate(symTab);
+
+    TypeDescriptor *list = listNamed(symTab, _listName);
+    auto guard = Prange::lockContainers();
+
+    if ( list->type() == TypeDescriptor::DICT ) {
+        Descriptor::Dict::set(list, std::move(index), std::move(rhs));
+        return;
+    }
+
+    size_t i = Descriptor::List::normalizeIndex(index.get(), Descriptor::List::length(list));
+    Descriptor::List::setItem(list, i, std::move(rhs));
+}
+
+void SubscriptAssignStmt::dumpAST(std::string spaces) {
+    Script::out() << spaces << "SubscriptAssignStmt " << this << '\t' << _listName << std::endl;
+    _index->dumpAST(spaces + "\t");
+    _rhsExpression->dumpAST(spaces + "\t");
+}
+// END "LISTSTATEMENTS"
+
 // START "STATEMENTS"
 Statements::Statements() {}
 
 Statements::~Statements() {
     if (destructor)
-        std::cout << "~Statements()" << std::endl;
+        Script::out() << "~Statements()" << std::endl;
 }
 
 void Statements::addStatement(std::unique_ptr<Statement> statement) {
@@ -327,18 +508,20 @@ void Statements::addStatement(std::unique_ptr<Statement> statement) {
 void Statements::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "void Statements::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "void Statements::evaluate(SymTab &symTab)" << std::endl;
 
     for (auto &&s: _statements) {   
         s->evaluate(symTab);
+        if ( symTab.isReturning() )
+            return;
     }
 }
 
 void Statements::dumpAST(std::string spaces) {
 
-    std::cout << spaces << "Stmts  ";
-    std::cout << this << '\t';
-    std::cout << _statements.size() << std::endl;
+    Script::out() << spaces << "Stmts  ";
+    Script::out() << this << '\t';
+    Script::out() << _statements.size() << std::endl;
 
     for_each(_statements.begin(), _statements.end(), [&spaces](auto &s) { s->dumpAST(spaces + '\t'); });
 
@@ -369,15 +552,15 @@ IfStmt::IfStmt(
 
 IfStmt::~IfStmt() {
     if (destructor)
-        std::cout << "~IfStmt()" << std::endl;
+        Script::out() << "~IfStmt()" << std::endl;
 }
 
 bool IfStmt::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "bool IfStmt::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "bool IfStmt::evaluate(SymTab &symTab)" << std::endl;
 
-    if ( Descriptor::Bool::getBoolValue( _if.first->evaluate(symTab).get() ) ) {
+    if ( _if.first->condition(symTab) ) {
         _if.second->evaluate(symTab);
         return true;
     }
@@ -385,8 +568,8 @@ bool IfStmt::evaluate(SymTab &symTab) {
 }
 
 void IfStmt::dumpAST(std::string spaces) {
-    std::cout << spaces << "IfStmt    ";
-    std::cout << this << "\t" << std::endl;
+    Script::out() << spaces << "IfStmt    ";
+    Script::out() << this << "\t" << std::endl;
     _if.first->dumpAST(spaces + "\t");
     _if.second->dumpAST(spaces + "\t");
 
@@ -399,7 +582,7 @@ ElifStmt::ElifStmt() {}
 
 ElifStmt::~ElifStmt() {
     if (destructor)
-        std::cout << "~ElifStmt()" << std::endl;
+        Script::out() << "~ElifStmt()" << std::endl;
 }
 
 // void ElifStmt::addStatement(std::unique_ptr<ExprNode> elif, std::unique_ptr<GroupedStatements> stmts) {
@@ -420,10 +603,10 @@ void ElifStmt::addStatement(std::unique_ptr<ExprNode> elif, std::unique_ptr<Stat
 bool ElifStmt::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "bool ElifStmt::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "bool ElifStmt::evaluate(SymTab &symTab)" << std::endl;
 
     for ( auto &&item : _elif ) {
-        if ( Descriptor::Bool::getBoolValue( item.first->evaluate(symTab).get() ) ) {
+        if ( item.first->condition(symTab) ) {
             item.second->evaluate(symTab);
             return true;
         }
@@ -433,8 +616,8 @@ bool ElifStmt::evaluate(SymTab &symTab) {
 }
 
 void ElifStmt::dumpAST(std::string spaces) {
-    std::cout << spaces << "ElifStmt    ";
-    std::cout << this << "\t" << std::endl;
+    Script::out() << spaces << "ElifStmt    ";
+    Script::out() << this << "\t" << std::endl;
     for_each(_elif.begin(), _elif.end(), [&spaces](auto &s) { 
         s.first->dumpAST(spaces + "\t");
         s.second->dumpAST(spaces + "\t");
@@ -453,13 +636,13 @@ ElseStmt::ElseStmt(std::unique_ptr<Statements> s):
 
 ElseStmt::~ElseStmt() {
     if (destructor)
-        std::cout << "~ElseStmt()" << std::endl;
+        Script::out() << "~ElseStmt()" << std::endl;
 }
 
 bool ElseStmt::evaluate(SymTab &symTab) {
 
     if (debug)
-        std::cout << "bool ElseStmt::evaluate(SymTab &symTab)" << std::endl;
+        Script::out() << "bool ElseStmt::evaluate(SymTab &symTab)" << std::endl;
 
     _stmts->evaluate(symTab);
 
@@ -467,8 +650,8 @@ bool ElseStmt::evaluate(SymTab &symTab) {
 }
 
 void ElseStmt::dumpAST(std::string spaces) {
-    std::cout << spaces << "ElseStmt    ";
-    std::cout << this << "\t" << std::endl;
+    Script::out() << spaces << "ElseStmt    ";
+    Script::out() << this << "\t" << std::endl;
     _stmts->dumpAST(spaces + "\t");
 }
 // END "ELSE"
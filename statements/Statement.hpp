@@ -2,6 +2,7 @@
 #define __STATEMENT_HPP
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <optional>
 
@@ -15,6 +16,8 @@
 class IfStmt;
 class ElifStmt;
 class ElseStmt;
+class JitRange;
+class Prange;
 
 class Statement {
 
@@ -54,6 +57,14 @@ public:
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
 private:
+    friend class JitCompiler;
+    friend class Prange;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
     std::string _lhsVariable;
     std::unique_ptr<ExprNode> _rhsExpression;
     // ExprNode *_rhsExpression;
@@ -73,6 +84,14 @@ public:
     virtual void dumpAST(std::string);
 
 private:
+    friend class JitCompiler;
+    friend class Prange;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
     std::unique_ptr<IfStmt>   _if;
     std::unique_ptr<ElifStmt> _elif;
     std::unique_ptr<ElseStmt> _else;
@@ -89,6 +108,14 @@ public:
     virtual void dumpAST(std::string);
 
 private:
+    friend class JitCompiler;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
     std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
 };
 
@@ -102,37 +129,98 @@ public:
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
 
-    void parseTestList(SymTab &symTab);
+    // range(...)'s bounds - locals, so one loop may run on several threads.
+    void parseTestList(SymTab &symTab, int64_t &start, int64_t &end, int64_t &step);
     
     // void addStatements(std::unique_ptr<GroupedStatements>);
     void addStatements(std::unique_ptr<Statements>);
     
     void addTestList(std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
-    void editOptionals(int, std::optional<int>);
+    // for x in <sequence> - a list or a string instead of range(...).
+    void addIterable(std::unique_ptr<ExprNode>);
+    // for x in prange(...) - once the body is added.
+    void makeParallel();
+
+    // Runs the iterations from `from` on - also how a JitRange that had to
+    // stop hands the rest of its loop back to the interpreter.
+    void iterate(SymTab &symTab, Integer from, int64_t end, int64_t step, bool countDown);
 
 private:
+    friend class JitCompiler;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
     std::string _id;
-    std::optional<int> _start, _end, _step;
 
     // std::unique_ptr<GroupedStatements> _forBody;
     std::unique_ptr<Statements> _forBody;
 
     std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
+    std::unique_ptr<ExprNode> _iterable;
+
+    std::unique_ptr<JitRange> _jit;
+    std::unique_ptr<Prange> _parallel;
+
+    // LoopHoister's temporaries for this loop - forgotten as it starts.
+    std::vector<std::string> _hoisted;
+
+    void iterateSequence(SymTab &symTab);
 };
 
 class FunctionDefinition : public Statement {
 public:
     FunctionDefinition(std::string, std::vector<std::string>, std::unique_ptr<Statements>, bool);
+    // Lazily parsed definition - the suite's tokens, NEWLINE through the closing DEDENT.
+    FunctionDefinition(std::string, std::vector<std::string>, std::vector<std::shared_ptr<Token>>);
     virtual ~FunctionDefinition() = default;
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
 
+    // The function body, parsed from the recorded tokens on first use.
+    Statements *suite();
+    // False while the body is still only recorded tokens.
+    bool isParsed() const { return _lazySuite.empty(); }
+
 std::vector<std::string> _paramList;
 std::unique_ptr<Statements> _SUITE_NOT_FUNC_SUITE_FIX;
 
 private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class JitCompiler;
+
     std::string _funcName;
     bool _hasBeenAddedToSymTab;
+    std::vector<std::shared_ptr<Token>> _lazySuite;
+    std::once_flag _parsed;
+    // Run on a lazily parsed body once it is parsed - how the JIT reaches it.
+    void (*_whenParsed)(Statements &) = nullptr;
+
+    std::once_flag _registered;
+    std::shared_ptr<FunctionDefinition> _function;
+};
+
+class ReturnStatement : public Statement {
+public:
+    ReturnStatement(std::unique_ptr<ExprNode>);
+    virtual ~ReturnStatement() = default;
+    virtual void evaluate(SymTab &symTab);
+    virtual void dumpAST(std::string);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
+    std::unique_ptr<ExprNode> _returnExpr;
 };
 
 class FunctionCallStatement : public Statement {
@@ -142,8 +230,54 @@ public:
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
 private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
     std::unique_ptr<ExprNode> _exprNodeCall;
 };
+
+// name.append(value)
+class AppendStatement : public Statement {
+public:
+    AppendStatement(std::string, std::unique_ptr<ExprNode>);
+    virtual ~AppendStatement() = default;
+    virtual void evaluate(SymTab &symTab);
+    virtual void dumpAST(std::string);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::string _listName;
+    std::unique_ptr<ExprNode> _value;
+};
+
+// name[index] = value, where name holds a list or a dict
+class SubscriptAssignStmt : public Statement {
+public:
+    SubscriptAssignStmt(std::string, std::unique_ptr<ExprNode>, std::unique_ptr<ExprNode>);
+    virtual ~SubscriptAssignStmt() = default;
+    virtual void evaluate(SymTab &symTab);
+    virtual void dumpAST(std::string);
+private:
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+    friend class Prange;
+
+    std::string _listName;
+    std::unique_ptr<ExprNode> _index;
+    std::unique_ptr<ExprNode> _rhsExpression;
+};
  
 
 class Comparison {
@@ -174,6 +308,14 @@ public:
     virtual void dumpAST(std::string);
 
 private: 
+    friend class JitCompiler;
+    friend class Prange;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
     std::pair<
         std::unique_ptr<ExprNode>,
         // std::unique_ptr<GroupedStatements>
@@ -195,6 +337,14 @@ public:
     virtual void dumpAST(std::string);
  
 private: 
+    friend class JitCompiler;
+    friend class Prange;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
     std::vector<
         std::pair<
             std::unique_ptr<ExprNode>,
@@ -215,6 +365,14 @@ public:
     virtual void dumpAST(std::string);
 
 private:
+    friend class JitCompiler;
+    friend class Prange;
+    friend class Transpiler;
+    friend class AstCache;
+    friend class LoopHoister;
+    friend class DeadCode;
+    friend class ValueNumbering;
+
     // std::unique_ptr<GroupedStatements> stmts;
     std::unique_ptr<Statements> _stmts;
 };
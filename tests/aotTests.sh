@@ -0,0 +1,54 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting AOT Test Script"
+echo
+
+cd $(dirname $0)
+
+BUILD=$(mktemp -d)
+trap "rm -rf $BUILD" EXIT
+
+for file in $(ls | grep -v '\.sh$'); do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+    INTERPRETER_STATUS=$?
+
+    # A script that does not parse fails the same way in both modes.
+    AOT=$(../statement.x --aot $BUILD/program $file)
+    AOT_STATUS=$?
+    if [[ $AOT_STATUS -eq 0 ]]; then
+        AOT=$(timeout 2 $BUILD/program)
+        AOT_STATUS=$?
+    fi
+
+    if [[ $INTERPRETER_STATUS -ne $AOT_STATUS ]]; then
+        echo -e "${RED}ERROR - $file exit status $AOT_STATUS compiled, $INTERPRETER_STATUS interpreted${NC}"
+        continue;
+    fi
+
+    DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$AOT" ))
+
+    if [[ -n $DIFF ]]; then  # Diff is not empty
+        echo -e "${RED}Test failed on file $file${NC}"
+        echo "-- Diff (interpreter < > compiled) --"
+        echo "$DIFF"
+        echo 
+    else
+        echo -e "${Green}$file passes${NC}"
+    fi
+
+done
+
+# g++ is run without a shell - a name it would split or interpret is used as is.
+ODD="$BUILD/odd name;true"
+if ../statement.x --aot "$ODD" testIf_1.txt && [[ "$("$ODD")" == "$(../statement.x testIf_1.txt)" ]]; then
+    echo -e "${Green}odd executable name passes${NC}"
+else
+    echo -e "${RED}Test failed on an executable name with a space and a ';'${NC}"
+fi
+
+echo
+echo "Finished Testing"
@@ -0,0 +1,61 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting Batch Test Script"
+echo
+
+cd $(dirname $0)
+
+# The SHOULDFAIL tests never finish, which would hold up the whole batch.
+FILES=$(ls | grep -v '\.sh$' | grep -v 'SHOULDFAIL')
+OUT=$(mktemp -d)
+
+timeout 20 ../statement.x --batch --threads 4 --out $OUT $FILES 2> /dev/null
+
+for file in $FILES; do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+
+    if [[ ! -f $OUT/$file.out ]]; then
+        echo -e "${RED}ERROR - $file has no batch output${NC}"
+        continue;
+    fi
+
+    DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$(cat $OUT/$file.out)" ))
+
+    if [[ -n $DIFF ]]; then  # Diff is not empty
+        echo -e "${RED}Test failed on file $file${NC}"
+        echo "-- Diff (alone < > in a batch) --"
+        echo "$DIFF"
+        echo 
+    else
+        echo -e "${Green}$file passes${NC}"
+    fi
+
+done
+
+# Scripts from different directories with the same file name both keep
+# their output.
+mkdir -p $OUT/a $OUT/b $OUT/same
+echo "print 1" > $OUT/a/x.txt
+echo "print 2" > $OUT/b/x.txt
+../statement.x --batch --out $OUT/same $OUT/a/x.txt $OUT/b/x.txt
+if [[ $? -eq 0 && "$(cat $OUT/same/x.txt.out)" == "1 " && "$(cat $OUT/same/x.txt.1.out)" == "2 " ]]; then
+    echo -e "${Green}same file names pass${NC}"
+else
+    echo -e "${RED}Test failed on two scripts with the same file name${NC}"
+fi
+
+# An output directory that can't be written fails the run.
+if ../statement.x --batch --out $OUT/missing testIf_1.txt > /dev/null 2>&1; then
+    echo -e "${RED}Test failed on a missing output directory - exit status 0${NC}"
+else
+    echo -e "${Green}missing output directory passes${NC}"
+fi
+
+rm -fr $OUT
+
+echo
+echo "Finished Testing"
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting AST Cache Test Script"
+echo
+
+cd $(dirname $0)
+
+CACHE=$(mktemp -d)
+
+for file in $(ls | grep -v '\.sh$'); do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+    INTERPRETER_STATUS=$?
+
+    # First run parses and stores the image, second run loads it.
+    for run in cold warm; do
+        CACHED=$(timeout 2 ../statement.x --cache $CACHE $file)
+        CACHED_STATUS=$?
+
+        if [[ $INTERPRETER_STATUS -ne $CACHED_STATUS ]]; then
+            echo -e "${RED}ERROR - $file exit status $CACHED_STATUS on $run cache, $INTERPRETER_STATUS without${NC}"
+            continue 2;
+        fi
+
+        DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$CACHED" ))
+
+        if [[ -n $DIFF ]]; then  # Diff is not empty
+            echo -e "${RED}Test failed on file $file ($run cache)${NC}"
+            echo "-- Diff (interpreter < > cache) --"
+            echo "$DIFF"
+            echo 
+            continue 2;
+        fi
+    done
+
+    echo -e "${Green}$file passes${NC}"
+
+done
+
+rm -rf $CACHE
+
+echo
+echo "Finished Testing"
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting Embedding Test Script"
+echo
+
+cd $(dirname $0)/..
+
+if ! make -s embedtest.x > /dev/null; then
+    echo -e "${RED}ERROR - embedtest.x does not build${NC}"
+    exit 1
+fi
+
+./embedtest.x | while read -r line; do
+    if [[ $line == passes* ]]; then
+        echo -e "${Green}$line${NC}"
+    else
+        echo -e "${RED}$line${NC}"
+    fi
+done
+
+echo
+echo "Finished Testing"
@@ -0,0 +1,67 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting Fork Serve Test Script"
+echo
+
+cd $(dirname $0)
+
+SOCKET=$(mktemp -u /tmp/statement.XXXXXX.sock)
+PRELUDE=$(mktemp /tmp/prelude.XXXXXX.py)
+SCRIPT=$(mktemp /tmp/script.XXXXXX.py)
+
+printf 'def preludeSquare(n):\n    return n * n\npreludeScale = 3\nprint "prelude ran"\n' > $PRELUDE
+
+../statement.x --serve $SOCKET --prelude $PRELUDE > /dev/null &
+SERVER=$!
+
+for i in $(seq 50); do
+    [[ -S $SOCKET ]] && break
+    sleep 0.1
+done
+
+# Each request starts from the prelude's globals, not the last request's.
+printf 'print preludeSquare(preludeScale)\npreludeScale = 5\nprint preludeSquare(preludeScale)\n' > $SCRIPT
+for run in first second; do
+    CLIENT=$(timeout 2 ../statement.x --client $SOCKET $SCRIPT)
+    if [[ $? -ne 0 || "$CLIENT" != $'9 \n25 ' ]]; then
+        echo -e "${RED}ERROR - prelude request ($run) printed: $CLIENT${NC}"
+    else
+        echo -e "${Green}prelude request ($run) passes${NC}"
+    fi
+done
+
+# The prelude's names don't clash with the tests', so they run as they do alone.
+for file in $(ls | grep -v '\.sh$' | grep -v 'SHOULDFAIL'); do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+    INTERPRETER_STATUS=$?
+
+    CLIENT=$(timeout 2 ../statement.x --client $SOCKET $file)
+    CLIENT_STATUS=$?
+
+    if [[ $INTERPRETER_STATUS -ne $CLIENT_STATUS ]]; then
+        echo -e "${RED}ERROR - $file exit status $CLIENT_STATUS forked, $INTERPRETER_STATUS alone${NC}"
+        continue;
+    fi
+
+    DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$CLIENT" ))
+
+    if [[ -n $DIFF ]]; then  # Diff is not empty
+        echo -e "${RED}Test failed on file $file${NC}"
+        echo "-- Diff (alone < > forked) --"
+        echo "$DIFF"
+        echo 
+        continue;
+    fi
+
+    echo -e "${Green}$file passes${NC}"
+done
+
+kill $SERVER
+rm -f $SOCKET $PRELUDE $SCRIPT
+
+echo
+echo "Finished Testing"
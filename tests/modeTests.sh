@@ -0,0 +1,115 @@
+#!/bin/bash
+
+# Runs every test with the given flags and checks it prints and exits as the
+# plain interpreter on one thread does, e.g.
+#
+#   modeTests.sh --jit
+#   modeTests.sh --parallel-lex 4 --lex-chunk 1
+#   modeTests.sh --threads 4
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+if [[ $# -eq 0 ]]; then
+    echo "usage: $0 flags..."
+    exit 1
+fi
+
+echo "Starting Mode Test Script: $*"
+echo
+
+cd $(dirname $0)
+
+for file in $(ls | grep -v '\.sh$'); do
+    INTERPRETER=$(timeout 2 ../statement.x --threads 1 $file)
+    INTERPRETER_STATUS=$?
+    MODE=$(timeout 2 ../statement.x "$@" $file)
+    MODE_STATUS=$?
+
+    if [[ $INTERPRETER_STATUS -ne $MODE_STATUS ]]; then
+        echo -e "${RED}ERROR - $file exit status $MODE_STATUS with $*, $INTERPRETER_STATUS without${NC}"
+        continue;
+    fi
+
+    DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$MODE" ))
+
+    if [[ -n $DIFF ]]; then  # Diff is not empty
+        echo -e "${RED}Test failed on file $file${NC}"
+        echo "-- Diff (interpreter < > $*) --"
+        echo "$DIFF"
+        echo
+    else
+        echo -e "${Green}$file passes${NC}"
+    fi
+
+done
+
+BUILD=$(mktemp -d)
+
+# A prange loop prints and leaves what the same loop over range does.
+for file in $(grep -l ' in prange(' $(ls | grep -v '\.sh$')); do
+    sed 's/ in prange(/ in range(/' $file > $BUILD/$file
+
+    SERIAL=$(timeout 2 ../statement.x --threads 1 $BUILD/$file)
+    SERIAL_STATUS=$?
+    MODE=$(timeout 2 ../statement.x "$@" $file)
+    MODE_STATUS=$?
+
+    if [[ $SERIAL_STATUS -ne $MODE_STATUS ]]; then
+        echo -e "${RED}ERROR - $file exit status $MODE_STATUS with $*, $SERIAL_STATUS over range${NC}"
+    elif [[ "$SERIAL" != "$MODE" ]]; then
+        echo -e "${RED}Test failed on file $file over range${NC}"
+        echo "-- Diff (range < > prange with $*) --"
+        diff <( echo "$SERIAL" ) <( echo "$MODE" )
+        echo
+    else
+        echo -e "${Green}$file over range passes${NC}"
+    fi
+done
+
+# A fatal error in a prange body stops the loop where the serial one stops.
+printf 'z = 0\nfor i in prange(0, 10):\n    print i\n    if i == 6:\n        print 1 / z\nprint 99\n' > $BUILD/prangeError.txt
+
+INTERPRETER=$(timeout 2 ../statement.x --threads 1 $BUILD/prangeError.txt)
+INTERPRETER_STATUS=$?
+MODE=$(timeout 2 ../statement.x "$@" $BUILD/prangeError.txt)
+MODE_STATUS=$?
+
+if [[ $INTERPRETER_STATUS -ne 1 || $MODE_STATUS -ne 1 ]]; then
+    echo -e "${RED}ERROR - prange error exit status $MODE_STATUS with $*, $INTERPRETER_STATUS without${NC}"
+elif [[ "$INTERPRETER" != "$MODE" ]]; then
+    echo -e "${RED}Test failed on a prange error${NC}"
+    echo "-- Diff (interpreter < > $*) --"
+    diff <( echo "$INTERPRETER" ) <( echo "$MODE" )
+    echo
+else
+    echo -e "${Green}prange error passes${NC}"
+fi
+
+# With --lazy, a body that never runs is never parsed - with the JIT or
+# compiled ahead of time too - and a broken one fails only when it is called.
+if [[ " $* " == *" --lazy "* ]]; then
+    printf 'def broken(n):\n    x = = 3\n    return x\n\nprint 1\n' > $BUILD/uncalled.txt
+    printf 'def broken(n):\n    x = = 3\n    return x\n\nprint 1\nprint broken(2)\n' > $BUILD/called.txt
+
+    for script in uncalled called; do
+        LAZY=$(../statement.x --lazy $BUILD/$script.txt)
+        LAZY_STATUS=$?
+        JIT=$(../statement.x --lazy --jit $BUILD/$script.txt)
+        JIT_STATUS=$?
+        ../statement.x --lazy --aot $BUILD/program $BUILD/$script.txt && AOT=$($BUILD/program)
+        AOT_STATUS=$?
+
+        if [[ $LAZY_STATUS -ne $JIT_STATUS || $LAZY_STATUS -ne $AOT_STATUS || "$LAZY" != "$JIT" || "$LAZY" != "$AOT" ]]; then
+            echo -e "${RED}Test failed on a broken $script body - exit status $LAZY_STATUS, $JIT_STATUS with --jit, $AOT_STATUS compiled${NC}"
+        else
+            echo -e "${Green}broken $script body passes${NC}"
+        fi
+    done
+fi
+
+rm -fr $BUILD
+
+echo
+echo "Finished Testing"
@@ -0,0 +1,68 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting Optimizer Test Script"
+echo
+
+cd $(dirname $0)
+
+for file in $(ls | grep -v '\.sh$'); do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+    INTERPRETER_STATUS=$?
+
+    # With the JIT as well, --opt must leave the loops it compiled alone.
+    for flags in "--opt" "--opt --jit"; do
+        OPT=$(timeout 2 ../statement.x $flags $file)
+        OPT_STATUS=$?
+
+        if [[ $INTERPRETER_STATUS -ne $OPT_STATUS ]]; then
+            echo -e "${RED}ERROR - $file exit status $OPT_STATUS with $flags, $INTERPRETER_STATUS without${NC}"
+            continue 2;
+        fi
+
+        DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$OPT" ))
+
+        if [[ -n $DIFF ]]; then  # Diff is not empty
+            echo -e "${RED}Test failed on file $file${NC}"
+            echo "-- Diff (interpreter < > $flags) --"
+            echo "$DIFF"
+            echo 
+            continue 2;
+        fi
+    done
+
+    echo -e "${Green}$file passes${NC}"
+done
+
+# Each pass has something to do here - --opt-debug lists what they changed.
+BUILD=$(mktemp -d)
+printf "def one(n):\n    if n > 0:\n        return 1\n        print 'never'\n    return 0\n\nunused = 5\nif 1 > 2:\n    print 'never'\nlimit = 7\ntotal = 0\nfor i in range(10):\n    total = total + limit * 3\nprint total\nb = 12\nprint b %% 10 + 1\nprint b %% 10 + 2\n" > $BUILD/passes.txt
+
+CHANGES=$(timeout 2 ../statement.x --opt-debug $BUILD/passes.txt)
+OPT=$(timeout 2 ../statement.x --opt $BUILD/passes.txt)
+rm -fr $BUILD
+
+FAILED=0
+for change in "DeadCode - removed a branch that is never taken" "DeadCode - removed the dead store to unused" \
+              "DeadCode - removed the statements after a return" \
+              "LoopHoister - .* out of the loop over i" "ValueNumbering - .* reused"; do
+    COUNT=$(echo "$CHANGES" | grep -c "^$change$")
+    if [[ $COUNT -ne 1 ]]; then
+        echo -e "${RED}Test failed on the passes - \"$change\" listed $COUNT times, not once${NC}"
+        FAILED=1
+    fi
+done
+
+# The listing comes before what the script prints, which --opt-debug leaves alone.
+if [[ "$OPT" != "$(printf '210 \n3 \n4 ')" || "$CHANGES" != *"$OPT" ]]; then
+    echo -e "${RED}Test failed on the passes - the optimized script printed${NC}"
+    echo "$OPT"
+elif [[ $FAILED -eq 0 ]]; then
+    echo -e "${Green}optimizer passes pass${NC}"
+fi
+
+echo
+echo "Finished Testing"
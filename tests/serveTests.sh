@@ -0,0 +1,76 @@
+#!/bin/bash
+
+NC='\033[0m'
+RED='\033[0;31m'
+Green='\033[0;32m'
+
+echo "Starting Serve Test Script"
+echo
+
+cd $(dirname $0)
+
+SOCKET=$(mktemp -u /tmp/statement.XXXXXX.sock)
+../statement.x --serve $SOCKET --threads 2 &
+SERVER=$!
+
+for i in $(seq 50); do
+    [[ -S $SOCKET ]] && break
+    sleep 0.1
+done
+
+# The SHOULDFAIL tests never finish, and would tie up a server worker.
+for file in $(ls | grep -v '\.sh$' | grep -v 'SHOULDFAIL'); do 
+    INTERPRETER=$(timeout 2 ../statement.x $file)
+    INTERPRETER_STATUS=$?
+
+    # The second request runs the program the first one compiled.
+    for run in compiled cached; do
+        CLIENT=$(timeout 2 ../statement.x --client $SOCKET $file)
+        CLIENT_STATUS=$?
+
+        if [[ $INTERPRETER_STATUS -ne $CLIENT_STATUS ]]; then
+            echo -e "${RED}ERROR - $file exit status $CLIENT_STATUS served ($run), $INTERPRETER_STATUS alone${NC}"
+            continue 2;
+        fi
+
+        DIFF=$(diff <( echo "$INTERPRETER" ) <( echo "$CLIENT" ))
+
+        if [[ -n $DIFF ]]; then  # Diff is not empty
+            echo -e "${RED}Test failed on file $file${NC}"
+            echo "-- Diff (alone < > served, $run) --"
+            echo "$DIFF"
+            echo 
+            continue 2;
+        fi
+    done
+
+    echo -e "${Green}$file passes${NC}"
+done
+
+# A script that fails inside a prange body fails only its own request.
+PRANGE_ERROR=$(mktemp)
+printf 'z = 0\nfor i in prange(0, 10):\n    print i\n    if i == 6:\n        print 1 / z\n' > $PRANGE_ERROR
+
+INTERPRETER=$(timeout 2 ../statement.x $PRANGE_ERROR)
+INTERPRETER_STATUS=$?
+CLIENT=$(timeout 2 ../statement.x --client $SOCKET $PRANGE_ERROR)
+CLIENT_STATUS=$?
+rm -f $PRANGE_ERROR
+
+AFTER=$(timeout 2 ../statement.x --client $SOCKET testIf_1.txt)
+AFTER_STATUS=$?
+
+if [[ $INTERPRETER_STATUS -ne $CLIENT_STATUS || "$INTERPRETER" != "$CLIENT" ]]; then
+    echo -e "${RED}Test failed on a prange error - exit status $CLIENT_STATUS served, $INTERPRETER_STATUS alone${NC}"
+    diff <( echo "$INTERPRETER" ) <( echo "$CLIENT" )
+elif [[ $AFTER_STATUS -ne 0 || -z "$AFTER" ]] || ! kill -0 $SERVER 2> /dev/null; then
+    echo -e "${RED}ERROR - the server is down after a prange error${NC}"
+else
+    echo -e "${Green}prange error passes${NC}"
+fi
+
+kill $SERVER
+rm -f $SOCKET
+
+echo
+echo "Finished Testing"
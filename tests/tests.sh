@@ -9,7 +9,7 @@ echo
 
 cd $(dirname $0)
 
-for file in $(ls | grep -v *.sh); do 
+for file in $(ls | grep -v '\.sh$'); do 
     NATHAN_INTERPRETER=$(timeout 2 ../statement.x $file)
     # NATHAN_INTERPRETER=$(../statement.x $file)
     if [[ $? -ne 0 ]]; then 